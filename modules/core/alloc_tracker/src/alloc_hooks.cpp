@@ -0,0 +1,114 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/perf/include/alloc_tracker.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+// Replacements of the global operator new/delete feeding the counters of
+// core/perf/include/alloc_tracker.hpp. Kept out of core_module_lib: only the
+// binaries linked with the core_alloc_tracker object library pay for them.
+
+namespace {
+
+// Every block starts with a header holding the requested size, so sized and
+// unsized delete can both update the live size
+constexpr std::size_t kHeaderSize = alignof(std::max_align_t);
+
+void *tracked_alloc(std::size_t size, std::size_t alignment) {
+  auto header = alignment > kHeaderSize ? alignment : kHeaderSize;
+#if defined(_WIN32)
+  auto *block = static_cast<unsigned char *>(_aligned_malloc(header + size, header));
+#else
+  // aligned_alloc wants a multiple of the alignment
+  auto total = (header + size + header - 1) / header * header;
+  auto *block = static_cast<unsigned char *>(header == kHeaderSize ? std::malloc(total)
+                                                                    : std::aligned_alloc(header, total));
+#endif
+  if (block == nullptr) {
+    return nullptr;
+  }
+  ppc::core::detail::record_allocation(size);
+  auto *user = block + header;
+  *reinterpret_cast<std::size_t *>(user - sizeof(std::size_t)) = size;
+  return user;
+}
+
+void tracked_free(void *ptr, std::size_t alignment) {
+  if (ptr == nullptr) {
+    return;
+  }
+  auto header = alignment > kHeaderSize ? alignment : kHeaderSize;
+  auto *user = static_cast<unsigned char *>(ptr);
+  ppc::core::detail::record_free(*reinterpret_cast<std::size_t *>(user - sizeof(std::size_t)));
+#if defined(_WIN32)
+  _aligned_free(user - header);
+#else
+  std::free(user - header);
+#endif
+}
+
+void *throwing_alloc(std::size_t size, std::size_t alignment) {
+  while (true) {
+    if (void *ptr = tracked_alloc(size, alignment)) {
+      return ptr;
+    }
+    auto handler = std::get_new_handler();
+    if (handler == nullptr) {
+      throw std::bad_alloc();
+    }
+    handler();
+  }
+}
+
+// runs before main() of every binary the hooks are linked into
+[[maybe_unused]] const bool enabled = [] {
+  ppc::core::detail::enable_allocation_tracking();
+  return true;
+}();
+
+}  // namespace
+
+void *operator new(std::size_t size) { return throwing_alloc(size, kHeaderSize); }
+
+void *operator new[](std::size_t size) { return throwing_alloc(size, kHeaderSize); }
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept { return tracked_alloc(size, kHeaderSize); }
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept { return tracked_alloc(size, kHeaderSize); }
+
+void *operator new(std::size_t size, std::align_val_t alignment) {
+  return throwing_alloc(size, static_cast<std::size_t>(alignment));
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+  return throwing_alloc(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void *ptr) noexcept { tracked_free(ptr, kHeaderSize); }
+
+void operator delete[](void *ptr) noexcept { tracked_free(ptr, kHeaderSize); }
+
+void operator delete(void *ptr, std::size_t) noexcept { tracked_free(ptr, kHeaderSize); }
+
+void operator delete[](void *ptr, std::size_t) noexcept { tracked_free(ptr, kHeaderSize); }
+
+void operator delete(void *ptr, const std::nothrow_t &) noexcept { tracked_free(ptr, kHeaderSize); }
+
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept { tracked_free(ptr, kHeaderSize); }
+
+void operator delete(void *ptr, std::align_val_t alignment) noexcept {
+  tracked_free(ptr, static_cast<std::size_t>(alignment));
+}
+
+void operator delete[](void *ptr, std::align_val_t alignment) noexcept {
+  tracked_free(ptr, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void *ptr, std::size_t, std::align_val_t alignment) noexcept {
+  tracked_free(ptr, static_cast<std::size_t>(alignment));
+}
+
+void operator delete[](void *ptr, std::size_t, std::align_val_t alignment) noexcept {
+  tracked_free(ptr, static_cast<std::size_t>(alignment));
+}
@@ -0,0 +1,138 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "core/async/include/task_executor.hpp"
+#include "core/async/include/worker_pool.hpp"
+#include "core/graph/func_tests/test_task.hpp"
+#include "core/task/func_tests/test_task.hpp"
+#include "core/task/include/data_view.hpp"
+
+TEST(async_tests, check_submit) {
+  std::vector<int32_t> in(100, 1);
+  std::vector<int32_t> out(1, 0);
+  auto testTask = std::make_shared<ppc::test::TestTask<int32_t>>(ppc::test::make_data<int32_t>({in}, {out}));
+
+  ppc::core::TaskExecutor executor(2);
+  EXPECT_EQ(executor.num_workers(), 2U);
+  auto result = executor.submit(testTask);
+  ASSERT_TRUE(result.get());
+  EXPECT_EQ(out[0], 100);
+
+  // the process-wide pool
+  out[0] = 0;
+  ASSERT_TRUE(ppc::core::submit(testTask).get());
+  EXPECT_EQ(out[0], 100);
+}
+
+TEST(async_tests, check_same_task_runs_in_order) {
+  std::vector<int32_t> in(100, 1);
+  std::vector<int32_t> out(1, 0);
+  auto testTask = std::make_shared<ppc::test::TestTask<int32_t>>(ppc::test::make_data<int32_t>({in}, {out}));
+
+  // interleaved lifecycles would fail internal_order_test()
+  ppc::core::TaskExecutor executor(4);
+  std::vector<std::future<bool>> results;
+  for (int i = 0; i < 50; i++) {
+    results.push_back(executor.submit(testTask));
+  }
+  for (auto &result : results) {
+    EXPECT_TRUE(result.get());
+  }
+  EXPECT_EQ(out[0], 100);
+}
+
+TEST(async_tests, check_independent_tasks_overlap) {
+  std::vector<int> in(8, 1);
+  std::vector<int> left_out(in.size());
+  std::vector<int> right_out(in.size());
+  auto leftData = std::make_shared<ppc::core::TaskData>();
+  ppc::core::add_input(*leftData, in.data(), {in.size()});
+  ppc::core::add_output(*leftData, left_out.data(), {left_out.size()});
+  auto rightData = std::make_shared<ppc::core::TaskData>();
+  ppc::core::add_input(*rightData, in.data(), {in.size()});
+  ppc::core::add_output(*rightData, right_out.data(), {right_out.size()});
+
+  ppc::test::ProbeCounter counter;
+  ppc::core::TaskExecutor executor(2);
+  auto left = executor.submit(std::make_shared<ppc::test::ProbeTask>(leftData, counter));
+  auto right = executor.submit(std::make_shared<ppc::test::ProbeTask>(rightData, counter));
+  EXPECT_TRUE(left.get());
+  EXPECT_TRUE(right.get());
+  EXPECT_EQ(counter.max_in_flight.load(), 2);
+  EXPECT_EQ(left_out, in);
+}
+
+TEST(async_tests, check_failures) {
+  std::vector<int32_t> in(100, 1);
+  std::vector<int32_t> out(2, 0);
+  auto taskData = ppc::test::make_data<int32_t>({in}, {out});
+  auto testTask = std::make_shared<ppc::test::TestTask<int32_t>>(taskData);
+
+  ppc::core::TaskExecutor executor(2);
+  // TestTask expects a single output element
+  EXPECT_FALSE(executor.submit(testTask).get());
+  // the failed lifecycle does not break the next one
+  taskData->outputs_count[0] = 1;
+  EXPECT_TRUE(executor.submit(testTask).get());
+  EXPECT_EQ(out[0], 100);
+
+  std::vector<int> ints(4, 1);
+  auto throwingData = std::make_shared<ppc::core::TaskData>();
+  ppc::core::add_input(*throwingData, ints.data(), {ints.size()});
+  ppc::core::add_output(*throwingData, ints.data(), {ints.size()});
+  auto throwingTask = std::make_shared<ppc::test::ThrowingTask>(throwingData);
+  // the thrown lifecycle is reset as well, so a resubmission gets to run() again
+  for (int i = 0; i < 2; i++) {
+    auto result = executor.submit(throwingTask);
+    try {
+      result.get();
+      ADD_FAILURE() << "run() did not throw";
+    } catch (const std::runtime_error &error) {
+      EXPECT_STREQ(error.what(), "task failed");
+    }
+  }
+  EXPECT_THROW(executor.submit(nullptr), std::invalid_argument);
+}
+
+TEST(async_tests, check_destructor_finishes_queued_tasks) {
+  std::vector<int32_t> in(100, 1);
+  std::vector<std::vector<int32_t>> outs(10, std::vector<int32_t>(1, 0));
+  std::vector<std::future<bool>> results;
+  {
+    ppc::core::TaskExecutor executor(1);
+    for (auto &out : outs) {
+      auto taskData = ppc::test::make_data<int32_t>({in}, {out});
+      results.push_back(executor.submit(std::make_shared<ppc::test::TestTask<int32_t>>(taskData)));
+    }
+  }
+  for (size_t i = 0; i < outs.size(); i++) {
+    EXPECT_TRUE(results[i].get());
+    EXPECT_EQ(outs[i][0], 100);
+  }
+}
+
+TEST(async_tests, check_worker_pool) {
+  ppc::core::WorkerPool pool(3);
+  ASSERT_EQ(pool.size(), 3U);
+  std::vector<int> calls(pool.size(), 0);
+  for (int round = 0; round < 100; round++) {
+    pool.run([&](std::size_t worker) { calls[worker]++; });
+  }
+  EXPECT_EQ(calls, std::vector<int>(pool.size(), 100));
+
+  auto failing = [](std::size_t worker) {
+    if (worker == 2) {
+      throw std::runtime_error("worker failed");
+    }
+  };
+  EXPECT_THROW(pool.run(failing), std::runtime_error);
+  // a failed round leaves the pool usable
+  pool.run([&](std::size_t worker) { calls[worker]++; });
+  EXPECT_EQ(calls, std::vector<int>(pool.size(), 101));
+}
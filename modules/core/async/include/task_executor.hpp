@@ -0,0 +1,66 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_TASK_EXECUTOR_HPP_
+#define MODULES_CORE_INCLUDE_TASK_EXECUTOR_HPP_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "core/task/include/task.hpp"
+
+namespace ppc::core {
+
+// Pool of worker threads running task lifecycles asynchronously. submit()
+// queues validation() -> pre_processing() -> run() -> post_processing() of a
+// task and returns a future with the result: false as soon as a stage
+// returns false, or the exception thrown by a stage. Different tasks run
+// concurrently; submissions of the same task run one after another in
+// submission order, so internal_order_test() keeps seeing whole cycles.
+// A task that communicates through MPI off the main thread needs MPI
+// initialized with at least MPI_THREAD_SERIALIZED.
+class TaskExecutor {
+ public:
+  // num_workers 0 - get_num_threads()
+  explicit TaskExecutor(std::size_t num_workers = 0);
+  TaskExecutor(const TaskExecutor &) = delete;
+  TaskExecutor &operator=(const TaskExecutor &) = delete;
+  // finishes everything submitted so far
+  ~TaskExecutor();
+
+  std::future<bool> submit(std::shared_ptr<Task> task);
+
+  [[nodiscard]] std::size_t num_workers() const { return workers.size(); }
+
+  // process-wide pool of get_num_threads() workers
+  static TaskExecutor &shared();
+
+ private:
+  struct Job {
+    std::shared_ptr<Task> task;
+    std::packaged_task<bool()> work;
+  };
+
+  std::vector<std::thread> workers;
+  std::deque<Job> ready;
+  // jobs of tasks that already have a job queued or running, by task
+  std::unordered_map<const Task *, std::deque<Job>> in_flight;
+  std::mutex mutex;
+  std::condition_variable changed;
+  bool stopping = false;
+
+  void work();
+};
+
+// submit to TaskExecutor::shared()
+std::future<bool> submit(std::shared_ptr<Task> task);
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_TASK_EXECUTOR_HPP_
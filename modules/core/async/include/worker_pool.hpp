@@ -0,0 +1,64 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_WORKER_POOL_HPP_
+#define MODULES_CORE_INCLUDE_WORKER_POOL_HPP_
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ppc::core {
+
+// Threads kept for a parallel loop run over and over, so that each round
+// costs a wake-up instead of starting and joining threads. run(body) calls
+// body(worker) once for every worker in [0, size()), worker 0 on the calling
+// thread, and returns when all calls have returned. One run() at a time.
+// body is called through a pointer rather than copied into a std::function,
+// so a round allocates nothing.
+class WorkerPool {
+ public:
+  // num_workers 0 - get_num_threads()
+  explicit WorkerPool(std::size_t num_workers = 0);
+  WorkerPool(const WorkerPool &) = delete;
+  WorkerPool &operator=(const WorkerPool &) = delete;
+  ~WorkerPool();
+
+  // the first exception thrown by body is rethrown once every worker is done
+  template <class Body>
+  void run(const Body &body) {
+    run_round(Round{&body, [](const void *body_, std::size_t worker) {
+                      (*static_cast<const Body *>(body_))(worker);
+                    }});
+  }
+
+  [[nodiscard]] std::size_t size() const { return threads.size() + 1; }
+
+ private:
+  struct Round {
+    const void *body;
+    void (*call)(const void *body, std::size_t worker);
+  };
+
+  void run_round(Round round_);
+  void work(std::size_t worker);
+  void call(const Round &round_, std::size_t worker);
+
+  std::vector<std::thread> threads;
+  std::mutex mutex;
+  std::condition_variable started;
+  std::condition_variable finished;
+  Round current{};
+  // bumped by every run(), so a worker takes each round once
+  uint64_t round = 0;
+  std::size_t running = 0;
+  bool stopping = false;
+  std::exception_ptr error;
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_WORKER_POOL_HPP_
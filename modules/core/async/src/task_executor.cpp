@@ -0,0 +1,97 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/async/include/task_executor.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+#include "core/perf/include/scaling.hpp"
+
+ppc::core::TaskExecutor::TaskExecutor(size_t num_workers) {
+  if (num_workers == 0) {
+    num_workers = static_cast<std::size_t>(get_num_threads());
+  }
+  workers.reserve(num_workers);
+  for (size_t i = 0; i < num_workers; i++) {
+    workers.emplace_back(&TaskExecutor::work, this);
+  }
+}
+
+ppc::core::TaskExecutor::~TaskExecutor() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  changed.notify_all();
+  for (auto &worker : workers) {
+    worker.join();
+  }
+}
+
+std::future<bool> ppc::core::TaskExecutor::submit(std::shared_ptr<Task> task) {
+  if (!task) {
+    throw std::invalid_argument("Cannot submit an empty task");
+  }
+  // a failed or thrown stage is reported through the future, so its broken
+  // lifecycle must not leak into the next submission of the task; a
+  // completed one needs no reset
+  Job job{task, std::packaged_task<bool()>([task]() {
+            try {
+              if (task->validation() && task->pre_processing() && task->run() && task->post_processing()) {
+                return true;
+              }
+            } catch (...) {
+              task->reset();
+              throw;
+            }
+            task->reset();
+            return false;
+          })};
+  auto result = job.work.get_future();
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto [waiting, first] = in_flight.try_emplace(task.get());
+    if (first) {
+      ready.push_back(std::move(job));
+    } else {
+      waiting->second.push_back(std::move(job));
+    }
+  }
+  changed.notify_one();
+  return result;
+}
+
+void ppc::core::TaskExecutor::work() {
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true) {
+    // on stop, jobs still queued behind a running task are moved to ready by
+    // the worker running it, so wait until no task is in flight
+    changed.wait(lock, [this] { return !ready.empty() || (stopping && in_flight.empty()); });
+    if (ready.empty()) {
+      return;
+    }
+    Job job = std::move(ready.front());
+    ready.pop_front();
+    lock.unlock();
+
+    job.work();
+
+    lock.lock();
+    auto waiting = in_flight.find(job.task.get());
+    if (waiting->second.empty()) {
+      in_flight.erase(waiting);
+    } else {
+      ready.push_back(std::move(waiting->second.front()));
+      waiting->second.pop_front();
+    }
+    changed.notify_all();
+  }
+}
+
+ppc::core::TaskExecutor &ppc::core::TaskExecutor::shared() {
+  static TaskExecutor executor;
+  return executor;
+}
+
+std::future<bool> ppc::core::submit(std::shared_ptr<Task> task) {
+  return TaskExecutor::shared().submit(std::move(task));
+}
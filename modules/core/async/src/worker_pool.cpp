@@ -0,0 +1,76 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/async/include/worker_pool.hpp"
+
+#include <utility>
+
+#include "core/perf/include/scaling.hpp"
+
+ppc::core::WorkerPool::WorkerPool(std::size_t num_workers) {
+  if (num_workers == 0) {
+    num_workers = static_cast<std::size_t>(get_num_threads());
+  }
+  threads.reserve(num_workers - 1);
+  for (std::size_t worker = 1; worker < num_workers; worker++) {
+    threads.emplace_back(&WorkerPool::work, this, worker);
+  }
+}
+
+ppc::core::WorkerPool::~WorkerPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  started.notify_all();
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+
+void ppc::core::WorkerPool::run_round(Round round_) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    current = round_;
+    round++;
+    running = threads.size();
+    error = nullptr;
+  }
+  started.notify_all();
+  call(round_, 0);
+
+  std::unique_lock<std::mutex> lock(mutex);
+  finished.wait(lock, [this] { return running == 0; });
+  current = Round{};
+  if (auto failure = std::exchange(error, nullptr)) {
+    std::rethrow_exception(failure);
+  }
+}
+
+void ppc::core::WorkerPool::work(std::size_t worker) {
+  uint64_t done = 0;
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true) {
+    started.wait(lock, [&] { return stopping || round != done; });
+    if (stopping) {
+      return;
+    }
+    done = round;
+    auto round_ = current;
+    lock.unlock();
+    call(round_, worker);
+    lock.lock();
+    if (--running == 0) {
+      finished.notify_one();
+    }
+  }
+}
+
+void ppc::core::WorkerPool::call(const Round &round_, std::size_t worker) {
+  try {
+    round_.call(round_.body, worker);
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!error) {
+      error = std::current_exception();
+    }
+  }
+}
@@ -0,0 +1,146 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "core/batch/include/batch.hpp"
+#include "core/perf/include/alloc_tracker.hpp"
+#include "core/task/func_tests/test_task.hpp"
+#include "core/task/include/data_view.hpp"
+
+namespace {
+
+// instance i sums i + 1 ones into sums[i]
+std::shared_ptr<ppc::core::TaskData> make_batch(std::vector<std::vector<int32_t>> &inputs,
+                                                std::vector<int32_t> &sums, size_t num_instances) {
+  inputs.resize(num_instances);
+  sums.assign(num_instances, -1);
+  std::vector<std::span<int32_t>> outputs;
+  for (size_t i = 0; i < num_instances; i++) {
+    inputs[i].assign(i + 1, 1);
+    outputs.emplace_back(&sums[i], 1);
+  }
+  return ppc::test::make_data<int32_t>({inputs.begin(), inputs.end()}, outputs);
+}
+
+}  // namespace
+
+TEST(batch_tests, check_batch_layout) {
+  std::vector<std::vector<int32_t>> inputs;
+  std::vector<int32_t> sums;
+  auto batch = make_batch(inputs, sums, 3);
+
+  EXPECT_EQ(ppc::core::batch_size(*batch, {1, 1}), 3U);
+  EXPECT_THROW(ppc::core::batch_size(*batch, {2, 1}), std::invalid_argument);
+  EXPECT_THROW(ppc::core::batch_size(*batch, {0, 0}), std::invalid_argument);
+
+  ppc::core::TaskData instance;
+  ppc::core::select_instance(*batch, {1, 1}, 2, instance);
+  ASSERT_EQ(instance.inputs.size(), 1U);
+  EXPECT_EQ(instance.inputs[0], reinterpret_cast<uint8_t *>(inputs[2].data()));
+  EXPECT_EQ(instance.inputs_count[0], 3U);
+  EXPECT_EQ(instance.outputs[0], reinterpret_cast<uint8_t *>(&sums[2]));
+  EXPECT_TRUE(ppc::core::input_desc(instance, 0)->holds<int32_t>());
+}
+
+TEST(batch_tests, check_runner_builds_one_task_per_worker) {
+  std::vector<std::vector<int32_t>> inputs;
+  std::vector<int32_t> sums;
+  auto batch = make_batch(inputs, sums, 200);
+
+  std::atomic<int> num_tasks{0};
+  ppc::core::BatchRunner runner(
+      [&](std::shared_ptr<ppc::core::TaskData> taskData) {
+        num_tasks++;
+        return std::make_shared<ppc::test::TestTask<int32_t>>(taskData);
+      },
+      {1, 1}, 4);
+  ASSERT_TRUE(runner.run(*batch));
+  for (size_t i = 0; i < sums.size(); i++) {
+    EXPECT_EQ(sums[i], static_cast<int32_t>(i + 1));
+  }
+  EXPECT_LE(num_tasks.load(), 4);
+  EXPECT_TRUE(runner.failed().empty());
+
+  // a part of the batch
+  sums.assign(sums.size(), -1);
+  ASSERT_TRUE(runner.run(*batch, 10, 20));
+  EXPECT_EQ(sums[9], -1);
+  EXPECT_EQ(sums[10], 11);
+  EXPECT_EQ(sums[19], 20);
+  EXPECT_EQ(sums[20], -1);
+  EXPECT_LE(num_tasks.load(), 4);
+  EXPECT_THROW(runner.run(*batch, 20, 201), std::out_of_range);
+}
+
+TEST(batch_tests, check_repeated_batch_without_allocations) {
+  std::vector<std::vector<int32_t>> inputs;
+  std::vector<int32_t> sums;
+  auto batch = make_batch(inputs, sums, 50);
+
+  ppc::core::BatchRunner runner(
+      [](std::shared_ptr<ppc::core::TaskData> taskData) {
+        return std::make_shared<ppc::test::TestTask<int32_t>>(taskData);
+      },
+      {1, 1}, 1);
+  ASSERT_TRUE(runner.run(*batch));
+
+  auto before = ppc::core::allocation_snapshot().count;
+  ASSERT_TRUE(runner.run(*batch));
+  EXPECT_EQ(ppc::core::allocation_snapshot().count, before);
+  EXPECT_EQ(sums.back(), 50);
+}
+
+TEST(batch_tests, check_failed_instances) {
+  std::vector<std::vector<int32_t>> inputs;
+  std::vector<int32_t> sums;
+  auto batch = make_batch(inputs, sums, 20);
+  // TestTask expects a single output element
+  batch->outputs_count[3] = 2;
+  batch->outputs_count[17] = 2;
+
+  ppc::core::BatchRunner runner(
+      [](std::shared_ptr<ppc::core::TaskData> taskData) {
+        return std::make_shared<ppc::test::TestTask<int32_t>>(taskData);
+      },
+      {1, 1}, 3);
+  EXPECT_FALSE(runner.run(*batch));
+  EXPECT_EQ(runner.failed(), std::vector<size_t>({3, 17}));
+  EXPECT_EQ(sums[4], 5);
+
+  // the factory has to bind the task to the data it is given
+  ppc::core::BatchRunner unbound(
+      [&](const std::shared_ptr<ppc::core::TaskData> &) {
+        return std::make_shared<ppc::test::TestTask<int32_t>>(batch);
+      },
+      {1, 1}, 2);
+  EXPECT_THROW(unbound.run(*batch), std::invalid_argument);
+}
+
+TEST(batch_tests, check_batch_task) {
+  std::vector<std::vector<int32_t>> inputs;
+  std::vector<int32_t> sums;
+  auto batch = make_batch(inputs, sums, 30);
+
+  ppc::core::BatchTask batchTask(batch, ppc::core::BatchRunner(
+                                            [](std::shared_ptr<ppc::core::TaskData> taskData) {
+                                              return std::make_shared<ppc::test::TestTask<int32_t>>(taskData);
+                                            },
+                                            {1, 1}, 2));
+  EXPECT_EQ(batchTask.size(), 30U);
+  ASSERT_TRUE(batchTask.validation());
+  batchTask.pre_processing();
+  ASSERT_TRUE(batchTask.run());
+  batchTask.post_processing();
+  EXPECT_EQ(sums[29], 30);
+
+  batch->outputs.pop_back();
+  batch->outputs_count.pop_back();
+  EXPECT_EQ(batchTask.size(), 0U);
+  EXPECT_FALSE(batchTask.validation());
+}
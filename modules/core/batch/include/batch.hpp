@@ -0,0 +1,94 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_BATCH_HPP_
+#define MODULES_CORE_INCLUDE_BATCH_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "core/async/include/worker_pool.hpp"
+#include "core/task/include/task.hpp"
+
+namespace ppc::core {
+
+// Layout of a batch: a single TaskData holding many independent problem
+// instances with the same number of buffers each. Instance i owns inputs
+// [i * inputs_per_instance, (i + 1) * inputs_per_instance) and the matching
+// range of outputs, together with their counts and descriptors.
+struct BatchShape {
+  std::size_t inputs_per_instance = 1;
+  std::size_t outputs_per_instance = 1;
+};
+
+// number of instances in batch; throws std::invalid_argument if the buffers
+// do not split into whole instances
+std::size_t batch_size(const TaskData &batch, const BatchShape &shape);
+
+// Point instance at the buffers of instance `index` of batch. The vectors of
+// instance are reused, so this does not allocate once instance has held an
+// instance of the same shape.
+void select_instance(const TaskData &batch, const BatchShape &shape, std::size_t index, TaskData &instance);
+
+// Runs one kind of task over the instances of a batch on a pool of workers.
+// Every worker constructs its task once and then repeats the lifecycle on
+// each instance it takes (see Task::reset()), so the setup a task keeps
+// between runs is paid per worker instead of per instance. The worker
+// threads are started by the first run() and kept for the next ones.
+class BatchRunner {
+ public:
+  using TaskFactory = std::function<std::shared_ptr<Task>(std::shared_ptr<TaskData>)>;
+
+  // num_workers 0 - get_num_threads()
+  BatchRunner(TaskFactory factory_, BatchShape shape, std::size_t num_workers = 0);
+
+  // run instances [begin, end) of batch; returns false if the lifecycle of
+  // some instance returned false. An exception thrown by a task is rethrown
+  // after the workers have stopped.
+  bool run(const TaskData &batch, std::size_t begin, std::size_t end);
+  bool run(const TaskData &batch);
+
+  // instances that failed in the last run(), in ascending order
+  [[nodiscard]] const std::vector<std::size_t> &failed() const { return failed_; }
+  [[nodiscard]] const BatchShape &shape() const { return shape_; }
+  [[nodiscard]] std::size_t num_workers() const { return workers.size(); }
+
+ private:
+  struct Worker {
+    std::shared_ptr<TaskData> data = std::make_shared<TaskData>();
+    std::shared_ptr<Task> task;
+    std::vector<std::size_t> failed;
+  };
+
+  TaskFactory factory;
+  BatchShape shape_;
+  std::vector<Worker> workers;
+  std::vector<std::size_t> failed_;
+  std::unique_ptr<WorkerPool> pool;
+
+  bool run_instance(Worker &worker, const TaskData &batch, std::size_t index);
+};
+
+// Task running a whole batch, so that Perf and the tests handle a batch like
+// any other task. Perf reports the time per instance of a BatchTask.
+class BatchTask : public Task {
+ public:
+  BatchTask(std::shared_ptr<TaskData> batch, BatchRunner runner_);
+
+  bool validation() override;
+  bool pre_processing() override;
+  bool run() override;
+  bool post_processing() override;
+
+  // number of instances; 0 if the buffers do not form a valid batch
+  [[nodiscard]] std::size_t size() const;
+  [[nodiscard]] const BatchRunner &get_runner() const { return runner; }
+
+ private:
+  BatchRunner runner;
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_BATCH_HPP_
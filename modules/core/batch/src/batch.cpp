@@ -0,0 +1,159 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/batch/include/batch.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "core/perf/include/scaling.hpp"
+
+namespace {
+
+// to = from[first, first + count), clipped to the elements from has
+template <class T>
+void copy_range(const std::vector<T> &from, size_t first, size_t count, std::vector<T> &to) {
+  size_t available = first < from.size() ? std::min(count, from.size() - first) : 0;
+  auto begin = from.begin() + static_cast<std::ptrdiff_t>(std::min(first, from.size()));
+  to.assign(begin, begin + static_cast<std::ptrdiff_t>(available));
+}
+
+}  // namespace
+
+size_t ppc::core::batch_size(const TaskData &batch, const BatchShape &shape) {
+  if (shape.inputs_per_instance == 0 && shape.outputs_per_instance == 0) {
+    throw std::invalid_argument("Batch instance has no buffers");
+  }
+  if (batch.inputs.size() != batch.inputs_count.size() || batch.outputs.size() != batch.outputs_count.size()) {
+    throw std::invalid_argument("Batch buffers and counts differ in size");
+  }
+  size_t size = shape.inputs_per_instance != 0 ? batch.inputs.size() / shape.inputs_per_instance
+                                               : batch.outputs.size() / shape.outputs_per_instance;
+  if (size * shape.inputs_per_instance != batch.inputs.size() ||
+      size * shape.outputs_per_instance != batch.outputs.size()) {
+    throw std::invalid_argument("Batch of " + std::to_string(batch.inputs.size()) + " inputs and " +
+                                std::to_string(batch.outputs.size()) + " outputs does not split into instances of " +
+                                std::to_string(shape.inputs_per_instance) + " inputs and " +
+                                std::to_string(shape.outputs_per_instance) + " outputs");
+  }
+  return size;
+}
+
+void ppc::core::select_instance(const TaskData &batch, const BatchShape &shape, size_t index, TaskData &instance) {
+  const size_t first_input = index * shape.inputs_per_instance;
+  const size_t first_output = index * shape.outputs_per_instance;
+  copy_range(batch.inputs, first_input, shape.inputs_per_instance, instance.inputs);
+  copy_range(batch.inputs_count, first_input, shape.inputs_per_instance, instance.inputs_count);
+  copy_range(batch.inputs_desc, first_input, shape.inputs_per_instance, instance.inputs_desc);
+  copy_range(batch.outputs, first_output, shape.outputs_per_instance, instance.outputs);
+  copy_range(batch.outputs_count, first_output, shape.outputs_per_instance, instance.outputs_count);
+  copy_range(batch.outputs_desc, first_output, shape.outputs_per_instance, instance.outputs_desc);
+  instance.state_of_testing = batch.state_of_testing;
+}
+
+ppc::core::BatchRunner::BatchRunner(TaskFactory factory_, BatchShape shape, size_t num_workers)
+    : factory(std::move(factory_)), shape_(shape) {
+  if (!factory) {
+    throw std::invalid_argument("Batch runner needs a task factory");
+  }
+  if (num_workers == 0) {
+    num_workers = static_cast<std::size_t>(get_num_threads());
+  }
+  workers.resize(num_workers);
+}
+
+bool ppc::core::BatchRunner::run(const TaskData &batch) { return run(batch, 0, batch_size(batch, shape_)); }
+
+bool ppc::core::BatchRunner::run(const TaskData &batch, size_t begin, size_t end) {
+  const size_t size = batch_size(batch, shape_);
+  if (begin > end || end > size) {
+    throw std::out_of_range("Instances [" + std::to_string(begin) + ", " + std::to_string(end) +
+                            ") are out of a batch of " + std::to_string(size));
+  }
+
+  for (auto &worker : workers) {
+    worker.failed.clear();
+  }
+  if (!pool) {
+    pool = std::make_unique<WorkerPool>(workers.size());
+  }
+  std::atomic<size_t> next{begin};
+  std::exception_ptr error;
+  try {
+    pool->run([&](size_t index) {
+      auto &worker = workers[index];
+      try {
+        for (size_t instance = next++; instance < end; instance = next++) {
+          if (!run_instance(worker, batch, instance)) {
+            worker.failed.push_back(instance);
+          }
+        }
+      } catch (...) {
+        next = end;
+        throw;
+      }
+    });
+  } catch (...) {
+    error = std::current_exception();
+  }
+
+  failed_.clear();
+  for (const auto &worker : workers) {
+    failed_.insert(failed_.end(), worker.failed.begin(), worker.failed.end());
+  }
+  std::sort(failed_.begin(), failed_.end());
+  if (error) {
+    std::rethrow_exception(error);
+  }
+  return failed_.empty();
+}
+
+bool ppc::core::BatchRunner::run_instance(Worker &worker, const TaskData &batch, size_t index) {
+  select_instance(batch, shape_, index, *worker.data);
+  if (!worker.task) {
+    worker.task = factory(worker.data);
+    if (!worker.task || worker.task->get_data() != worker.data) {
+      throw std::invalid_argument("Batch task factory must return a task bound to the given TaskData");
+    }
+    // the Task constructor switches the data to FUNC
+    worker.data->state_of_testing = batch.state_of_testing;
+  } else {
+    worker.task->reset();
+  }
+  auto &task = *worker.task;
+  return task.validation() && task.pre_processing() && task.run() && task.post_processing();
+}
+
+ppc::core::BatchTask::BatchTask(std::shared_ptr<TaskData> batch, BatchRunner runner_)
+    : Task(std::move(batch)), runner(std::move(runner_)) {}
+
+bool ppc::core::BatchTask::validation() {
+  internal_order_test();
+  return size() > 0;
+}
+
+bool ppc::core::BatchTask::pre_processing() {
+  internal_order_test();
+  return true;
+}
+
+bool ppc::core::BatchTask::run() {
+  internal_order_test();
+  return runner.run(*taskData);
+}
+
+bool ppc::core::BatchTask::post_processing() {
+  internal_order_test();
+  return true;
+}
+
+size_t ppc::core::BatchTask::size() const {
+  try {
+    return batch_size(*taskData, runner.shape());
+  } catch (const std::invalid_argument &) {
+    return 0;
+  }
+}
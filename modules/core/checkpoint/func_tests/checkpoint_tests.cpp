@@ -0,0 +1,151 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "core/checkpoint/include/checkpoint.hpp"
+
+namespace {
+
+std::string temp_path(const std::string &name) {
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+
+uint64_t problem_of(const std::vector<double> &b) {
+  return ppc::core::fingerprint(b.data(), b.size() * sizeof(double));
+}
+
+// x = (b - offdiag * x) / diag for the system with 2n on the diagonal and 1
+// elsewhere; stops after max_iterations (an interrupted run) or on
+// convergence, resuming from the last snapshot of checkpoint
+std::vector<double> jacobi(std::size_t n, uint64_t max_iterations, ppc::core::Checkpointer &checkpoint,
+                           uint64_t &iterations) {
+  std::vector<double> b(n, 1.0);
+  auto problem = problem_of(b);
+  std::vector<double> x(n, 0.0);
+  iterations = 0;
+  if (auto state = checkpoint.load(problem)) {
+    x = state->x;
+    iterations = state->iteration;
+  }
+  std::vector<double> next(n);
+  while (iterations < max_iterations) {
+    double sum = 0.0;
+    for (auto value : x) {
+      sum += value;
+    }
+    double residual = 0.0;
+    for (std::size_t i = 0; i < n; i++) {
+      next[i] = (b[i] - (sum - x[i])) / (2.0 * static_cast<double>(n));
+      residual = std::max(residual, std::abs(next[i] - x[i]));
+    }
+    x.swap(next);
+    checkpoint.snapshot(problem, ++iterations, residual, x);
+    if (residual < 1e-12) {
+      checkpoint.finish();
+      break;
+    }
+  }
+  return x;
+}
+
+}  // namespace
+
+TEST(checkpoint_tests, check_snapshot_and_load) {
+  auto path = temp_path("ppc_checkpoint_snapshot.ckpt");
+  std::vector<double> x = {1.0, 2.0, 3.0};
+  {
+    ppc::core::Checkpointer checkpoint(path, 2);
+    EXPECT_FALSE(checkpoint.snapshot(7, 1, 0.5, x));
+    EXPECT_TRUE(checkpoint.snapshot(7, 2, 0.25, x));
+    checkpoint.flush();
+
+    auto state = checkpoint.load(7);
+    ASSERT_TRUE(state.has_value());
+    EXPECT_EQ(state->iteration, 2U);
+    EXPECT_DOUBLE_EQ(state->residual, 0.25);
+    EXPECT_EQ(state->x, x);
+    EXPECT_FALSE(checkpoint.load(8).has_value());
+
+    auto stats = checkpoint.stats();
+    EXPECT_EQ(stats.taken, 1U);
+    EXPECT_EQ(stats.written, 1U);
+    EXPECT_EQ(stats.bytes_written, std::filesystem::file_size(path));
+  }
+  // a new process finds the snapshot
+  ppc::core::Checkpointer again(path, 2);
+  EXPECT_TRUE(again.load(7).has_value());
+  again.finish();
+  EXPECT_FALSE(std::filesystem::exists(path));
+  EXPECT_FALSE(again.load(7).has_value());
+
+  ppc::core::Checkpointer never(path, 0);
+  EXPECT_FALSE(never.snapshot(7, 0, 0.0, x));
+  EXPECT_NE(ppc::core::fingerprint(x.data(), 8), ppc::core::fingerprint(x.data(), 16));
+}
+
+TEST(checkpoint_tests, check_resume_after_interruption) {
+  auto path = temp_path("ppc_checkpoint_jacobi.ckpt");
+  std::filesystem::remove(path);
+  uint64_t iterations = 0;
+
+  ppc::core::Checkpointer unused(temp_path("ppc_checkpoint_unused.ckpt"), 0);
+  auto expected = jacobi(16, 1000, unused, iterations);
+  auto converged_after = iterations;
+  ASSERT_GT(converged_after, 10U);
+
+  {
+    // killed after 10 iterations, the snapshot of iteration 9 survives
+    ppc::core::Checkpointer checkpoint(path, 3);
+    jacobi(16, 10, checkpoint, iterations);
+  }
+  ppc::core::Checkpointer checkpoint(path, 3);
+  auto state = checkpoint.load(problem_of(std::vector<double>(16, 1.0)));
+  ASSERT_TRUE(state.has_value());
+  EXPECT_EQ(state->iteration, 9U);
+  auto resumed = jacobi(16, 1000, checkpoint, iterations);
+  EXPECT_EQ(iterations, converged_after);
+  EXPECT_EQ(resumed, expected);
+  // a finished solver leaves nothing to resume
+  EXPECT_FALSE(std::filesystem::exists(path));
+}
+
+TEST(checkpoint_tests, check_damaged_files_and_errors) {
+  auto path = temp_path("ppc_checkpoint_damaged.ckpt");
+  std::vector<double> x(4, 1.0);
+  ppc::core::Checkpointer checkpoint(path, 1);
+  checkpoint.snapshot(1, 1, 0.0, x);
+  checkpoint.flush();
+  auto size = std::filesystem::file_size(path);
+
+  std::filesystem::resize_file(path, size - 3);
+  EXPECT_FALSE(checkpoint.load(1).has_value());
+  {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << std::string(size, 'x');
+  }
+  EXPECT_FALSE(checkpoint.load(1).has_value());
+  std::filesystem::remove(path);
+
+  ppc::core::Checkpointer unwritable(temp_path("ppc_missing_dir/solver.ckpt"), 1);
+  unwritable.snapshot(1, 1, 0.0, x);
+  EXPECT_THROW(unwritable.flush(), std::runtime_error);
+  // reported once
+  EXPECT_NO_THROW(unwritable.flush());
+
+  // the non-throwing calls stop at the first failure and keep it
+  ppc::core::Checkpointer disabled(temp_path("ppc_missing_dir/solver.ckpt"), 1);
+  EXPECT_TRUE(disabled.try_snapshot(1, 1, 0.0, x));
+  EXPECT_NO_THROW(disabled.try_finish());
+  EXPECT_TRUE(disabled.disabled());
+  EXPECT_NE(disabled.stats().failure.find("Cannot write checkpoint"), std::string::npos);
+  EXPECT_FALSE(disabled.try_snapshot(1, 2, 0.0, x));
+  EXPECT_EQ(disabled.stats().taken, 1U);
+}
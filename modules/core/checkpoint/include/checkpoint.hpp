@@ -0,0 +1,124 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_CHECKPOINT_HPP_
+#define MODULES_CORE_INCLUDE_CHECKPOINT_HPP_
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ppc::core {
+
+// Snapshot of an iterative solver
+struct SolverState {
+  // fingerprint of the problem (see fingerprint()), so a snapshot is never
+  // resumed for other inputs
+  uint64_t problem = 0;
+  // iterations done to reach x
+  uint64_t iteration = 0;
+  double residual = 0.0;
+  std::vector<double> x;
+};
+
+// FNV-1a hash of bytes; chain calls through seed to cover several buffers
+uint64_t fingerprint(const void *data, std::size_t bytes, uint64_t seed = 14695981039346656037ULL);
+
+struct CheckpointStats {
+  // snapshots handed to the writer, and those replaced by a newer one before
+  // it got to them
+  uint64_t taken = 0;
+  uint64_t superseded = 0;
+  uint64_t written = 0;
+  uint64_t bytes_written = 0;
+  // time the solver spent in snapshot() copying its state: the overhead on
+  // the iterations
+  double copy_sec = 0.0;
+  // time the writer thread spent writing, overlapped with the iterations
+  double write_sec = 0.0;
+  // the error that made try_snapshot() or try_finish() disable checkpointing
+  std::string failure;
+};
+
+// Periodic snapshots of an iterative solver on local disk. snapshot() only
+// copies the state; a writer thread puts it in the file through a temporary
+// and a rename, so an interrupted run leaves the previous snapshot intact.
+// When the disk is slower than the iterations, the snapshot waiting for the
+// writer is replaced by the newer one instead of stalling the solver.
+//
+// A solver loads() its last snapshot at the start of run(), calls
+// snapshot() after every iteration and finish() once it has converged.
+class Checkpointer {
+ public:
+  static constexpr uint64_t kDefaultEvery = 100;
+
+  // a snapshot is taken every `every` iterations, 0 disables them
+  explicit Checkpointer(std::string path_, uint64_t every_ = kDefaultEvery);
+  Checkpointer(const Checkpointer &) = delete;
+  Checkpointer &operator=(const Checkpointer &) = delete;
+  // writes the pending snapshot; errors are dropped here, call flush() to see them
+  ~Checkpointer();
+
+  // <PPC_CHECKPOINT_DIR>/<name>.ckpt every PPC_CHECKPOINT_EVERY iterations,
+  // nullptr if PPC_CHECKPOINT_DIR is not set
+  static std::shared_ptr<Checkpointer> from_env(const std::string &name);
+
+  [[nodiscard]] bool due(uint64_t iteration) const { return every != 0 && iteration % every == 0; }
+
+  // copy x for the writer if due(iteration); returns whether it did. Rethrows
+  // the failure of an earlier write.
+  bool snapshot(uint64_t problem, uint64_t iteration, double residual, std::span<const double> x);
+  // last snapshot written for problem; nothing if there is none, it belongs to
+  // another problem or the file is damaged
+  [[nodiscard]] std::optional<SolverState> load(uint64_t problem) const;
+  // wait until the pending snapshot is written; throws std::runtime_error if
+  // a write failed
+  void flush();
+  // flush() and delete the snapshot: the solver is done, a new run starts over
+  void finish();
+
+  // snapshot() and finish() for a root rank, which must not throw while the
+  // other ranks wait for it in the next collective. The first failure is
+  // printed once, kept in stats().failure and turns both into no-ops.
+  bool try_snapshot(uint64_t problem, uint64_t iteration, double residual, std::span<const double> x);
+  void try_finish();
+  [[nodiscard]] bool disabled() const;
+
+  [[nodiscard]] CheckpointStats stats() const;
+  [[nodiscard]] const std::string &path() const { return path_; }
+  [[nodiscard]] uint64_t interval() const { return every; }
+
+ private:
+  void write_loop();
+  void write(const SolverState &state);
+  void rethrow_error();
+  void disable(const std::exception &failure);
+
+  std::string path_;
+  uint64_t every;
+
+  mutable std::mutex mutex;
+  std::condition_variable changed;
+  // snapshot waiting for the writer; the writer swaps it with its own buffer,
+  // so both keep their capacity and a snapshot allocates nothing
+  SolverState pending;
+  SolverState writing;
+  bool has_pending = false;
+  bool busy = false;
+  bool stopping = false;
+  bool disabled_ = false;
+  std::exception_ptr error;
+  CheckpointStats stats_;
+  std::thread writer;
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_CHECKPOINT_HPP_
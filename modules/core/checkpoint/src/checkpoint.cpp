@@ -0,0 +1,248 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/checkpoint/include/checkpoint.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+// file layout: magic, problem, iteration, residual, size, x, fingerprint of
+// everything before it
+constexpr char kMagic[8] = {'P', 'P', 'C', 'C', 'K', 'P', 'T', '1'};
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <class T>
+void put(std::vector<char> &out, const T &value) {
+  const auto *bytes = reinterpret_cast<const char *>(&value);
+  out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+template <class T>
+bool get(const std::vector<char> &in, std::size_t &position, T &value) {
+  if (in.size() - position < sizeof(T)) {
+    return false;
+  }
+  std::memcpy(&value, in.data() + position, sizeof(T));
+  position += sizeof(T);
+  return true;
+}
+
+}  // namespace
+
+uint64_t ppc::core::fingerprint(const void *data, std::size_t bytes, uint64_t seed) {
+  const auto *byte = static_cast<const unsigned char *>(data);
+  for (std::size_t i = 0; i < bytes; i++) {
+    seed = (seed ^ byte[i]) * 1099511628211ULL;
+  }
+  return seed;
+}
+
+ppc::core::Checkpointer::Checkpointer(std::string path_, uint64_t every_) : path_(std::move(path_)), every(every_) {}
+
+ppc::core::Checkpointer::~Checkpointer() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  changed.notify_all();
+  if (writer.joinable()) {
+    writer.join();
+  }
+}
+
+std::shared_ptr<ppc::core::Checkpointer> ppc::core::Checkpointer::from_env(const std::string &name) {
+  const char *dir = std::getenv("PPC_CHECKPOINT_DIR");
+  if (dir == nullptr || *dir == '\0') {
+    return nullptr;
+  }
+  const char *every = std::getenv("PPC_CHECKPOINT_EVERY");
+  uint64_t interval = every != nullptr && *every != '\0' ? std::strtoull(every, nullptr, 10) : kDefaultEvery;
+  return std::make_shared<Checkpointer>((std::filesystem::path(dir) / (name + ".ckpt")).string(), interval);
+}
+
+bool ppc::core::Checkpointer::snapshot(uint64_t problem, uint64_t iteration, double residual,
+                                       std::span<const double> x) {
+  if (!due(iteration)) {
+    return false;
+  }
+  auto start = std::chrono::steady_clock::now();
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (error) {
+      rethrow_error();
+    }
+    stats_.superseded += has_pending ? 1 : 0;
+    pending.problem = problem;
+    pending.iteration = iteration;
+    pending.residual = residual;
+    pending.x.assign(x.begin(), x.end());
+    has_pending = true;
+    stats_.taken++;
+    if (!writer.joinable()) {
+      writer = std::thread([this] { write_loop(); });
+    }
+    stats_.copy_sec += seconds_since(start);
+  }
+  changed.notify_all();
+  return true;
+}
+
+void ppc::core::Checkpointer::write_loop() {
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true) {
+    changed.wait(lock, [&] { return has_pending || stopping; });
+    if (!has_pending) {
+      return;
+    }
+    std::swap(pending, writing);
+    has_pending = false;
+    busy = true;
+    lock.unlock();
+
+    auto start = std::chrono::steady_clock::now();
+    std::exception_ptr failure;
+    try {
+      write(writing);
+    } catch (...) {
+      failure = std::current_exception();
+    }
+
+    lock.lock();
+    busy = false;
+    stats_.write_sec += seconds_since(start);
+    if (failure) {
+      error = failure;
+    } else {
+      stats_.written++;
+      stats_.bytes_written += sizeof(kMagic) + 5 * sizeof(uint64_t) + writing.x.size() * sizeof(double);
+    }
+    changed.notify_all();
+  }
+}
+
+void ppc::core::Checkpointer::write(const SolverState &state) {
+  std::vector<char> bytes(kMagic, kMagic + sizeof(kMagic));
+  put(bytes, state.problem);
+  put(bytes, state.iteration);
+  put(bytes, state.residual);
+  put(bytes, static_cast<uint64_t>(state.x.size()));
+  const auto *x = reinterpret_cast<const char *>(state.x.data());
+  bytes.insert(bytes.end(), x, x + state.x.size() * sizeof(double));
+  put(bytes, fingerprint(bytes.data(), bytes.size()));
+
+  auto temp_path = path_ + ".tmp";
+  {
+    std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    if (!out) {
+      throw std::runtime_error("Cannot write checkpoint: " + temp_path);
+    }
+  }
+  std::error_code failure;
+  std::filesystem::rename(temp_path, path_, failure);
+  if (failure) {
+    std::filesystem::remove(temp_path, failure);
+    throw std::runtime_error("Cannot write checkpoint: " + path_);
+  }
+}
+
+std::optional<ppc::core::SolverState> ppc::core::Checkpointer::load(uint64_t problem) const {
+  std::ifstream in(path_, std::ios::binary);
+  if (!in.is_open()) {
+    return std::nullopt;
+  }
+  std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  if (bytes.size() < sizeof(kMagic) + sizeof(uint64_t) || std::memcmp(bytes.data(), kMagic, sizeof(kMagic)) != 0) {
+    return std::nullopt;
+  }
+  uint64_t sum = 0;
+  std::memcpy(&sum, bytes.data() + bytes.size() - sizeof(uint64_t), sizeof(uint64_t));
+  bytes.resize(bytes.size() - sizeof(uint64_t));
+  if (sum != fingerprint(bytes.data(), bytes.size())) {
+    return std::nullopt;
+  }
+
+  SolverState state;
+  std::size_t position = sizeof(kMagic);
+  uint64_t size = 0;
+  if (!get(bytes, position, state.problem) || !get(bytes, position, state.iteration) ||
+      !get(bytes, position, state.residual) || !get(bytes, position, size) ||
+      bytes.size() - position != size * sizeof(double) || state.problem != problem) {
+    return std::nullopt;
+  }
+  state.x.resize(size);
+  std::memcpy(state.x.data(), bytes.data() + position, size * sizeof(double));
+  return state;
+}
+
+void ppc::core::Checkpointer::flush() {
+  std::unique_lock<std::mutex> lock(mutex);
+  changed.wait(lock, [&] { return (!has_pending && !busy) || error; });
+  if (error) {
+    rethrow_error();
+  }
+}
+
+void ppc::core::Checkpointer::finish() {
+  flush();
+  std::error_code ignored;
+  std::filesystem::remove(path_, ignored);
+}
+
+bool ppc::core::Checkpointer::try_snapshot(uint64_t problem, uint64_t iteration, double residual,
+                                           std::span<const double> x) {
+  if (disabled()) {
+    return false;
+  }
+  try {
+    return snapshot(problem, iteration, residual, x);
+  } catch (const std::exception &failure) {
+    disable(failure);
+    return false;
+  }
+}
+
+void ppc::core::Checkpointer::try_finish() {
+  if (disabled()) {
+    return;
+  }
+  try {
+    finish();
+  } catch (const std::exception &failure) {
+    disable(failure);
+  }
+}
+
+bool ppc::core::Checkpointer::disabled() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return disabled_;
+}
+
+void ppc::core::Checkpointer::disable(const std::exception &failure) {
+  std::cerr << "Checkpointing disabled: " << failure.what() << std::endl;
+  std::lock_guard<std::mutex> lock(mutex);
+  disabled_ = true;
+  stats_.failure = failure.what();
+}
+
+ppc::core::CheckpointStats ppc::core::Checkpointer::stats() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return stats_;
+}
+
+void ppc::core::Checkpointer::rethrow_error() {
+  // reported once, the next snapshots are tried again
+  auto failure = std::exchange(error, nullptr);
+  has_pending = false;
+  std::rethrow_exception(failure);
+}
@@ -0,0 +1,235 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "core/dispatch/include/dispatcher.hpp"
+#include "core/perf/func_tests/test_task.hpp"
+#include "core/perf/include/results_sink.hpp"
+#include "core/task/include/data_view.hpp"
+
+namespace {
+
+using ppc::core::Backend;
+
+// registers a sum task for each backend that remembers which one was created
+void register_backends(ppc::core::BackendRegistry &registry, const std::string &problem,
+                       const std::vector<Backend> &backends, std::vector<Backend> &created) {
+  for (auto backend : backends) {
+    registry.add(problem, backend, [backend, &created](std::shared_ptr<ppc::core::TaskData> taskData) {
+      created.push_back(backend);
+      return std::make_shared<ppc::test::TestTask<int>>(taskData);
+    });
+  }
+}
+
+// a run on 4 processes of 4 threads unless workers says otherwise
+ppc::core::PerfRecord make_record(const std::string &backend, uint64_t problem_size, double mean, int workers = 4) {
+  ppc::core::PerfResults results;
+  results.type_of_running = ppc::core::PerfResults::TypeOfRunning::PIPELINE;
+  results.problem_size = problem_size;
+  results.num_running = 5;
+  results.time_sec = mean * 5;
+  results.statistics = ppc::core::compute_statistics({mean, mean, mean, mean, mean});
+  auto record = ppc::core::make_perf_record("tasks/" + backend + "/sum", results);
+  record.num_procs = workers;
+  record.num_threads = workers;
+  return record;
+}
+
+}  // namespace
+
+TEST(dispatch_tests, check_backend_names) {
+  for (auto backend : {Backend::SEQ, Backend::OMP, Backend::TBB, Backend::STL, Backend::MPI}) {
+    EXPECT_EQ(ppc::core::parse_backend(ppc::core::backend_name(backend)), backend);
+  }
+  EXPECT_STREQ(ppc::core::backend_name(Backend::MPI), "mpi");
+  EXPECT_THROW(static_cast<void>(ppc::core::parse_backend("cuda")), std::invalid_argument);
+
+  ppc::core::ExecutionContext context;
+  EXPECT_TRUE(context.can_run(Backend::SEQ));
+  EXPECT_FALSE(context.can_run(Backend::OMP));
+  EXPECT_FALSE(context.can_run(Backend::MPI));
+  context.num_threads = 4;
+  context.num_ranks = 2;
+  EXPECT_TRUE(context.can_run(Backend::TBB));
+  EXPECT_TRUE(context.can_run(Backend::MPI));
+  EXPECT_EQ(context.workers(Backend::SEQ), 1);
+  EXPECT_EQ(context.workers(Backend::TBB), 4);
+  EXPECT_EQ(context.workers(Backend::MPI), 2);
+  EXPECT_GE(ppc::core::ExecutionContext::detect().num_threads, 1);
+}
+
+TEST(dispatch_tests, check_registry) {
+  ppc::core::BackendRegistry registry;
+  std::vector<Backend> created;
+  register_backends(registry, "sum", {Backend::MPI, Backend::SEQ}, created);
+
+  EXPECT_TRUE(registry.has("sum", Backend::SEQ));
+  EXPECT_FALSE(registry.has("sum", Backend::OMP));
+  EXPECT_FALSE(registry.has("other", Backend::SEQ));
+  EXPECT_EQ(registry.backends("sum"), std::vector<Backend>({Backend::SEQ, Backend::MPI}));
+  EXPECT_TRUE(registry.backends("other").empty());
+
+  auto task = registry.create("sum", Backend::MPI, std::make_shared<ppc::core::TaskData>());
+  EXPECT_NE(task, nullptr);
+  EXPECT_EQ(created, std::vector<Backend>({Backend::MPI}));
+  EXPECT_THROW(static_cast<void>(registry.create("sum", Backend::OMP, nullptr)), std::out_of_range);
+  EXPECT_THROW(registry.add("sum", Backend::OMP, nullptr), std::invalid_argument);
+}
+
+TEST(dispatch_tests, check_choose_by_size_and_context) {
+  ppc::core::BackendRegistry registry;
+  std::vector<Backend> created;
+  register_backends(registry, "sum", {Backend::SEQ, Backend::OMP, Backend::MPI}, created);
+
+  ppc::core::Dispatcher dispatcher(registry);
+  dispatcher.set_threshold("sum", Backend::OMP, 10000);
+  dispatcher.set_threshold("sum", Backend::MPI, 1000000);
+
+  ppc::core::ExecutionContext context;
+  context.num_threads = 8;
+  context.num_ranks = 4;
+  EXPECT_EQ(dispatcher.choose("sum", 100, context), Backend::SEQ);
+  EXPECT_EQ(dispatcher.choose("sum", 10000, context), Backend::OMP);
+  EXPECT_EQ(dispatcher.choose("sum", 5000000, context), Backend::MPI);
+
+  // a backend the context cannot run is skipped
+  context.num_ranks = 1;
+  EXPECT_EQ(dispatcher.choose("sum", 5000000, context), Backend::OMP);
+  context.num_threads = 1;
+  EXPECT_EQ(dispatcher.choose("sum", 5000000, context), Backend::SEQ);
+
+  EXPECT_THROW(static_cast<void>(dispatcher.choose("other", 1, context)), std::out_of_range);
+
+  // without SEQ the lowest threshold is the fallback, an uncalibrated backend the last resort
+  ppc::core::BackendRegistry parallel_only;
+  register_backends(parallel_only, "sum", {Backend::OMP, Backend::MPI}, created);
+  ppc::core::Dispatcher fallback(parallel_only);
+  EXPECT_THROW(static_cast<void>(fallback.choose("sum", 1, context)), std::runtime_error);
+  context.num_threads = 2;
+  context.num_ranks = 2;
+  fallback.set_threshold("sum", Backend::MPI, 1000);
+  EXPECT_EQ(fallback.choose("sum", 1, context), Backend::MPI);
+  EXPECT_EQ(fallback.threshold("sum", Backend::OMP), ppc::core::Dispatcher::kNever);
+}
+
+TEST(dispatch_tests, check_thresholds_per_worker_count) {
+  ppc::core::BackendRegistry registry;
+  std::vector<Backend> created;
+  register_backends(registry, "sum", {Backend::SEQ, Backend::OMP}, created);
+
+  // OMP pays off earlier the more threads it gets
+  ppc::core::Dispatcher dispatcher(registry);
+  dispatcher.set_threshold("sum", Backend::OMP, 1000000);
+  dispatcher.set_threshold("sum", Backend::OMP, 100000, 2);
+  dispatcher.set_threshold("sum", Backend::OMP, 10000, 8);
+  EXPECT_EQ(dispatcher.threshold("sum", Backend::OMP), 1000000U);
+  EXPECT_EQ(dispatcher.threshold("sum", Backend::OMP, 2), 100000U);
+  EXPECT_EQ(dispatcher.threshold("sum", Backend::OMP, 4), 100000U);
+  EXPECT_EQ(dispatcher.threshold("sum", Backend::OMP, 16), 10000U);
+  EXPECT_EQ(dispatcher.threshold("sum", Backend::OMP, 1), 1000000U);
+  EXPECT_EQ(dispatcher.threshold("sum", Backend::MPI, 8), ppc::core::Dispatcher::kNever);
+
+  ppc::core::ExecutionContext context;
+  context.num_threads = 2;
+  EXPECT_EQ(dispatcher.choose("sum", 50000, context), Backend::SEQ);
+  context.num_threads = 8;
+  EXPECT_EQ(dispatcher.choose("sum", 50000, context), Backend::OMP);
+}
+
+TEST(dispatch_tests, check_calibrate_from_results_file) {
+  // OMP wins from 10^4, MPI loses at 10^4 but wins from 10^6, STL never wins
+  std::vector<ppc::core::PerfRecord> records = {
+      make_record("seq", 100, 1e-5),   make_record("seq", 10000, 1e-3),  make_record("seq", 1000000, 1e-1),
+      make_record("omp", 100, 2e-5),   make_record("omp", 10000, 5e-4), make_record("omp", 1000000, 3e-2),
+      make_record("mpi", 100, 1e-3),   make_record("mpi", 10000, 2e-3), make_record("mpi", 1000000, 1e-2),
+      make_record("stl", 1000000, 1.0),
+      // on 2 threads OMP only wins at the largest size
+      make_record("omp", 10000, 2e-3, 2), make_record("omp", 1000000, 6e-2, 2)};
+  auto task_run = make_record("seq", 1000000, 1e-6);
+  task_run.type_of_running = "task_run";
+  records.push_back(task_run);
+
+  for (const auto *name : {"ppc_dispatch_test.jsonl", "ppc_dispatch_test.csv"}) {
+    auto path = std::filesystem::temp_directory_path() / name;
+    std::filesystem::remove(path);
+    auto format = path.extension() == ".csv" ? ppc::core::ResultsSink::Format::CSV
+                                             : ppc::core::ResultsSink::Format::JSON_LINES;
+    ppc::core::ResultsSink sink(path.string(), format);
+    for (const auto &record : records) {
+      sink.write(record);
+    }
+
+    auto read = ppc::core::ResultsSink::read(path.string());
+    ASSERT_EQ(read.size(), records.size());
+    EXPECT_EQ(read[4].task_id, "sum");
+    EXPECT_EQ(read[4].backend, "omp");
+    EXPECT_EQ(read[4].results.problem_size, 10000U);
+    EXPECT_EQ(read[4].results.num_running, 5U);
+    EXPECT_DOUBLE_EQ(read[4].results.statistics.mean, 5e-4);
+    EXPECT_EQ(read.back().results.type_of_running, ppc::core::PerfResults::TypeOfRunning::TASK_RUN);
+
+    ppc::core::Dispatcher dispatcher;
+    EXPECT_TRUE(dispatcher.calibrate(path.string()));
+    EXPECT_EQ(dispatcher.threshold("sum", Backend::OMP, 4), 10000U);
+    EXPECT_EQ(dispatcher.threshold("sum", Backend::OMP, 2), 1000000U);
+    EXPECT_EQ(dispatcher.threshold("sum", Backend::OMP), ppc::core::Dispatcher::kNever);
+    EXPECT_EQ(dispatcher.threshold("sum", Backend::MPI, 4), 1000000U);
+    EXPECT_EQ(dispatcher.threshold("sum", Backend::STL, 4), ppc::core::Dispatcher::kNever);
+    EXPECT_EQ(dispatcher.threshold("sum", Backend::TBB, 4), ppc::core::Dispatcher::kNever);
+    std::filesystem::remove(path);
+  }
+
+  ppc::core::Dispatcher dispatcher;
+  EXPECT_FALSE(dispatcher.calibrate((std::filesystem::temp_directory_path() / "ppc_no_such_results").string()));
+}
+
+TEST(dispatch_tests, check_create_runs_chosen_backend) {
+  ppc::core::BackendRegistry registry;
+  std::vector<Backend> created;
+  register_backends(registry, "sum", {Backend::SEQ, Backend::OMP}, created);
+  ppc::core::Dispatcher dispatcher(registry);
+  dispatcher.set_threshold("sum", Backend::OMP, 100);
+
+  ppc::core::ExecutionContext context;
+  context.num_threads = 2;
+  for (size_t count : {10, 1000}) {
+    std::vector<int> in(count, 1);
+    std::vector<int> out(1, 0);
+    auto taskData = std::make_shared<ppc::core::TaskData>();
+    ppc::core::add_input(*taskData, in.data(), {in.size()});
+    ppc::core::add_output(*taskData, out.data(), {out.size()});
+
+    auto task = dispatcher.create("sum", taskData, context);
+    ASSERT_TRUE(task->validation());
+    task->pre_processing();
+    task->run();
+    task->post_processing();
+    EXPECT_EQ(out[0], static_cast<int>(count));
+  }
+  EXPECT_EQ(created, std::vector<Backend>({Backend::SEQ, Backend::OMP}));
+}
+
+TEST(dispatch_tests, check_create_agrees_on_size_across_ranks) {
+  ppc::core::BackendRegistry registry;
+  std::vector<Backend> created;
+  register_backends(registry, "sum", {Backend::SEQ, Backend::MPI}, created);
+  ppc::core::Dispatcher dispatcher(registry);
+  dispatcher.set_threshold("sum", Backend::MPI, 100);
+
+  // a non-root rank: no inputs of its own
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  ppc::core::ExecutionContext context;
+  context.num_ranks = 2;
+  EXPECT_THROW(static_cast<void>(dispatcher.create("sum", taskData, context)), std::invalid_argument);
+
+  // the root has 1000 elements
+  dispatcher.set_size_agreement([](uint64_t) { return uint64_t{1000}; });
+  EXPECT_NE(dispatcher.create("sum", taskData, context), nullptr);
+  EXPECT_EQ(created, std::vector<Backend>({Backend::MPI}));
+}
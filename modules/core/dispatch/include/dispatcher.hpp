@@ -0,0 +1,131 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_DISPATCHER_HPP_
+#define MODULES_CORE_INCLUDE_DISPATCHER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "core/perf/include/results_sink.hpp"
+#include "core/task/include/task.hpp"
+
+namespace ppc::core {
+
+// Implementations a problem can have, named after the tasks/<backend> directories
+enum class Backend : uint8_t { SEQ, OMP, TBB, STL, MPI };
+constexpr std::size_t kNumBackends = 5;
+
+const char* backend_name(Backend backend);
+// throws std::invalid_argument for an unknown name
+Backend parse_backend(const std::string& name);
+
+// Resources the current run has
+struct ExecutionContext {
+  int num_threads = 1;
+  int num_ranks = 1;
+
+  // get_num_threads() and the size of the MPI job from the launcher
+  // environment (1 outside of mpirun)
+  static ExecutionContext detect();
+
+  // SEQ always fits; OMP/TBB/STL need more than one thread, MPI more than one rank
+  [[nodiscard]] bool can_run(Backend backend) const;
+  // workers backend runs on: ranks for MPI, threads for OMP/TBB/STL, 1 for SEQ
+  [[nodiscard]] int workers(Backend backend) const;
+};
+
+// Maps a problem id (the task directory name, e.g. "example") to the
+// backends implementing it
+class BackendRegistry {
+ public:
+  using TaskFactory = std::function<std::shared_ptr<Task>(std::shared_ptr<TaskData>)>;
+
+  // replaces an earlier factory of the same backend
+  void add(const std::string& problem, Backend backend, TaskFactory factory);
+
+  [[nodiscard]] bool has(const std::string& problem, Backend backend) const;
+  // in enum order; empty for an unknown problem
+  [[nodiscard]] std::vector<Backend> backends(const std::string& problem) const;
+  // throws std::out_of_range if problem has no such backend
+  [[nodiscard]] std::shared_ptr<Task> create(const std::string& problem, Backend backend,
+                                             std::shared_ptr<TaskData> taskData) const;
+
+  // registry used by Dispatcher by default
+  static BackendRegistry& global();
+
+ private:
+  std::map<std::string, std::map<Backend, TaskFactory>> factories;
+};
+
+// Picks the backend of a problem for a given input size and context.
+//
+// Every backend except SEQ has a threshold: the smallest problem size from
+// which it is worth its overhead. Among the registered backends the context
+// can run, the one with the largest threshold not above the problem size
+// wins, so e.g. thresholds omp = 10^4 and mpi = 10^6 give SEQ for small
+// inputs, OMP for medium and MPI for large ones. A backend without a
+// threshold is only chosen if nothing else can run.
+//
+// Thresholds may be set per worker count, since the crossover moves with the
+// threads or ranks a backend gets; the threshold for the context's count is
+// used, or the one for the closest count below it, or the one for any count.
+//
+// The choice depends on its arguments only, so all ranks of an MPI job
+// agree as long as they pass the same problem size. Non-root ranks usually
+// have no inputs, so create() with several ranks needs a size agreement (see
+// core/mpi/include/dispatch_mpi.hpp) that hands every rank the root's size.
+class Dispatcher {
+ public:
+  static constexpr uint64_t kNever = std::numeric_limits<uint64_t>::max();
+
+  explicit Dispatcher(const BackendRegistry& registry_ = BackendRegistry::global());
+
+  // workers 0 sets the threshold for any worker count
+  void set_threshold(const std::string& problem, Backend backend, uint64_t min_problem_size, int workers = 0);
+  // threshold on workers as described above; kNever if none is set (0 for SEQ)
+  [[nodiscard]] uint64_t threshold(const std::string& problem, Backend backend, int workers = 0) const;
+
+  // Set thresholds from perf records of the problems (see ResultsSink), per
+  // worker count of the records (processes for MPI, threads otherwise): the
+  // threshold of a backend is the smallest measured size from which it is
+  // faster than SEQ at every measured size, kNever if it never is. Mean
+  // pipeline times at the sizes both were measured at are compared; records of
+  // other run types and problems without SEQ records are ignored.
+  void calibrate(const std::vector<PerfRecord>& records);
+  // records of a ResultsSink file; returns false if it has none
+  bool calibrate(const std::string& results_path);
+
+  // throws std::out_of_range if nothing is registered for problem and
+  // std::runtime_error if none of its backends can run in context
+  [[nodiscard]] Backend choose(const std::string& problem, uint64_t problem_size,
+                               const ExecutionContext& context = ExecutionContext::detect()) const;
+
+  // Collective hook turning the local problem size into the one every rank
+  // agrees on, used by create() when the context has more than one rank
+  void set_size_agreement(std::function<uint64_t(uint64_t)> agreement);
+
+  // task of the chosen backend; the problem size is the total element count
+  // of taskData's inputs, as in PerfResults, passed through the size
+  // agreement. Throws std::invalid_argument with several ranks and no agreement
+  [[nodiscard]] std::shared_ptr<Task> create(const std::string& problem, std::shared_ptr<TaskData> taskData,
+                                             const ExecutionContext& context = ExecutionContext::detect()) const;
+  [[nodiscard]] std::shared_ptr<Task> create(const std::string& problem, std::shared_ptr<TaskData> taskData,
+                                             uint64_t problem_size, const ExecutionContext& context) const;
+
+ private:
+  const BackendRegistry& registry;
+  std::map<std::tuple<std::string, Backend, int>, uint64_t> thresholds;
+  std::function<uint64_t(uint64_t)> size_agreement;
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_DISPATCHER_HPP_
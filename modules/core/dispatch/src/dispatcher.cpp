@@ -0,0 +1,238 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/dispatch/include/dispatcher.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <numeric>
+#include <stdexcept>
+
+#include "core/perf/include/scaling.hpp"
+
+namespace {
+
+constexpr std::array<const char*, ppc::core::kNumBackends> kBackendNames = {"seq", "omp", "tbb", "stl", "mpi"};
+
+// mean time of one pipeline run, 0 if the record has none
+double run_time(const ppc::core::PerfRecord& record) {
+  const auto& results = record.results;
+  if (results.statistics.mean > 0.0) {
+    return results.statistics.mean;
+  }
+  return results.num_running > 0 ? results.time_sec / static_cast<double>(results.num_running) : 0.0;
+}
+
+}  // namespace
+
+const char* ppc::core::backend_name(Backend backend) { return kBackendNames.at(static_cast<std::size_t>(backend)); }
+
+ppc::core::Backend ppc::core::parse_backend(const std::string& name) {
+  for (std::size_t i = 0; i < kNumBackends; i++) {
+    if (name == kBackendNames[i]) {
+      return static_cast<Backend>(i);
+    }
+  }
+  throw std::invalid_argument("Unknown backend: " + name);
+}
+
+ppc::core::ExecutionContext ppc::core::ExecutionContext::detect() {
+  ExecutionContext context;
+  context.num_threads = get_num_threads();
+  for (const auto* name : {"OMPI_COMM_WORLD_SIZE", "PMI_SIZE"}) {
+    const char* value = std::getenv(name);
+    if (value != nullptr && std::atoi(value) > 0) {
+      context.num_ranks = std::atoi(value);
+      break;
+    }
+  }
+  return context;
+}
+
+bool ppc::core::ExecutionContext::can_run(Backend backend) const {
+  switch (backend) {
+    case Backend::SEQ:
+      return true;
+    case Backend::MPI:
+      return num_ranks > 1;
+    default:
+      return num_threads > 1;
+  }
+}
+
+int ppc::core::ExecutionContext::workers(Backend backend) const {
+  switch (backend) {
+    case Backend::SEQ:
+      return 1;
+    case Backend::MPI:
+      return num_ranks;
+    default:
+      return num_threads;
+  }
+}
+
+void ppc::core::BackendRegistry::add(const std::string& problem, Backend backend, TaskFactory factory) {
+  if (!factory) {
+    throw std::invalid_argument("Empty task factory for " + problem + "/" + backend_name(backend));
+  }
+  factories[problem][backend] = std::move(factory);
+}
+
+bool ppc::core::BackendRegistry::has(const std::string& problem, Backend backend) const {
+  auto it = factories.find(problem);
+  return it != factories.end() && it->second.count(backend) != 0;
+}
+
+std::vector<ppc::core::Backend> ppc::core::BackendRegistry::backends(const std::string& problem) const {
+  std::vector<Backend> result;
+  auto it = factories.find(problem);
+  if (it != factories.end()) {
+    for (const auto& entry : it->second) {
+      result.push_back(entry.first);
+    }
+  }
+  return result;
+}
+
+std::shared_ptr<ppc::core::Task> ppc::core::BackendRegistry::create(const std::string& problem, Backend backend,
+                                                                    std::shared_ptr<TaskData> taskData) const {
+  if (!has(problem, backend)) {
+    throw std::out_of_range("No " + std::string(backend_name(backend)) + " backend registered for " + problem);
+  }
+  return factories.at(problem).at(backend)(std::move(taskData));
+}
+
+ppc::core::BackendRegistry& ppc::core::BackendRegistry::global() {
+  static BackendRegistry registry;
+  return registry;
+}
+
+ppc::core::Dispatcher::Dispatcher(const BackendRegistry& registry_) : registry(registry_) {}
+
+void ppc::core::Dispatcher::set_threshold(const std::string& problem, Backend backend, uint64_t min_problem_size,
+                                          int workers) {
+  thresholds[{problem, backend, std::max(workers, 0)}] = min_problem_size;
+}
+
+uint64_t ppc::core::Dispatcher::threshold(const std::string& problem, Backend backend, int workers) const {
+  // the entry for the most workers not above the given count; "any" is 0
+  auto it = thresholds.upper_bound({problem, backend, std::max(workers, 0)});
+  if (it != thresholds.begin()) {
+    --it;
+    if (std::get<0>(it->first) == problem && std::get<1>(it->first) == backend) {
+      return it->second;
+    }
+  }
+  return backend == Backend::SEQ ? 0 : kNever;
+}
+
+void ppc::core::Dispatcher::set_size_agreement(std::function<uint64_t(uint64_t)> agreement) {
+  size_agreement = std::move(agreement);
+}
+
+void ppc::core::Dispatcher::calibrate(const std::vector<PerfRecord>& records) {
+  // problem -> backend and workers -> problem size -> best mean run time; SEQ
+  // runs on one worker whatever the records say
+  std::map<std::string, std::map<std::pair<Backend, int>, std::map<uint64_t, double>>> times;
+  for (const auto& record : records) {
+    auto time = run_time(record);
+    if (record.type_of_running != "pipeline" || time <= 0.0) {
+      continue;
+    }
+    Backend backend;
+    try {
+      backend = parse_backend(record.backend);
+    } catch (const std::invalid_argument&) {
+      continue;
+    }
+    auto workers = backend == Backend::SEQ ? 1 : backend == Backend::MPI ? record.num_procs : record.num_threads;
+    auto [it, inserted] = times[record.task_id][{backend, workers}].emplace(record.results.problem_size, time);
+    if (!inserted) {
+      it->second = std::min(it->second, time);
+    }
+  }
+
+  for (const auto& [problem, by_backend] : times) {
+    auto seq = by_backend.find({Backend::SEQ, 1});
+    if (seq == by_backend.end()) {
+      continue;
+    }
+    for (const auto& [backend_workers, by_size] : by_backend) {
+      auto [backend, workers] = backend_workers;
+      if (backend == Backend::SEQ) {
+        continue;
+      }
+      // walk down from the largest size while the backend stays faster
+      uint64_t crossover = kNever;
+      bool compared = false;
+      for (auto it = by_size.rbegin(); it != by_size.rend(); ++it) {
+        auto seq_time = seq->second.find(it->first);
+        if (seq_time == seq->second.end()) {
+          continue;
+        }
+        compared = true;
+        if (it->second >= seq_time->second) {
+          break;
+        }
+        crossover = it->first;
+      }
+      if (compared) {
+        set_threshold(problem, backend, crossover, workers);
+      }
+    }
+  }
+}
+
+bool ppc::core::Dispatcher::calibrate(const std::string& results_path) {
+  auto records = ResultsSink::read(results_path);
+  calibrate(records);
+  return !records.empty();
+}
+
+ppc::core::Backend ppc::core::Dispatcher::choose(const std::string& problem, uint64_t problem_size,
+                                                 const ExecutionContext& context) const {
+  auto candidates = registry.backends(problem);
+  if (candidates.empty()) {
+    throw std::out_of_range("No backends registered for " + problem);
+  }
+  auto runnable = std::partition(candidates.begin(), candidates.end(),
+                                 [&](Backend backend) { return context.can_run(backend); });
+  if (runnable == candidates.begin()) {
+    throw std::runtime_error("No backend of " + problem + " can run with " + std::to_string(context.num_threads) +
+                             " threads and " + std::to_string(context.num_ranks) + " ranks");
+  }
+  candidates.erase(runnable, candidates.end());
+  auto min_size_of = [&](Backend backend) { return threshold(problem, backend, context.workers(backend)); };
+  std::stable_sort(candidates.begin(), candidates.end(),
+                   [&](Backend a, Backend b) { return min_size_of(a) < min_size_of(b); });
+
+  // largest threshold that the size reaches, the lowest one otherwise
+  auto chosen = candidates.front();
+  for (auto backend : candidates) {
+    auto min_size = min_size_of(backend);
+    if (min_size != kNever && min_size <= problem_size) {
+      chosen = backend;
+    }
+  }
+  return chosen;
+}
+
+std::shared_ptr<ppc::core::Task> ppc::core::Dispatcher::create(const std::string& problem,
+                                                               std::shared_ptr<TaskData> taskData,
+                                                               const ExecutionContext& context) const {
+  const auto& inputs_count = taskData->inputs_count;
+  auto problem_size = std::accumulate(inputs_count.begin(), inputs_count.end(), uint64_t{0});
+  if (context.num_ranks > 1) {
+    if (!size_agreement) {
+      throw std::invalid_argument("Dispatching " + problem + " across ranks needs a problem size agreement");
+    }
+    problem_size = size_agreement(problem_size);
+  }
+  return create(problem, std::move(taskData), problem_size, context);
+}
+
+std::shared_ptr<ppc::core::Task> ppc::core::Dispatcher::create(const std::string& problem,
+                                                               std::shared_ptr<TaskData> taskData,
+                                                               uint64_t problem_size,
+                                                               const ExecutionContext& context) const {
+  return registry.create(problem, choose(problem, problem_size, context), std::move(taskData));
+}
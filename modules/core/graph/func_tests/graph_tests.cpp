@@ -0,0 +1,180 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "core/graph/func_tests/test_task.hpp"
+#include "core/graph/include/task_graph.hpp"
+#include "core/task/func_tests/test_task.hpp"
+#include "core/task/include/data_view.hpp"
+
+TEST(graph_tests, check_chain_without_copies) {
+  // Create data
+  std::vector<int> in = {1, 2, 3, 4};
+  std::vector<int> mid(in.size());
+  std::vector<int> out(in.size());
+
+  auto sourceData = ppc::test::make_data<int>({}, {mid});
+  ppc::core::add_input(*sourceData, in.data(), {in.size()});
+
+  ppc::core::TaskGraph graph;
+  auto source = graph.add(std::make_shared<ppc::test::ScaleTask<int>>(sourceData, 2), "double");
+  auto sink = graph.add(std::make_shared<ppc::test::ScaleTask<int>>(ppc::test::make_data<int>({}, {out}), 3), "triple");
+  graph.connect(source, 0, sink, 0);
+
+  ASSERT_TRUE(graph.run());
+  EXPECT_EQ(out, std::vector<int>({6, 12, 18, 24}));
+
+  // the consumer reads the producer's output buffer in place
+  auto sinkData = graph.task(sink)->get_data();
+  EXPECT_EQ(sinkData->inputs[0], reinterpret_cast<uint8_t *>(mid.data()));
+  EXPECT_EQ(sinkData->inputs_count[0], mid.size());
+  EXPECT_TRUE(ppc::core::input_desc(*sinkData, 0)->holds<int>());
+  EXPECT_EQ(graph.name(sink), "triple");
+}
+
+TEST(graph_tests, check_diamond) {
+  // Create data
+  std::vector<int> in = {1, 2, 3};
+  std::vector<int> a(in.size());
+  std::vector<int> b(in.size());
+  std::vector<int> c(in.size());
+  std::vector<int> out(in.size());
+
+  auto sourceData = ppc::test::make_data<int>({}, {a});
+  ppc::core::add_input(*sourceData, in.data(), {in.size()});
+
+  ppc::core::TaskGraph graph;
+  auto source = graph.add(std::make_shared<ppc::test::ScaleTask<int>>(sourceData, 1));
+  auto left = graph.add(std::make_shared<ppc::test::ScaleTask<int>>(ppc::test::make_data<int>({}, {b}), 10));
+  auto right = graph.add(std::make_shared<ppc::test::ScaleTask<int>>(ppc::test::make_data<int>({}, {c}), 100));
+  auto sum = graph.add(std::make_shared<ppc::test::AddTask<int>>(ppc::test::make_data<int>({}, {out})));
+  graph.connect(source, 0, left, 0);
+  graph.connect(source, 0, right, 0);
+  graph.connect(left, 0, sum, 0);
+  graph.connect(right, 0, sum, 1);
+
+  auto order = graph.topological_order();
+  ASSERT_EQ(order.size(), 4U);
+  EXPECT_EQ(order.front(), source);
+  EXPECT_EQ(order.back(), sum);
+
+  ASSERT_TRUE(graph.run(4));
+  EXPECT_EQ(out, std::vector<int>({110, 220, 330}));
+
+  // the graph can be run again
+  in = {0, 0, 1};
+  ASSERT_TRUE(graph.run(1));
+  EXPECT_EQ(out, std::vector<int>({0, 0, 110}));
+}
+
+TEST(graph_tests, check_independent_branches_run_concurrently) {
+  // Create data
+  std::vector<int> in(8, 1);
+  std::vector<int> left_out(in.size());
+  std::vector<int> right_out(in.size());
+
+  auto leftData = ppc::test::make_data<int>({}, {left_out});
+  ppc::core::add_input(*leftData, in.data(), {in.size()});
+  auto rightData = ppc::test::make_data<int>({}, {right_out});
+  ppc::core::add_input(*rightData, in.data(), {in.size()});
+
+  ppc::test::ProbeCounter counter;
+  ppc::core::TaskGraph graph;
+  graph.add(std::make_shared<ppc::test::ProbeTask>(leftData, counter));
+  graph.add(std::make_shared<ppc::test::ProbeTask>(rightData, counter));
+
+  ASSERT_TRUE(graph.run(2));
+  EXPECT_EQ(counter.max_in_flight.load(), 2);
+  EXPECT_EQ(left_out, in);
+  EXPECT_EQ(right_out, in);
+}
+
+TEST(graph_tests, check_stream) {
+  // Create data
+  const size_t num_items = 20;
+  std::vector<int> in(4);
+  std::vector<int> mid(in.size());
+  std::vector<int> doubled(in.size());
+  std::vector<int> out(in.size());
+  std::vector<std::vector<int>> results;
+
+  auto sourceData = ppc::test::make_data<int>({}, {mid});
+  ppc::core::add_input(*sourceData, in.data(), {in.size()});
+
+  ppc::test::ProbeCounter counter;
+  ppc::core::TaskGraph graph;
+  auto first = graph.add(std::make_shared<ppc::test::ProbeTask>(sourceData, counter));
+  auto second = graph.add(std::make_shared<ppc::test::ScaleTask<int>>(ppc::test::make_data<int>({}, {doubled}), 2));
+  auto third = graph.add(std::make_shared<ppc::test::ProbeTask>(ppc::test::make_data<int>({}, {out}), counter));
+  graph.connect(first, 0, second, 0);
+  graph.connect(second, 0, third, 0);
+
+  ASSERT_TRUE(graph.run_stream(
+      num_items,
+      [&](size_t item) {
+        for (size_t i = 0; i < in.size(); i++) {
+          in[i] = static_cast<int>(item + i);
+        }
+      },
+      [&](size_t) { results.push_back(out); }, 3));
+
+  ASSERT_EQ(results.size(), num_items);
+  for (size_t item = 0; item < num_items; item++) {
+    for (size_t i = 0; i < in.size(); i++) {
+      EXPECT_EQ(results[item][i], static_cast<int>(2 * (item + i)));
+    }
+  }
+  // the first and the last stage worked on different items at the same time
+  EXPECT_EQ(counter.max_in_flight.load(), 2);
+}
+
+TEST(graph_tests, check_invalid_graphs) {
+  std::vector<int> a(1);
+  std::vector<int> b(1);
+
+  ppc::core::TaskGraph graph;
+  auto first = graph.add(std::make_shared<ppc::test::ScaleTask<int>>(ppc::test::make_data<int>({}, {a}), 1));
+  auto second = graph.add(std::make_shared<ppc::test::ScaleTask<int>>(ppc::test::make_data<int>({}, {b}), 1));
+  EXPECT_THROW(graph.connect(first, 0, first, 0), std::invalid_argument);
+  EXPECT_THROW(graph.connect(first, 0, 5, 0), std::out_of_range);
+  EXPECT_THROW(graph.add(nullptr), std::invalid_argument);
+
+  graph.connect(first, 0, second, 0);
+  EXPECT_THROW(graph.connect(first, 0, second, 0), std::invalid_argument);
+  graph.connect(second, 0, first, 0);
+  EXPECT_THROW(static_cast<void>(graph.topological_order()), std::invalid_argument);
+  EXPECT_THROW(graph.run(), std::invalid_argument);
+}
+
+TEST(graph_tests, check_failures) {
+  std::vector<int> in(4, 1);
+  std::vector<int> mid(in.size());
+  std::vector<int> out(in.size() + 1);
+
+  auto sourceData = ppc::test::make_data<int>({}, {mid});
+  ppc::core::add_input(*sourceData, in.data(), {in.size()});
+
+  // validation of the second task fails on mismatched sizes
+  ppc::core::TaskGraph graph;
+  auto source = graph.add(std::make_shared<ppc::test::ScaleTask<int>>(sourceData, 1));
+  auto sink = graph.add(std::make_shared<ppc::test::ScaleTask<int>>(ppc::test::make_data<int>({}, {out}), 1));
+  graph.connect(source, 0, sink, 0);
+  EXPECT_FALSE(graph.run(2));
+
+  // exceptions reach the caller
+  auto throwingData = ppc::test::make_data<int>({}, {mid});
+  ppc::core::add_input(*throwingData, in.data(), {in.size()});
+  ppc::core::TaskGraph throwing;
+  throwing.add(std::make_shared<ppc::test::ThrowingTask>(throwingData));
+  EXPECT_THROW(throwing.run(2), std::runtime_error);
+
+  // a missing producer output is reported when the graph is bound
+  ppc::core::TaskGraph unbound;
+  auto producer = unbound.add(std::make_shared<ppc::test::ScaleTask<int>>(sourceData, 1));
+  auto consumer = unbound.add(std::make_shared<ppc::test::ScaleTask<int>>(ppc::test::make_data<int>({}, {out}), 1));
+  unbound.connect(producer, 1, consumer, 0);
+  EXPECT_THROW(unbound.run(), std::out_of_range);
+}
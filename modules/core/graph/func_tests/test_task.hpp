@@ -0,0 +1,131 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_TESTS_GRAPH_TEST_TASK_HPP_
+#define MODULES_CORE_TESTS_GRAPH_TEST_TASK_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "core/task/include/data_view.hpp"
+#include "core/task/include/task.hpp"
+
+namespace ppc::test {
+
+// output[i] = factor * input[i]
+template <class T>
+class ScaleTask : public ppc::core::Task {
+ public:
+  ScaleTask(std::shared_ptr<ppc::core::TaskData> taskData_, T factor_) : Task(std::move(taskData_)), factor(factor_) {}
+
+  bool validation() override {
+    internal_order_test();
+    return taskData->inputs.size() == 1 && taskData->outputs.size() == 1 &&
+           taskData->inputs_count[0] == taskData->outputs_count[0];
+  }
+
+  bool pre_processing() override {
+    internal_order_test();
+    return true;
+  }
+
+  bool run() override {
+    internal_order_test();
+    auto input = ppc::core::input_view<T>(*taskData, 0);
+    auto output = ppc::core::output_view<T>(*taskData, 0);
+    for (size_t i = 0; i < input.size(); i++) {
+      output[i] = factor * input[i];
+    }
+    return true;
+  }
+
+  bool post_processing() override {
+    internal_order_test();
+    return true;
+  }
+
+ private:
+  T factor;
+};
+
+// output[i] = input0[i] + input1[i]
+template <class T>
+class AddTask : public ppc::core::Task {
+ public:
+  explicit AddTask(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+
+  bool validation() override {
+    internal_order_test();
+    return taskData->inputs.size() == 2 && taskData->outputs.size() == 1 &&
+           taskData->inputs_count[0] == taskData->outputs_count[0] &&
+           taskData->inputs_count[1] == taskData->outputs_count[0];
+  }
+
+  bool pre_processing() override {
+    internal_order_test();
+    return true;
+  }
+
+  bool run() override {
+    internal_order_test();
+    auto lhs = ppc::core::input_view<T>(*taskData, 0);
+    auto rhs = ppc::core::input_view<T>(*taskData, 1);
+    auto output = ppc::core::output_view<T>(*taskData, 0);
+    for (size_t i = 0; i < output.size(); i++) {
+      output[i] = lhs[i] + rhs[i];
+    }
+    return true;
+  }
+
+  bool post_processing() override {
+    internal_order_test();
+    return true;
+  }
+};
+
+// Records how many probes run at the same time. Each probe waits a little for
+// another one to join, so an overlap is observable on a single core too.
+struct ProbeCounter {
+  std::atomic<int> in_flight{0};
+  std::atomic<int> max_in_flight{0};
+};
+
+class ProbeTask : public ScaleTask<int> {
+ public:
+  ProbeTask(std::shared_ptr<ppc::core::TaskData> taskData_, ProbeCounter &counter_)
+      : ScaleTask<int>(std::move(taskData_), 1), counter(counter_) {}
+
+  bool run() override {
+    ++counter.in_flight;
+    // stop waiting once any probe has seen an overlap
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(100);
+    while (counter.max_in_flight.load() < 2 && std::chrono::steady_clock::now() < deadline) {
+      int now = counter.in_flight.load();
+      int seen = counter.max_in_flight.load();
+      while (now > seen && !counter.max_in_flight.compare_exchange_weak(seen, now)) {
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    bool result = ScaleTask<int>::run();
+    counter.in_flight--;
+    return result;
+  }
+
+ private:
+  ProbeCounter &counter;
+};
+
+class ThrowingTask : public ScaleTask<int> {
+ public:
+  explicit ThrowingTask(std::shared_ptr<ppc::core::TaskData> taskData_) : ScaleTask<int>(std::move(taskData_), 1) {}
+
+  bool run() override { throw std::runtime_error("task failed"); }
+};
+
+}  // namespace ppc::test
+
+#endif  // MODULES_CORE_TESTS_GRAPH_TEST_TASK_HPP_
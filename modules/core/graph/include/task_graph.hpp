@@ -0,0 +1,81 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_TASK_GRAPH_HPP_
+#define MODULES_CORE_INCLUDE_TASK_GRAPH_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/task/include/task.hpp"
+
+namespace ppc::core {
+
+// Directed acyclic graph of tasks. connect() makes an output buffer of one
+// task the input buffer of another, so the consumer reads the producer's
+// memory in place and no intermediate TaskData has to be allocated. Every
+// node runs its whole validation() -> post_processing() pipeline once per
+// item.
+class TaskGraph {
+ public:
+  using NodeId = std::size_t;
+  // receives the index of the item in a stream
+  using ItemCallback = std::function<void(std::size_t)>;
+
+  // the task keeps its own TaskData; inputs fed by connect() may be left empty
+  NodeId add(std::shared_ptr<Task> task, std::string name = "");
+
+  // outputs[output] of `from` becomes inputs[input] of `to`
+  void connect(NodeId from, std::size_t output, NodeId to, std::size_t input);
+
+  // Run every task once. A task starts as soon as all its producers have
+  // finished, so independent branches run concurrently on up to num_threads
+  // threads (0 - get_num_threads()). Returns false if a stage of some
+  // task returned false; an exception thrown by a task is rethrown after the
+  // running tasks have finished.
+  bool run(std::size_t num_threads = 0);
+
+  // Process num_items items as a pipeline: while a task works on item i its
+  // consumers may still work on item i - 1. There is a single buffer per
+  // edge, so a task starts the next item only after all its consumers are
+  // done with the previous one. feed(i) fills the inputs of the source tasks
+  // before they process item i, collect(i) reads the outputs of the sink
+  // tasks before they process item i + 1. Both callbacks may be empty.
+  bool run_stream(std::size_t num_items, const ItemCallback &feed, const ItemCallback &collect,
+                  std::size_t num_threads = 0);
+
+  // nodes in dependency order; throws std::invalid_argument on a cycle
+  [[nodiscard]] std::vector<NodeId> topological_order() const;
+
+  [[nodiscard]] std::size_t size() const { return nodes.size(); }
+  [[nodiscard]] const std::shared_ptr<Task> &task(NodeId id) const;
+  [[nodiscard]] const std::string &name(NodeId id) const;
+
+ private:
+  struct Node {
+    std::shared_ptr<Task> task;
+    std::string name;
+    std::vector<NodeId> predecessors;
+    std::vector<NodeId> successors;
+  };
+
+  struct Edge {
+    NodeId from;
+    std::size_t output;
+    NodeId to;
+    std::size_t input;
+  };
+
+  std::vector<Node> nodes;
+  std::vector<Edge> edges;
+
+  void check_node(NodeId id) const;
+  // point the consumer inputs at the producer outputs
+  void bind_edges();
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_TASK_GRAPH_HPP_
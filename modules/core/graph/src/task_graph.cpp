@@ -0,0 +1,231 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/graph/include/task_graph.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "core/perf/include/scaling.hpp"
+
+ppc::core::TaskGraph::NodeId ppc::core::TaskGraph::add(std::shared_ptr<Task> task, std::string name) {
+  if (!task) {
+    throw std::invalid_argument("Task graph node needs a task");
+  }
+  const NodeId id = nodes.size();
+  if (name.empty()) {
+    name = "task_" + std::to_string(id);
+  }
+  nodes.push_back({std::move(task), std::move(name), {}, {}});
+  return id;
+}
+
+void ppc::core::TaskGraph::connect(NodeId from, size_t output, NodeId to, size_t input) {
+  check_node(from);
+  check_node(to);
+  if (from == to) {
+    throw std::invalid_argument("Task " + nodes[from].name + " cannot consume its own output");
+  }
+  for (const auto &edge : edges) {
+    if (edge.to == to && edge.input == input) {
+      throw std::invalid_argument("Input " + std::to_string(input) + " of task " + nodes[to].name +
+                                  " is already connected");
+    }
+  }
+  edges.push_back({from, output, to, input});
+  auto &successors = nodes[from].successors;
+  if (std::find(successors.begin(), successors.end(), to) == successors.end()) {
+    successors.push_back(to);
+    nodes[to].predecessors.push_back(from);
+  }
+}
+
+std::vector<ppc::core::TaskGraph::NodeId> ppc::core::TaskGraph::topological_order() const {
+  std::vector<size_t> in_degree(nodes.size());
+  std::vector<NodeId> order;
+  order.reserve(nodes.size());
+  for (NodeId id = 0; id < nodes.size(); id++) {
+    in_degree[id] = nodes[id].predecessors.size();
+    if (in_degree[id] == 0) {
+      order.push_back(id);
+    }
+  }
+  for (size_t i = 0; i < order.size(); i++) {
+    for (auto next : nodes[order[i]].successors) {
+      if (--in_degree[next] == 0) {
+        order.push_back(next);
+      }
+    }
+  }
+  if (order.size() != nodes.size()) {
+    throw std::invalid_argument("Task graph has a cycle");
+  }
+  return order;
+}
+
+const std::shared_ptr<ppc::core::Task> &ppc::core::TaskGraph::task(NodeId id) const {
+  check_node(id);
+  return nodes[id].task;
+}
+
+const std::string &ppc::core::TaskGraph::name(NodeId id) const {
+  check_node(id);
+  return nodes[id].name;
+}
+
+void ppc::core::TaskGraph::check_node(NodeId id) const {
+  if (id >= nodes.size()) {
+    throw std::out_of_range("Task graph has no node " + std::to_string(id));
+  }
+}
+
+void ppc::core::TaskGraph::bind_edges() {
+  for (const auto &edge : edges) {
+    auto src = nodes[edge.from].task->get_data();
+    auto dst = nodes[edge.to].task->get_data();
+    if (edge.output >= src->outputs.size() || edge.output >= src->outputs_count.size()) {
+      throw std::out_of_range("Task " + nodes[edge.from].name + " has no output " + std::to_string(edge.output));
+    }
+    if (edge.input >= dst->inputs.size() || edge.input >= dst->inputs_count.size()) {
+      dst->inputs.resize(std::max(dst->inputs.size(), edge.input + 1));
+      dst->inputs_count.resize(std::max(dst->inputs_count.size(), edge.input + 1));
+    }
+    dst->inputs[edge.input] = src->outputs[edge.output];
+    dst->inputs_count[edge.input] = src->outputs_count[edge.output];
+
+    const bool described = edge.output < src->outputs_desc.size() && src->outputs_desc[edge.output].is_described();
+    if (described || edge.input < dst->inputs_desc.size()) {
+      dst->inputs_desc.resize(std::max(dst->inputs_desc.size(), edge.input + 1));
+      dst->inputs_desc[edge.input] = described ? src->outputs_desc[edge.output] : BufferDesc{};
+    }
+  }
+}
+
+bool ppc::core::TaskGraph::run(size_t num_threads) { return run_stream(1, nullptr, nullptr, num_threads); }
+
+bool ppc::core::TaskGraph::run_stream(size_t num_items, const ItemCallback &feed, const ItemCallback &collect,
+                                      size_t num_threads) {
+  // rejects cycles
+  static_cast<void>(topological_order());
+  bind_edges();
+  for (auto &node : nodes) {
+    node.task->reset();
+  }
+  if (num_items == 0 || nodes.empty()) {
+    return true;
+  }
+
+  // feed and collect are scheduled as two extra nodes in front of the
+  // sources and behind the sinks
+  const NodeId feed_id = nodes.size();
+  const NodeId collect_id = nodes.size() + 1;
+  std::vector<std::vector<NodeId>> predecessors(nodes.size() + 2);
+  std::vector<std::vector<NodeId>> successors(nodes.size() + 2);
+  for (NodeId id = 0; id < nodes.size(); id++) {
+    predecessors[id] = nodes[id].predecessors;
+    successors[id] = nodes[id].successors;
+    if (predecessors[id].empty()) {
+      predecessors[id].push_back(feed_id);
+      successors[feed_id].push_back(id);
+    }
+    if (successors[id].empty()) {
+      successors[id].push_back(collect_id);
+      predecessors[collect_id].push_back(id);
+    }
+  }
+
+  // done[id] - number of items the node has finished
+  std::vector<size_t> done(nodes.size() + 2, 0);
+  std::vector<bool> running(nodes.size() + 2, false);
+  size_t active = 0;
+  bool failed = false;
+  std::exception_ptr error;
+  std::mutex mutex;
+  std::condition_variable changed;
+
+  // the next item of a node may start when its producers have finished that
+  // item and its consumers have released the buffers of the previous one
+  auto is_ready = [&](NodeId id) {
+    if (running[id] || done[id] == num_items) {
+      return false;
+    }
+    return std::all_of(predecessors[id].begin(), predecessors[id].end(),
+                       [&](NodeId p) { return done[p] > done[id]; }) &&
+           std::all_of(successors[id].begin(), successors[id].end(), [&](NodeId s) { return done[s] >= done[id]; });
+  };
+
+  auto execute = [&](NodeId id, size_t item) {
+    if (id == feed_id || id == collect_id) {
+      const auto &callback = id == feed_id ? feed : collect;
+      if (callback) {
+        callback(item);
+      }
+      return true;
+    }
+    auto &task = *nodes[id].task;
+    return task.validation() && task.pre_processing() && task.run() && task.post_processing();
+  };
+
+  auto worker = [&]() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!failed && done[collect_id] < num_items) {
+      NodeId id = 0;
+      while (id < done.size() && !is_ready(id)) {
+        id++;
+      }
+      if (id == done.size()) {
+        if (active == 0) {
+          break;
+        }
+        changed.wait(lock);
+        continue;
+      }
+      running[id] = true;
+      active++;
+      const size_t item = done[id];
+      lock.unlock();
+
+      bool ok = false;
+      std::exception_ptr thrown;
+      try {
+        ok = execute(id, item);
+      } catch (...) {
+        thrown = std::current_exception();
+      }
+
+      lock.lock();
+      running[id] = false;
+      active--;
+      done[id]++;
+      if (!ok) {
+        failed = true;
+        if (thrown && !error) {
+          error = thrown;
+        }
+      }
+      changed.notify_all();
+    }
+  };
+
+  if (num_threads == 0) {
+    num_threads = static_cast<std::size_t>(get_num_threads());
+  }
+  num_threads = std::min(num_threads, nodes.size() + 2);
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads - 1);
+  for (size_t i = 1; i < num_threads; i++) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+  return !failed;
+}
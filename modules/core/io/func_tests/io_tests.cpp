@@ -0,0 +1,109 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "core/io/include/mapped_file.hpp"
+#include "core/task/include/data_view.hpp"
+
+namespace {
+
+std::string write_file(const std::string &name, const std::string &contents) {
+  auto path = (std::filesystem::temp_directory_path() / name).string();
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  out << contents;
+  return path;
+}
+
+}  // namespace
+
+TEST(io_tests, check_raw_matrix) {
+  std::vector<double> matrix(6);
+  std::iota(matrix.begin(), matrix.end(), 1.0);
+  auto path = write_file("ppc_io_matrix.bin",
+                         std::string(reinterpret_cast<const char *>(matrix.data()), matrix.size() * sizeof(double)));
+  {
+    ppc::core::MappedFile file(path);
+    EXPECT_EQ(file.size(), matrix.size() * sizeof(double));
+    file.advise(ppc::core::MappedFile::Access::SEQUENTIAL);
+
+    auto taskData = std::make_shared<ppc::core::TaskData>();
+    ppc::core::add_mapped_input<double>(*taskData, file, {2, 3});
+    EXPECT_EQ(taskData->inputs_count[0], 6U);
+    auto view = ppc::core::input_matrix_view<double>(*taskData, 0);
+    EXPECT_EQ(view.rows(), 2U);
+    EXPECT_DOUBLE_EQ(view(1, 2), 6.0);
+
+    // copy-on-write: the task may modify its input, the file stays intact
+    ppc::core::input_view<double>(*taskData, 0)[0] = -1.0;
+    EXPECT_THROW(ppc::core::add_mapped_input<double>(*taskData, file, {2, 2}), std::invalid_argument);
+    EXPECT_THROW(ppc::core::add_mapped_input<double>(*taskData, file, {5}, 4), std::invalid_argument);
+
+    // the mapping moves with the object
+    auto *data = file.data();
+    ppc::core::MappedFile moved(std::move(file));
+    EXPECT_EQ(moved.data(), data);
+    EXPECT_EQ(moved.size(), matrix.size() * sizeof(double));
+  }
+  ppc::core::MappedFile again(path);
+  EXPECT_DOUBLE_EQ(reinterpret_cast<const double *>(again.data())[0], 1.0);
+  std::filesystem::remove(path);
+
+  EXPECT_THROW(ppc::core::MappedFile((std::filesystem::temp_directory_path() / "ppc_io_missing").string()),
+               std::runtime_error);
+}
+
+TEST(io_tests, check_pnm_images) {
+  auto ppm = write_file("ppc_io_image.ppm", std::string("P6\n# made by hand\n2 1\n255\n") + "\x01\x02\x03\x04\x05\x06");
+  {
+    ppc::core::MappedFile file(ppm);
+    auto taskData = std::make_shared<ppc::core::TaskData>();
+    auto image = ppc::core::add_image_input(*taskData, file);
+    EXPECT_EQ(image.width, 2U);
+    EXPECT_EQ(image.height, 1U);
+    EXPECT_EQ(image.channels, 3U);
+    auto view = ppc::core::input_matrix_view<uint8_t>(*taskData, 0);
+    EXPECT_EQ(view.cols(), 6U);
+    EXPECT_EQ(view(0, 5), 6);
+  }
+  std::filesystem::remove(ppm);
+
+  auto pgm = write_file("ppc_io_image.pgm", std::string("P5 3 2 200 ") + "abcdef");
+  {
+    ppc::core::MappedFile file(pgm);
+    auto image = ppc::core::parse_pnm(file);
+    EXPECT_EQ(image.channels, 1U);
+    EXPECT_EQ(image.max_value, 200U);
+    EXPECT_EQ(file.data()[image.offset], 'a');
+  }
+  std::filesystem::remove(pgm);
+
+  for (const auto *contents : {"P3\n1 1\n255\n1 2 3\n", "P5\n2 2\n65535\n", "P5\n4 4\n255\nabc"}) {
+    auto path = write_file("ppc_io_bad.pnm", contents);
+    ppc::core::MappedFile file(path);
+    EXPECT_THROW(static_cast<void>(ppc::core::parse_pnm(file)), std::invalid_argument);
+    std::filesystem::remove(path);
+  }
+}
+
+TEST(io_tests, check_text_corpus) {
+  auto path = write_file("ppc_io_corpus.txt", "the quick brown fox\njumps over\n");
+  ppc::core::MappedFile file(path);
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  ppc::core::add_text_input(*taskData, file);
+  auto text = ppc::core::input_view<char>(*taskData, 0);
+  EXPECT_EQ(std::string(text.begin(), text.end()), "the quick brown fox\njumps over\n");
+  std::filesystem::remove(path);
+
+  auto empty = write_file("ppc_io_empty.txt", "");
+  ppc::core::MappedFile empty_file(empty);
+  EXPECT_EQ(empty_file.size(), 0U);
+  EXPECT_EQ(empty_file.data(), nullptr);
+  std::filesystem::remove(empty);
+}
@@ -0,0 +1,97 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_MAPPED_FILE_HPP_
+#define MODULES_CORE_INCLUDE_MAPPED_FILE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/task/include/data_view.hpp"
+#include "core/task/include/task.hpp"
+
+namespace ppc::core {
+
+// Read-only input file mapped into memory. Pages are loaded lazily on first
+// access, so a multi-gigabyte input costs nothing until a task reads it. The
+// mapping is private: a task writing into its input gets copy-on-write pages
+// and the file is never modified. Where mmap is unavailable the file is read
+// into memory instead.
+//
+// TaskData only keeps pointers, so the MappedFile must outlive the tasks
+// using it.
+class MappedFile {
+ public:
+  enum class Access : uint8_t { NORMAL, SEQUENTIAL, RANDOM, WILL_NEED };
+
+  // throws std::runtime_error if the file cannot be opened or mapped
+  explicit MappedFile(const std::string& path_);
+  ~MappedFile();
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile& operator=(MappedFile&& other) noexcept;
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  // nullptr for an empty file
+  [[nodiscard]] uint8_t* data() const { return data_; }
+  [[nodiscard]] std::size_t size() const { return size_; }
+  [[nodiscard]] const std::string& path() const { return path_; }
+  // false if the file was read into memory instead
+  [[nodiscard]] bool is_mapped() const { return mapped; }
+
+  // expected access pattern, a hint for read-ahead; ignored where unsupported
+  void advise(Access access) const;
+
+ private:
+  void release();
+
+  std::string path_;
+  uint8_t* data_ = nullptr;
+  std::size_t size_ = 0;
+  bool mapped = false;
+  std::vector<uint8_t> fallback;
+};
+
+// Add the raw binary array of T with the given shape (row-major, native byte
+// order) starting at byte offset of file as an input. Throws
+// std::invalid_argument if the file does not hold exactly that many elements
+// after offset or offset is misaligned for T.
+template <class T>
+void add_mapped_input(TaskData& taskData, const MappedFile& file, std::vector<size_t> shape, size_t offset = 0) {
+  auto count = std::accumulate(shape.begin(), shape.end(), size_t{1}, std::multiplies<>());
+  if (offset > file.size() || (file.size() - offset) != count * sizeof(T) || offset % alignof(T) != 0) {
+    throw std::invalid_argument(file.path() + " does not hold " + std::to_string(count) + " elements of " +
+                                std::to_string(sizeof(T)) + " bytes at offset " + std::to_string(offset));
+  }
+  add_input(taskData, reinterpret_cast<T*>(file.data() + offset), std::move(shape));
+}
+
+// Header of a binary PGM (P5, channels 1) or PPM (P6, channels 3) image
+struct PnmImage {
+  size_t width = 0;
+  size_t height = 0;
+  size_t channels = 1;
+  size_t max_value = 255;
+  // byte offset of the pixels in the file
+  size_t offset = 0;
+};
+
+// throws std::invalid_argument for anything but 8-bit binary PGM/PPM (plain
+// P2/P3 text images cannot be used in place)
+PnmImage parse_pnm(const MappedFile& file);
+
+// Add the pixels of a binary PGM/PPM as a uint8_t input of shape
+// {height, width * channels}
+PnmImage add_image_input(TaskData& taskData, const MappedFile& file);
+
+// Add the whole file as a char input of shape {size}, e.g. a text corpus
+void add_text_input(TaskData& taskData, const MappedFile& file);
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_MAPPED_FILE_HPP_
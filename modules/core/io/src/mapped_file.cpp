@@ -0,0 +1,161 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/io/include/mapped_file.hpp"
+
+#include <cctype>
+#include <fstream>
+#include <iterator>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define PPC_HAS_MMAP 1
+#endif
+
+ppc::core::MappedFile::MappedFile(const std::string& path_) : path_(path_) {
+#ifdef PPC_HAS_MMAP
+  int fd = ::open(path_.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Cannot open file: " + path_);
+  }
+  struct stat info {};
+  if (::fstat(fd, &info) != 0) {
+    ::close(fd);
+    throw std::runtime_error("Cannot stat file: " + path_);
+  }
+  size_ = static_cast<std::size_t>(info.st_size);
+  if (size_ > 0) {
+    // private and writable: stores into the input are copy-on-write
+    void* address = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    if (address == MAP_FAILED) {
+      ::close(fd);
+      throw std::runtime_error("Cannot map file: " + path_);
+    }
+    data_ = static_cast<uint8_t*>(address);
+    mapped = true;
+  }
+  ::close(fd);
+#else
+  std::ifstream in(path_, std::ios::binary);
+  if (!in.is_open()) {
+    throw std::runtime_error("Cannot open file: " + path_);
+  }
+  fallback.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  size_ = fallback.size();
+  data_ = fallback.empty() ? nullptr : fallback.data();
+#endif
+}
+
+ppc::core::MappedFile::~MappedFile() { release(); }
+
+ppc::core::MappedFile::MappedFile(MappedFile&& other) noexcept
+    : path_(std::move(other.path_)),
+      data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)),
+      mapped(std::exchange(other.mapped, false)),
+      fallback(std::move(other.fallback)) {}
+
+ppc::core::MappedFile& ppc::core::MappedFile::operator=(MappedFile&& other) noexcept {
+  if (this != &other) {
+    release();
+    path_ = std::move(other.path_);
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    mapped = std::exchange(other.mapped, false);
+    fallback = std::move(other.fallback);
+  }
+  return *this;
+}
+
+void ppc::core::MappedFile::release() {
+#ifdef PPC_HAS_MMAP
+  if (mapped) {
+    ::munmap(data_, size_);
+  }
+#endif
+  data_ = nullptr;
+  size_ = 0;
+  mapped = false;
+  fallback.clear();
+}
+
+void ppc::core::MappedFile::advise(Access access) const {
+#ifdef PPC_HAS_MMAP
+  if (!mapped) {
+    return;
+  }
+  int advice = POSIX_MADV_NORMAL;
+  if (access == Access::SEQUENTIAL) {
+    advice = POSIX_MADV_SEQUENTIAL;
+  } else if (access == Access::RANDOM) {
+    advice = POSIX_MADV_RANDOM;
+  } else if (access == Access::WILL_NEED) {
+    advice = POSIX_MADV_WILLNEED;
+  }
+  ::posix_madvise(data_, size_, advice);
+#else
+  static_cast<void>(access);
+#endif
+}
+
+ppc::core::PnmImage ppc::core::parse_pnm(const MappedFile& file) {
+  const auto* bytes = file.data();
+  auto size = file.size();
+  auto fail = [&](const std::string& reason) {
+    return std::invalid_argument(file.path() + " is not a binary PGM/PPM image: " + reason);
+  };
+  if (size < 2 || bytes[0] != 'P' || (bytes[1] != '5' && bytes[1] != '6')) {
+    throw fail("expected magic P5 or P6");
+  }
+
+  // width, height and max value separated by whitespace and # comments
+  size_t pos = 2;
+  auto read_number = [&]() {
+    while (pos < size && (std::isspace(bytes[pos]) != 0 || bytes[pos] == '#')) {
+      if (bytes[pos] == '#') {
+        while (pos < size && bytes[pos] != '\n') {
+          pos++;
+        }
+      } else {
+        pos++;
+      }
+    }
+    if (pos >= size || std::isdigit(bytes[pos]) == 0) {
+      throw fail("malformed header");
+    }
+    size_t value = 0;
+    while (pos < size && std::isdigit(bytes[pos]) != 0) {
+      value = value * 10 + (bytes[pos++] - '0');
+    }
+    return value;
+  };
+
+  PnmImage image;
+  image.channels = bytes[1] == '6' ? 3 : 1;
+  image.width = read_number();
+  image.height = read_number();
+  image.max_value = read_number();
+  if (image.max_value == 0 || image.max_value > 255) {
+    throw fail("only 8-bit images are supported, max value " + std::to_string(image.max_value));
+  }
+  // exactly one whitespace character ends the header
+  if (pos >= size || std::isspace(bytes[pos]) == 0) {
+    throw fail("malformed header");
+  }
+  image.offset = pos + 1;
+  if (size - image.offset < image.width * image.height * image.channels) {
+    throw fail("truncated pixel data");
+  }
+  return image;
+}
+
+ppc::core::PnmImage ppc::core::add_image_input(TaskData& taskData, const MappedFile& file) {
+  auto image = parse_pnm(file);
+  add_input(taskData, file.data() + image.offset, {image.height, image.width * image.channels});
+  return image;
+}
+
+void ppc::core::add_text_input(TaskData& taskData, const MappedFile& file) {
+  add_input(taskData, reinterpret_cast<char*>(file.data()), {file.size()});
+}
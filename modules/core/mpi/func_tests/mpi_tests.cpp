@@ -0,0 +1,152 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <boost/mpi/communicator.hpp>
+#include <boost/mpi/environment.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <regex>
+#include <set>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "core/mpi/include/batch_mpi.hpp"
+#include "core/mpi/include/stream_mpi.hpp"
+#include "core/mpi/include/trace_mpi.hpp"
+#include "core/task/func_tests/test_task.hpp"
+
+TEST(mpi_tests, check_batch) {
+  boost::mpi::communicator world;
+  // every rank holds the whole batch: instance i sums i + 1 values equal to i
+  const size_t num_instances = 25;
+  std::vector<std::vector<int>> inputs(num_instances);
+  std::vector<int> sums(num_instances, 0);
+  std::vector<std::span<int>> outputs;
+  for (size_t i = 0; i < num_instances; i++) {
+    inputs[i].assign(i + 1, static_cast<int>(i));
+    outputs.emplace_back(&sums[i], 1);
+  }
+  auto batch = ppc::test::make_data<int>({inputs.begin(), inputs.end()}, outputs);
+
+  ppc::core::BatchRunner runner(
+      [](std::shared_ptr<ppc::core::TaskData> taskData) {
+        return std::make_shared<ppc::test::TestTask<int>>(taskData);
+      },
+      {1, 1}, 2);
+  ASSERT_TRUE(ppc::core::run_batch(world, runner, *batch));
+
+  if (world.rank() == 0) {
+    for (size_t i = 0; i < num_instances; i++) {
+      ASSERT_EQ(sums[i], static_cast<int>(i * (i + 1)));
+    }
+  }
+}
+
+TEST(mpi_tests, check_stream_file) {
+  boost::mpi::communicator world;
+  // root writes 1..count; every rank streams its own part of the file
+  const int64_t count = 1000;
+  auto path = (std::filesystem::temp_directory_path() / "ppc_mpi_stream_test.bin").string();
+  if (world.rank() == 0) {
+    std::vector<int64_t> values(count);
+    std::iota(values.begin(), values.end(), 1);
+    std::ofstream out(path, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(count * sizeof(int64_t)));
+  }
+  world.barrier();
+
+  auto sum = ppc::core::reduce_file(
+      world, path, 128, sizeof(int64_t), 2, int64_t{0},
+      [](int64_t& total, const ppc::core::Chunk& chunk) {
+        for (auto value : chunk.as<int64_t>()) {
+          total += value;
+        }
+      },
+      [](int64_t left, int64_t right) { return left + right; });
+  world.barrier();
+
+  if (world.rank() == 0) {
+    std::filesystem::remove(path);
+    ASSERT_EQ(sum, count * (count + 1) / 2);
+  }
+}
+
+TEST(mpi_tests, check_trace_messages) {
+  boost::mpi::communicator world;
+  if (ppc::core::tracing_enabled()) {
+    GTEST_SKIP() << "PPC_TRACE records the whole run";
+  }
+  auto& recorder = ppc::core::TraceRecorder::global();
+  recorder.enable();
+
+  // a token passed once around the ring of ranks
+  int token = 0;
+  const int next = (world.rank() + 1) % world.size();
+  const int prev = (world.rank() + world.size() - 1) % world.size();
+  if (world.size() > 1) {
+    ppc::core::TraceScope scope("ring");
+    if (world.rank() != 0) {
+      ppc::core::traced_recv(world, prev, 7, token);
+      token++;
+    }
+    ppc::core::traced_send(world, next, 7, token);
+    if (world.rank() == 0) {
+      ppc::core::traced_recv(world, MPI_ANY_SOURCE, 7, token);
+    }
+  }
+
+  auto path = (std::filesystem::temp_directory_path() / "ppc_trace_test.json").string();
+  ppc::core::write_trace(world, path);
+  recorder.disable();
+
+  const int messages = world.size() > 1 ? world.size() : 0;
+  auto events = recorder.events();
+  auto sends = std::count_if(events.begin(), events.end(), [](const ppc::core::TraceEvent& event) {
+    return event.kind == ppc::core::TraceEvent::Kind::SEND;
+  });
+  EXPECT_EQ(sends, messages > 0 ? 1 : 0);
+
+  if (world.rank() == 0) {
+    std::ifstream in(path);
+    std::string trace((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(token, world.size() - 1);
+    for (int rank = 0; rank < world.size(); rank++) {
+      EXPECT_NE(trace.find("\"rank " + std::to_string(rank) + "\""), std::string::npos);
+    }
+
+    // every send is joined to its receive on the other rank
+    auto ids = [&](const std::regex& pattern) {
+      std::multiset<std::string> found;
+      for (std::sregex_iterator it(trace.begin(), trace.end(), pattern), end; it != end; ++it) {
+        found.insert((*it)[1]);
+      }
+      return found;
+    };
+    auto starts = ids(std::regex(R"re("ph":"s","id":(\d+))re"));
+    auto finishes = ids(std::regex(R"re("ph":"f","bp":"e","id":(\d+))re"));
+    EXPECT_EQ(starts.size(), static_cast<size_t>(messages));
+    EXPECT_EQ(starts, finishes);
+    std::filesystem::remove(path);
+  }
+}
+
+int main(int argc, char** argv) {
+  boost::mpi::environment env(argc, argv);
+  boost::mpi::communicator world;
+  // PPC_TRACE=<file> records a timeline of all ranks
+  auto trace = ppc::core::TraceRecorder::global().enable_from_env();
+  ::testing::InitGoogleTest(&argc, argv);
+  ::testing::TestEventListeners& listeners = ::testing::UnitTest::GetInstance()->listeners();
+  if (world.rank() != 0) {
+    delete listeners.Release(listeners.default_result_printer());
+  }
+  auto result = RUN_ALL_TESTS();
+  ppc::core::write_trace(world, trace);
+  return result;
+}
@@ -0,0 +1,90 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_BATCH_MPI_HPP_
+#define MODULES_CORE_INCLUDE_BATCH_MPI_HPP_
+
+#include <algorithm>
+#include <boost/mpi/collectives.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/batch/include/batch.hpp"
+#include "core/mpi/include/chunked_transfer.hpp"
+
+namespace ppc::core {
+
+// contiguous block of instances [first, second) handled by rank
+inline std::pair<std::size_t, std::size_t> batch_block(std::size_t size, int rank, int num_ranks) {
+  const auto ranks = static_cast<std::size_t>(num_ranks);
+  const auto r = static_cast<std::size_t>(rank);
+  return {size * r / ranks, size * (r + 1) / ranks};
+}
+
+namespace detail {
+
+// size in bytes of outputs[index]; needs the descriptor set by add_output()
+inline std::uint64_t output_bytes(const TaskData &batch, std::size_t index) {
+  if (index >= batch.outputs_desc.size() || !batch.outputs_desc[index].is_described()) {
+    throw std::invalid_argument("Batch output " + std::to_string(index) + " has no descriptor");
+  }
+  return batch.outputs_count[index] * batch.outputs_desc[index].elem_size;
+}
+
+}  // namespace detail
+
+// Run a batch on all ranks of world: every rank takes a contiguous block of
+// instances and runs it on its BatchRunner, then root receives the outputs
+// of all blocks in one message per rank. Instead of a broadcast per instance
+// the inputs of the whole batch must be present on every rank (broadcast
+// them once), and every rank needs output buffers of the same layout.
+// Collective; returns the same result on all ranks: false if any instance
+// failed on any rank.
+inline bool run_batch(const boost::mpi::communicator &world, BatchRunner &runner, const TaskData &batch,
+                      int root = 0) {
+  const auto &shape = runner.shape();
+  const std::size_t size = batch_size(batch, shape);
+  auto [begin, end] = batch_block(size, world.rank(), world.size());
+  bool ok = runner.run(batch, begin, end);
+
+  auto for_outputs = [&](int rank, const std::function<void(uint8_t *, std::uint64_t)> &visit) {
+    auto [first, last] = batch_block(size, rank, world.size());
+    for (std::size_t i = first * shape.outputs_per_instance; i < last * shape.outputs_per_instance; i++) {
+      visit(batch.outputs[i], detail::output_bytes(batch, i));
+    }
+  };
+  std::vector<uint8_t> packed;
+  if (world.rank() == root) {
+    for (int proc = 0; proc < world.size(); proc++) {
+      if (proc == root) {
+        continue;
+      }
+      std::uint64_t bytes = 0;
+      for_outputs(proc, [&](uint8_t *, std::uint64_t count) { bytes += count; });
+      packed.resize(bytes);
+      recv_chunked(world, proc, 0, packed.data(), bytes);
+      std::uint64_t offset = 0;
+      for_outputs(proc, [&](uint8_t *data, std::uint64_t count) {
+        std::copy(packed.begin() + static_cast<std::ptrdiff_t>(offset),
+                  packed.begin() + static_cast<std::ptrdiff_t>(offset + count), data);
+        offset += count;
+      });
+    }
+  } else {
+    for_outputs(world.rank(),
+                [&](uint8_t *data, std::uint64_t count) { packed.insert(packed.end(), data, data + count); });
+    send_chunked(world, root, 0, packed.data(), packed.size());
+  }
+
+  bool all_ok = false;
+  boost::mpi::all_reduce(world, ok, all_ok, std::logical_and<bool>());
+  return all_ok;
+}
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_BATCH_MPI_HPP_
@@ -0,0 +1,109 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_CHUNKED_TRANSFER_HPP_
+#define MODULES_CORE_INCLUDE_CHUNKED_TRANSFER_HPP_
+
+#include <algorithm>
+#include <boost/mpi/collectives.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ppc::core {
+
+// MPI takes element counts as int. These helpers split transfers with
+// 64-bit counts into pieces of at most max_chunk elements; the matching
+// call on the peer must use the same max_chunk. They throw
+// std::invalid_argument for a max_chunk of 0 or above kMaxMpiCount.
+constexpr std::uint64_t kMaxMpiCount = std::numeric_limits<int>::max();
+
+inline void check_max_chunk(std::uint64_t max_chunk) {
+  if (max_chunk == 0 || max_chunk > kMaxMpiCount) {
+    throw std::invalid_argument("Chunk size must be in [1, " + std::to_string(kMaxMpiCount) +
+                                "] elements: " + std::to_string(max_chunk));
+  }
+}
+
+// counts and displacements of total elements split over parts ranks, the
+// first total % parts ranks taking one element more
+inline void split_counts(std::uint64_t total, int parts, std::vector<std::uint64_t> &counts,
+                         std::vector<std::uint64_t> &displs) {
+  counts.assign(parts, total / parts);
+  displs.assign(parts, 0);
+  for (int i = 0; i < parts; i++) {
+    counts[i] += static_cast<std::uint64_t>(i) < total % parts ? 1 : 0;
+    displs[i] = i == 0 ? 0 : displs[i - 1] + counts[i - 1];
+  }
+}
+
+template <class T>
+void send_chunked(const boost::mpi::communicator &world, int dest, int tag, const T *values, std::uint64_t count,
+                  std::uint64_t max_chunk = kMaxMpiCount) {
+  check_max_chunk(max_chunk);
+  for (std::uint64_t offset = 0; offset < count; offset += max_chunk) {
+    world.send(dest, tag, values + offset, static_cast<int>(std::min(max_chunk, count - offset)));
+  }
+}
+
+template <class T>
+void recv_chunked(const boost::mpi::communicator &world, int source, int tag, T *values, std::uint64_t count,
+                  std::uint64_t max_chunk = kMaxMpiCount) {
+  check_max_chunk(max_chunk);
+  for (std::uint64_t offset = 0; offset < count; offset += max_chunk) {
+    world.recv(source, tag, values + offset, static_cast<int>(std::min(max_chunk, count - offset)));
+  }
+}
+
+template <class T>
+void broadcast_chunked(const boost::mpi::communicator &world, T *values, std::uint64_t count, int root,
+                       std::uint64_t max_chunk = kMaxMpiCount) {
+  check_max_chunk(max_chunk);
+  for (std::uint64_t offset = 0; offset < count; offset += max_chunk) {
+    boost::mpi::broadcast(world, values + offset, static_cast<int>(std::min(max_chunk, count - offset)), root);
+  }
+}
+
+// Scatter counts[i] elements starting at in + displs[i] to rank i. in is only
+// read on root; out must hold counts[world.rank()] elements on every rank.
+template <class T>
+void scatterv_chunked(const boost::mpi::communicator &world, const T *in, const std::vector<std::uint64_t> &counts,
+                      const std::vector<std::uint64_t> &displs, T *out, int root,
+                      std::uint64_t max_chunk = kMaxMpiCount) {
+  check_max_chunk(max_chunk);
+  if (world.rank() == root) {
+    for (int proc = 0; proc < world.size(); proc++) {
+      if (proc != root) {
+        send_chunked(world, proc, 0, in + displs[proc], counts[proc], max_chunk);
+      }
+    }
+    std::copy(in + displs[root], in + displs[root] + counts[root], out);
+  } else {
+    recv_chunked(world, root, 0, out, counts[world.rank()], max_chunk);
+  }
+}
+
+// Inverse of scatterv_chunked: rank i contributes counts[i] elements which
+// land at out + displs[i] on root
+template <class T>
+void gatherv_chunked(const boost::mpi::communicator &world, const T *in, const std::vector<std::uint64_t> &counts,
+                     const std::vector<std::uint64_t> &displs, T *out, int root,
+                     std::uint64_t max_chunk = kMaxMpiCount) {
+  check_max_chunk(max_chunk);
+  if (world.rank() == root) {
+    std::copy(in, in + counts[root], out + displs[root]);
+    for (int proc = 0; proc < world.size(); proc++) {
+      if (proc != root) {
+        recv_chunked(world, proc, 0, out + displs[proc], counts[proc], max_chunk);
+      }
+    }
+  } else {
+    send_chunked(world, root, 0, in, counts[world.rank()], max_chunk);
+  }
+}
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_CHUNKED_TRANSFER_HPP_
@@ -0,0 +1,26 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_DISPATCH_MPI_HPP_
+#define MODULES_CORE_INCLUDE_DISPATCH_MPI_HPP_
+
+#include <boost/mpi/collectives.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <cstdint>
+#include <functional>
+
+#include "core/dispatch/include/dispatcher.hpp"
+
+namespace ppc::core {
+
+// Hook for Dispatcher::set_size_agreement: the problem size of root, where
+// the inputs are, on every rank of world. Collective: all ranks must call it.
+inline std::function<uint64_t(uint64_t)> root_problem_size(const boost::mpi::communicator &world, int root = 0) {
+  return [world, root](uint64_t problem_size) {
+    boost::mpi::broadcast(world, problem_size, root);
+    return problem_size;
+  };
+}
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_DISPATCH_MPI_HPP_
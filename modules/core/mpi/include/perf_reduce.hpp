@@ -0,0 +1,55 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_PERF_REDUCE_HPP_
+#define MODULES_CORE_INCLUDE_PERF_REDUCE_HPP_
+
+#include <array>
+#include <boost/mpi/collectives.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <boost/mpi/operations.hpp>
+#include <functional>
+
+#include "core/perf/include/perf.hpp"
+
+namespace ppc::core {
+
+// Min/max/mean over the ranks of world of the whole measurement and of the
+// mean time per call of every stage. Collective: all ranks must call it.
+inline RankTimings reduce_rank_timings(const boost::mpi::communicator &world, const PerfResults &perfResults) {
+  constexpr int kValues = 1 + static_cast<int>(kNumTaskStages);
+  std::array<double, kValues> local{};
+  local[0] = perfResults.time_sec;
+  for (size_t i = 0; i < kNumTaskStages; i++) {
+    local[i + 1] = perfResults.stage_timings.mean(static_cast<TaskStage>(i));
+  }
+
+  std::array<double, kValues> min{};
+  std::array<double, kValues> max{};
+  std::array<double, kValues> sum{};
+  boost::mpi::all_reduce(world, local.data(), kValues, min.data(), boost::mpi::minimum<double>());
+  boost::mpi::all_reduce(world, local.data(), kValues, max.data(), boost::mpi::maximum<double>());
+  boost::mpi::all_reduce(world, local.data(), kValues, sum.data(), std::plus<double>());
+
+  auto spread = [&](int i) { return RankSpread{min[i], max[i], sum[i] / world.size()}; };
+  RankTimings timings;
+  timings.num_ranks = world.size();
+  timings.total = spread(0);
+  for (size_t i = 0; i < kNumTaskStages; i++) {
+    timings.stages[i] = spread(static_cast<int>(i) + 1);
+  }
+  return timings;
+}
+
+// Hook for PerfAttr::reduce_across_ranks
+inline std::function<RankTimings(const PerfResults &)> rank_reducer(const boost::mpi::communicator &world) {
+  return [world](const PerfResults &perfResults) { return reduce_rank_timings(world, perfResults); };
+}
+
+// Hook for PerfAttr::max_across_ranks
+inline std::function<double(double)> rank_max(const boost::mpi::communicator &world) {
+  return [world](double value) { return boost::mpi::all_reduce(world, value, boost::mpi::maximum<double>()); };
+}
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_PERF_REDUCE_HPP_
@@ -0,0 +1,54 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_STREAM_MPI_HPP_
+#define MODULES_CORE_INCLUDE_STREAM_MPI_HPP_
+
+#include <boost/mpi/collectives.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/stream/include/stream.hpp"
+
+namespace ppc::core {
+
+// byte range [first, second) of a stream of size bytes read by rank;
+// boundaries fall between elements of element_size bytes
+inline std::pair<std::uint64_t, std::uint64_t> stream_block(std::uint64_t size, std::size_t element_size, int rank,
+                                                            int num_ranks) {
+  const std::uint64_t elements = size / element_size;
+  const auto ranks = static_cast<std::uint64_t>(num_ranks);
+  const auto r = static_cast<std::uint64_t>(rank);
+  return {elements * r / ranks * element_size, elements * (r + 1) / ranks * element_size};
+}
+
+// Reduce a file on all ranks of world without loading it on root: every rank
+// streams its own contiguous block in chunks of chunk_bytes with num_workers
+// threads (see reduce_stream()), then root merges the per-rank states in rank
+// order, so merge sees adjacent pieces as in the single-process reduction.
+// State must be serializable by Boost. Collective; the result is valid on
+// root only.
+template <class State, class Consume, class Merge>
+State reduce_file(const boost::mpi::communicator &world, const std::string &path, std::size_t chunk_bytes,
+                  std::size_t element_size, std::size_t num_workers, const State &init, Consume consume, Merge merge,
+                  int root = 0) {
+  auto [begin, end] = stream_block(std::filesystem::file_size(path), element_size, world.rank(), world.size());
+  ChunkReader reader(std::make_shared<FileSource>(path, begin, end), chunk_bytes, element_size);
+  State local = reduce_stream(reader, num_workers, init, consume, merge);
+
+  std::vector<State> states;
+  boost::mpi::gather(world, local, states, root);
+  State total = init;
+  for (auto &state : states) {
+    total = merge(std::move(total), std::move(state));
+  }
+  return total;
+}
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_STREAM_MPI_HPP_
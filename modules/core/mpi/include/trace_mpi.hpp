@@ -0,0 +1,109 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_TRACE_MPI_HPP_
+#define MODULES_CORE_INCLUDE_TRACE_MPI_HPP_
+
+#include <boost/mpi/collectives.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <boost/mpi/status.hpp>
+#include <boost/serialization/string.hpp>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "core/trace/include/trace.hpp"
+
+namespace ppc::core {
+
+// payload of n values as recorded, 0 for types Boost serializes
+template <class T>
+uint64_t trace_bytes(int n) {
+  return std::is_trivially_copyable_v<T> ? static_cast<uint64_t>(n) * sizeof(T) : 0;
+}
+
+// world.send()/world.recv() recorded on the trace timeline with the peer, the
+// tag and the payload. A receive from MPI_ANY_SOURCE or with MPI_ANY_TAG is
+// recorded with what arrived. While tracing is off they cost one flag check.
+template <class T>
+void traced_send(const boost::mpi::communicator &world, int dest, int tag, const T *values, int n) {
+  if (!tracing_enabled()) {
+    world.send(dest, tag, values, n);
+    return;
+  }
+  auto start = TraceRecorder::global().now_ns();
+  world.send(dest, tag, values, n);
+  trace_message(TraceEvent::Kind::SEND, dest, tag, trace_bytes<T>(n), start);
+}
+
+template <class T>
+void traced_send(const boost::mpi::communicator &world, int dest, int tag, const T &value) {
+  if (!tracing_enabled()) {
+    world.send(dest, tag, value);
+    return;
+  }
+  auto start = TraceRecorder::global().now_ns();
+  world.send(dest, tag, value);
+  trace_message(TraceEvent::Kind::SEND, dest, tag, trace_bytes<T>(1), start);
+}
+
+template <class T>
+boost::mpi::status traced_recv(const boost::mpi::communicator &world, int source, int tag, T *values, int n) {
+  if (!tracing_enabled()) {
+    return world.recv(source, tag, values, n);
+  }
+  auto start = TraceRecorder::global().now_ns();
+  auto status = world.recv(source, tag, values, n);
+  trace_message(TraceEvent::Kind::RECV, status.source(), status.tag(), trace_bytes<T>(n), start);
+  return status;
+}
+
+template <class T>
+boost::mpi::status traced_recv(const boost::mpi::communicator &world, int source, int tag, T &value) {
+  if (!tracing_enabled()) {
+    return world.recv(source, tag, value);
+  }
+  auto start = TraceRecorder::global().now_ns();
+  auto status = world.recv(source, tag, value);
+  trace_message(TraceEvent::Kind::RECV, status.source(), status.tag(), trace_bytes<T>(1), start);
+  return status;
+}
+
+// Merge the timelines of all ranks into one Chrome trace written by root,
+// one process per rank. Clocks are aligned at a barrier, so spans of
+// different ranks line up to within its skew. Collective; does nothing while
+// tracing is off. Throws std::runtime_error on root if path cannot be
+// written.
+inline void write_trace(const boost::mpi::communicator &world, const std::string &path, int root = 0) {
+  if (!tracing_enabled()) {
+    return;
+  }
+  world.barrier();
+  int64_t sync = TraceRecorder::global().now_ns();
+  int64_t root_sync = sync;
+  boost::mpi::broadcast(world, root_sync, root);
+
+  std::vector<std::string> parts;
+  boost::mpi::gather(world, TraceRecorder::global().json_events(world.rank(), root_sync - sync), parts, root);
+  if (world.rank() != root) {
+    return;
+  }
+  std::string events;
+  for (const auto &part : parts) {
+    if (!events.empty()) {
+      events += ",\n";
+    }
+    events += part;
+  }
+  std::ofstream out(path, std::ios::trunc);
+  out << chrome_trace(events);
+  if (!out) {
+    throw std::runtime_error("Cannot write trace: " + path);
+  }
+}
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_TRACE_MPI_HPP_
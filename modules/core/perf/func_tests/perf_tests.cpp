@@ -1,10 +1,27 @@
 // Copyright 2023 Nesterov Alexander
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
+#include "core/batch/include/batch.hpp"
 #include "core/perf/func_tests/test_task.hpp"
+#include "core/perf/include/alloc_tracker.hpp"
+#include "core/perf/include/autotune.hpp"
+#include "core/perf/include/baseline.hpp"
 #include "core/perf/include/perf.hpp"
+#include "core/perf/include/results_sink.hpp"
+#include "core/perf/include/roofline.hpp"
+#include "core/perf/include/scaling.hpp"
+#include "core/task/include/time_limit.hpp"
 
 TEST(perf_tests, check_perf_pipeline) {
   // Create data
@@ -34,6 +51,7 @@ TEST(perf_tests, check_perf_pipeline) {
 
   ASSERT_LE(perfResults->time_sec, 10.0);
   EXPECT_EQ(out[0], in.size());
+  EXPECT_FALSE(perfResults->placement.cpus.empty());
 }
 
 TEST(perf_tests, check_perf_pipeline_float) {
@@ -155,3 +173,877 @@ TEST(perf_tests, check_perf_task_float) {
   ASSERT_LE(perfResults->time_sec, 10.0);
   EXPECT_EQ(out[0], in.size());
 }
+
+TEST(perf_tests, check_perf_pipeline_more_than_4g_elements) {
+  // Needs about 4 GiB of memory, so it only runs on request: outside of
+  // valgrind and the repeated runs, in a CI step of its own
+  if (std::getenv("PPC_RUN_LARGE_PERF_TESTS") == nullptr) {
+    GTEST_SKIP() << "Set PPC_RUN_LARGE_PERF_TESTS to run";
+  }
+
+  // Create data: only the element past 2^32 is non-zero, so a truncated count gives 0
+  const std::uint64_t count = (std::uint64_t{1} << 32) + 16;
+  std::vector<uint8_t> in(count, 0);
+  in.back() = 7;
+  std::vector<uint8_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(in.data());
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(out.data());
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto testTask = std::make_shared<ppc::test::TestTask<uint8_t>>(taskData);
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 1;
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perfAnalyzer(testTask);
+  perfAnalyzer.pipeline_run(perfAttr, perfResults);
+
+  EXPECT_EQ(out[0], 7);
+}
+
+TEST(perf_tests, check_compute_statistics) {
+  std::vector<double> samples(100);
+  for (size_t i = 0; i < samples.size(); i++) {
+    samples[i] = static_cast<double>(samples.size() - i);
+  }
+
+  auto statistics = ppc::core::compute_statistics(samples);
+
+  EXPECT_DOUBLE_EQ(statistics.min, 1.0);
+  EXPECT_DOUBLE_EQ(statistics.max, 100.0);
+  EXPECT_DOUBLE_EQ(statistics.mean, 50.5);
+  EXPECT_DOUBLE_EQ(statistics.median, 50.5);
+  EXPECT_NEAR(statistics.p95, 95.05, 1e-9);
+  EXPECT_NEAR(statistics.p99, 99.01, 1e-9);
+  EXPECT_NEAR(statistics.stddev, 29.011491975882016, 1e-9);
+
+  auto empty = ppc::core::compute_statistics({});
+  EXPECT_DOUBLE_EQ(empty.mean, 0.0);
+  EXPECT_DOUBLE_EQ(empty.stddev, 0.0);
+}
+
+TEST(perf_tests, check_perf_warmup_and_samples) {
+  // Create data
+  std::vector<uint32_t> in(10, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto testTask = std::make_shared<ppc::test::TestTask<uint32_t>>(taskData);
+
+  // Create Perf attributes; the timer ticks 1ms per summed element
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 5;
+  perfAttr->num_warmup = 3;
+  perfAttr->current_timer = [&] { return static_cast<double>(out[0]) * 1e-3; };
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perfAnalyzer(testTask);
+  perfAnalyzer.task_run(perfAttr, perfResults);
+
+  EXPECT_EQ(perfResults->num_running, 5U);
+  EXPECT_EQ(perfResults->num_warmup, 3U);
+  ASSERT_EQ(perfResults->samples_sec.size(), 5U);
+  EXPECT_NEAR(perfResults->time_sec, 0.05, 1e-9);
+  EXPECT_NEAR(perfResults->statistics.median, 0.01, 1e-9);
+  EXPECT_NEAR(perfResults->statistics.stddev, 0.0, 1e-9);
+}
+
+TEST(perf_tests, check_perf_calibration_by_target_time) {
+  // Create data
+  std::vector<uint32_t> in(10, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto testTask = std::make_shared<ppc::test::TestTask<uint32_t>>(taskData);
+
+  // Create Perf attributes; every run takes 10ms of simulated time
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 1;
+  perfAttr->target_time_sec = 1.0;
+  perfAttr->current_timer = [&] { return static_cast<double>(out[0]) * 1e-3; };
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perfAnalyzer(testTask);
+  perfAnalyzer.task_run(perfAttr, perfResults);
+
+  EXPECT_EQ(perfResults->num_running, 100U);
+  EXPECT_EQ(perfResults->samples_sec.size(), 100U);
+  EXPECT_NEAR(perfResults->time_sec, 1.0, 1e-6);
+}
+
+TEST(perf_tests, check_perf_calibration_across_ranks) {
+  // Create data
+  std::vector<uint32_t> in(10, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto testTask = std::make_shared<ppc::test::TestTask<uint32_t>>(taskData);
+
+  // Create Perf attributes; every run takes 10ms of simulated time here and
+  // 20ms on the slowest other rank
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 1;
+  perfAttr->target_time_sec = 1.0;
+  perfAttr->current_timer = [&] { return static_cast<double>(out[0]) * 1e-3; };
+  perfAttr->reduce_across_ranks = [](const ppc::core::PerfResults &) { return ppc::core::RankTimings(); };
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perfAnalyzer(testTask);
+  EXPECT_THROW(perfAnalyzer.task_run(perfAttr, perfResults), std::invalid_argument);
+
+  perfAttr->max_across_ranks = [](double value) { return 2.0 * value; };
+  perfAnalyzer.task_run(perfAttr, perfResults);
+  EXPECT_EQ(perfResults->num_running, 50U);
+}
+
+TEST(perf_tests, check_perf_calibration_without_timer) {
+  // Create data
+  std::vector<uint32_t> in(10, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto testTask = std::make_shared<ppc::test::TestTask<uint32_t>>(taskData);
+
+  // Create Perf attributes; the default timer never advances
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 7;
+  perfAttr->target_time_sec = 1.0;
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perfAnalyzer(testTask);
+  perfAnalyzer.pipeline_run(perfAttr, perfResults);
+
+  EXPECT_EQ(perfResults->num_running, 7U);
+  EXPECT_EQ(perfResults->samples_sec.size(), 7U);
+}
+
+TEST(perf_tests, check_perf_hw_counters) {
+  // Create data
+  std::vector<uint32_t> in(100000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto testTask = std::make_shared<ppc::test::TestTask<uint32_t>>(taskData);
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+  perfAttr->collect_hw_counters = true;
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perfAnalyzer(testTask);
+  perfAnalyzer.pipeline_run(perfAttr, perfResults);
+  EXPECT_EQ(out[0], in.size());
+
+  // Counters may be forbidden on this machine; then the run still succeeds
+  const auto &counters = perfResults->hw_counters;
+  for (size_t i = 0; i < ppc::core::kNumHwCounters; i++) {
+    if (!counters.valid[i]) {
+      EXPECT_EQ(counters.values[i], 0U);
+    }
+  }
+  if (counters.is_valid(ppc::core::HwCounter::INSTRUCTIONS)) {
+    EXPECT_GE(counters.value(ppc::core::HwCounter::INSTRUCTIONS), in.size() * perfAttr->num_running);
+  }
+
+  perfAttr->collect_hw_counters = false;
+  perfAnalyzer.task_run(perfAttr, perfResults);
+  EXPECT_FALSE(perfResults->hw_counters.available());
+}
+
+TEST(perf_tests, check_perf_stage_timings) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto testTask = std::make_shared<ppc::test::TestTask<uint32_t>>(taskData);
+
+  // Create Perf attributes
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 5;
+  perfAttr->num_warmup = 2;
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perfAnalyzer(testTask);
+  perfAnalyzer.pipeline_run(perfAttr, perfResults);
+  for (auto calls : perfResults->stage_timings.calls) {
+    EXPECT_EQ(calls, 5U);
+  }
+
+  perfAnalyzer.task_run(perfAttr, perfResults);
+  const auto &timings = perfResults->stage_timings;
+  EXPECT_EQ(timings.count(ppc::core::TaskStage::VALIDATION), 0U);
+  EXPECT_EQ(timings.count(ppc::core::TaskStage::PRE_PROCESSING), 0U);
+  EXPECT_EQ(timings.count(ppc::core::TaskStage::RUN), 5U);
+  EXPECT_EQ(timings.count(ppc::core::TaskStage::POST_PROCESSING), 0U);
+}
+
+TEST(perf_tests, check_results_sink) {
+  ppc::core::PerfResults perfResults;
+  perfResults.type_of_running = ppc::core::PerfResults::TypeOfRunning::PIPELINE;
+  perfResults.time_sec = 0.5;
+  perfResults.num_running = 5;
+  perfResults.problem_size = 2000;
+  perfResults.statistics = ppc::core::compute_statistics({0.1, 0.1, 0.1, 0.1, 0.1});
+
+  auto record = ppc::core::make_perf_record("tasks/seq/example", perfResults);
+  EXPECT_EQ(record.task_id, "example");
+  EXPECT_EQ(record.backend, "seq");
+  EXPECT_EQ(record.type_of_running, "pipeline");
+  EXPECT_GE(record.num_procs, 1);
+  EXPECT_EQ(record.num_threads, 1);
+  EXPECT_EQ(ppc::core::make_perf_record("tasks/stl/example", perfResults).num_threads, ppc::core::get_num_threads());
+
+  auto json = ppc::core::ResultsSink::to_json(record);
+  EXPECT_EQ(json.front(), '{');
+  EXPECT_EQ(json.back(), '}');
+  EXPECT_NE(json.find(R"("task":"example","backend":"seq","type":"pipeline")"), std::string::npos);
+  EXPECT_NE(json.find(R"("problem_size":2000,"iterations":5)"), std::string::npos);
+  EXPECT_NE(json.find(R"("median":0.1)"), std::string::npos);
+  EXPECT_NE(json.find(R"("placement":"none")"), std::string::npos);
+  EXPECT_EQ(json.find(R"("metrics")"), std::string::npos);
+  record.results.metrics = {{"snapshots", 3.0}, {"copy_sec", 0.25}};
+  EXPECT_NE(ppc::core::ResultsSink::to_json(record).find(R"("metrics":{"snapshots":3,"copy_sec":0.25})"),
+            std::string::npos);
+  record.results.metrics.clear();
+
+  auto header = ppc::core::ResultsSink::csv_header();
+  auto row = ppc::core::ResultsSink::to_csv(record);
+  EXPECT_EQ(std::count(header.begin(), header.end(), ','), std::count(row.begin(), row.end(), ','));
+
+  auto path = std::filesystem::temp_directory_path() / "ppc_perf_results_test.csv";
+  std::filesystem::remove(path);
+  ppc::core::ResultsSink sink(path.string(), ppc::core::ResultsSink::Format::CSV);
+  sink.write(record);
+  sink.write(record);
+
+  std::ifstream file(path);
+  std::vector<std::string> lines;
+  for (std::string line; std::getline(file, line);) {
+    lines.push_back(line);
+  }
+  ASSERT_EQ(lines.size(), 3U);
+  EXPECT_EQ(lines[0], header);
+  EXPECT_EQ(lines[1], row);
+
+  // rows are not appended under the columns of another build
+  {
+    std::ofstream other(path, std::ios::trunc);
+    other << "task,backend,time_sec\n";
+  }
+  EXPECT_THROW(sink.write(record), std::runtime_error);
+  std::filesystem::remove(path);
+}
+
+TEST(perf_tests, check_scaling_config) {
+  ppc::core::ScalingConfig config;
+  EXPECT_EQ(config.problem_size(1000), 1000U);
+
+  config.workers = 4;
+  config.mode = ppc::core::ScalingMode::STRONG;
+  EXPECT_EQ(config.problem_size(1000), 1000U);
+  config.mode = ppc::core::ScalingMode::WEAK;
+  EXPECT_EQ(config.problem_size(1000), 4000U);
+  EXPECT_STREQ(ppc::core::scaling_mode_name(config.mode), "weak");
+
+  EXPECT_GE(ppc::core::get_num_threads(), 1);
+}
+
+TEST(perf_tests, check_perf_rank_reduction_hook) {
+  // Create data
+  std::vector<uint32_t> in(10, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto testTask = std::make_shared<ppc::test::TestTask<uint32_t>>(taskData);
+
+  // Create Perf attributes; a single "rank" reduction
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 3;
+  perfAttr->reduce_across_ranks = [](const ppc::core::PerfResults &results) {
+    ppc::core::RankTimings timings;
+    timings.num_ranks = 1;
+    timings.total = {results.time_sec, results.time_sec, results.time_sec};
+    return timings;
+  };
+
+  // Create and init perf results
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perfAnalyzer(testTask);
+  perfAnalyzer.pipeline_run(perfAttr, perfResults);
+
+  ASSERT_TRUE(perfResults->rank_timings.available());
+  EXPECT_EQ(perfResults->rank_timings.num_ranks, 1);
+  EXPECT_DOUBLE_EQ(perfResults->rank_timings.total.max, perfResults->time_sec);
+
+  perfAttr->reduce_across_ranks = nullptr;
+  perfAnalyzer.task_run(perfAttr, perfResults);
+  EXPECT_FALSE(perfResults->rank_timings.available());
+}
+
+TEST(perf_tests, check_perf_pipeline_without_allocations) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task and let it allocate its buffers once
+  auto testTask = std::make_shared<ppc::test::TestVectorTask<uint32_t>>(taskData);
+  ppc::core::Perf perfAnalyzer(testTask);
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 1;
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+  perfAnalyzer.pipeline_run(perfAttr, perfResults);
+
+  // Repeated pipelines on the same shapes do not touch the heap
+  auto before = ppc::core::allocation_snapshot().count;
+  for (int i = 0; i < 100; i++) {
+    testTask->validation();
+    testTask->pre_processing();
+    testTask->run();
+    testTask->post_processing();
+  }
+  EXPECT_EQ(ppc::core::allocation_snapshot().count - before, 0U);
+  EXPECT_EQ(out[0], in.size());
+
+  // Perf itself allocates per measurement, not per run
+  perfAttr->num_running = 10;
+  before = ppc::core::allocation_snapshot().count;
+  perfAnalyzer.pipeline_run(perfAttr, perfResults);
+  auto allocations_10 = ppc::core::allocation_snapshot().count - before;
+  perfAttr->num_running = 1000;
+  before = ppc::core::allocation_snapshot().count;
+  perfAnalyzer.pipeline_run(perfAttr, perfResults);
+  auto allocations_1000 = ppc::core::allocation_snapshot().count - before;
+  EXPECT_EQ(allocations_10, allocations_1000);
+
+  // Rebinding to same-shaped buffers keeps the allocations too
+  std::vector<uint32_t> in2(2000, 2);
+  auto taskData2 = std::make_shared<ppc::core::TaskData>(*taskData);
+  taskData2->inputs[0] = reinterpret_cast<uint8_t *>(in2.data());
+  testTask->rebind(taskData2);
+  before = ppc::core::allocation_snapshot().count;
+  testTask->validation();
+  testTask->pre_processing();
+  testTask->run();
+  testTask->post_processing();
+  EXPECT_EQ(ppc::core::allocation_snapshot().count - before, 0U);
+  EXPECT_EQ(out[0], 2 * in2.size());
+}
+
+TEST(perf_tests, check_allocation_tracking) {
+  auto before = ppc::core::allocation_snapshot();
+  ppc::core::reset_allocation_peak();
+  {
+    std::vector<double> data(1000);
+    auto aligned = std::make_unique<std::array<double, 8>>();
+    EXPECT_EQ(data.size(), 1000U);
+  }
+  auto after = ppc::core::allocation_snapshot();
+  EXPECT_EQ(after.count - before.count, 2U);
+  EXPECT_EQ(after.bytes - before.bytes, 1000 * sizeof(double) + sizeof(std::array<double, 8>));
+  EXPECT_EQ(after.live_bytes, before.live_bytes);
+  EXPECT_GE(after.peak_bytes - before.live_bytes, after.bytes - before.bytes);
+}
+
+TEST(perf_tests, check_perf_stage_allocations) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // A fresh task allocates its copy of the input in the first pre_processing()
+  auto testTask = std::make_shared<ppc::test::TestVectorTask<uint32_t>>(taskData);
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 5;
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+  ppc::core::Perf perfAnalyzer(testTask);
+  perfAnalyzer.pipeline_run(perfAttr, perfResults);
+
+  const auto &stages = perfResults->stage_allocations;
+  const auto &pre_processing = stages[static_cast<size_t>(ppc::core::TaskStage::PRE_PROCESSING)];
+  EXPECT_GE(pre_processing.count, 1U);
+  EXPECT_GE(pre_processing.bytes, in.size() * sizeof(uint32_t));
+  EXPECT_GE(pre_processing.peak_bytes, in.size() * sizeof(uint32_t));
+  EXPECT_GE(perfResults->allocations.peak_bytes, in.size() * sizeof(uint32_t));
+
+  // warm-up runs are not counted, and a reused task allocates nothing
+  perfAttr->num_warmup = 1;
+  perfAnalyzer.pipeline_run(perfAttr, perfResults);
+  for (const auto &stage : perfResults->stage_allocations) {
+    EXPECT_EQ(stage.count, 0U);
+  }
+  EXPECT_EQ(perfResults->allocations.count, 0U);
+}
+
+TEST(perf_tests, check_perf_allocation_limit) {
+  ASSERT_TRUE(ppc::core::allocation_tracking());
+
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create TaskData
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  auto testTask = std::make_shared<ppc::test::TestVectorTask<uint32_t>>(taskData);
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 5;
+  perfAttr->max_allocations = 0;
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+  ppc::core::Perf perfAnalyzer(testTask);
+
+  auto previous = ppc::core::time_limit_policy();
+  std::vector<ppc::core::AllocationLimitViolation> violations;
+  ppc::core::TimeLimitPolicy policy;
+  policy.on_allocation_violation = [&](const ppc::core::AllocationLimitViolation &violation) {
+    violations.push_back(violation);
+  };
+  ppc::core::set_time_limit_policy(policy);
+
+  // the first pre_processing() of a fresh task allocates, a reused one does not
+  perfAnalyzer.pipeline_run(perfAttr, perfResults);
+  ASSERT_EQ(violations.size(), 1U);
+  EXPECT_EQ(violations[0].count, perfResults->allocations.count);
+  EXPECT_EQ(violations[0].limit, 0U);
+  perfAnalyzer.pipeline_run(perfAttr, perfResults);
+  ppc::core::set_time_limit_policy(previous);
+  EXPECT_EQ(violations.size(), 1U);
+}
+
+TEST(perf_tests, check_perf_batch_throughput) {
+  // Create data: many small vectors in one batch
+  const size_t num_instances = 64;
+  std::vector<std::vector<uint32_t>> in(num_instances, std::vector<uint32_t>(100, 1));
+  std::vector<uint32_t> out(num_instances, 0);
+
+  // Create TaskData
+  auto batch = std::make_shared<ppc::core::TaskData>();
+  for (size_t i = 0; i < num_instances; i++) {
+    batch->inputs.emplace_back(reinterpret_cast<uint8_t *>(in[i].data()));
+    batch->inputs_count.emplace_back(in[i].size());
+    batch->outputs.emplace_back(reinterpret_cast<uint8_t *>(&out[i]));
+    batch->outputs_count.emplace_back(1);
+  }
+
+  // Create Task
+  auto batchTask = std::make_shared<ppc::core::BatchTask>(
+      batch, ppc::core::BatchRunner(
+                 [](std::shared_ptr<ppc::core::TaskData> taskData) {
+                   return std::make_shared<ppc::test::TestTask<uint32_t>>(taskData);
+                 },
+                 {1, 1}, 2));
+
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 5;
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+  ppc::core::Perf perfAnalyzer(batchTask);
+  perfAnalyzer.pipeline_run(perfAttr, perfResults);
+  ppc::core::Perf::print_perf_statistic(perfResults);
+
+  EXPECT_EQ(perfResults->num_instances, num_instances);
+  EXPECT_DOUBLE_EQ(perfResults->time_per_instance(),
+                   perfResults->statistics.mean / static_cast<double>(num_instances));
+  EXPECT_EQ(out[num_instances - 1], 100U);
+}
+
+TEST(perf_tests, check_perf_time_limit_policy) {
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+  perfResults->time_sec = 2.0;
+  perfResults->type_of_running = ppc::core::PerfResults::TypeOfRunning::PIPELINE;
+
+  auto previous = ppc::core::time_limit_policy();
+  std::vector<ppc::core::TimeLimitViolation> violations;
+  ppc::core::TimeLimitPolicy policy;
+  policy.perf_limit_sec = 1.0;
+  policy.on_violation = [&](const ppc::core::TimeLimitViolation &violation) { violations.push_back(violation); };
+  ppc::core::set_time_limit_policy(policy);
+
+  testing::internal::CaptureStdout();
+  ppc::core::Perf::print_perf_statistic(perfResults, "tasks/seq/some_task/perf_tests/main.cpp");
+  auto output = testing::internal::GetCapturedStdout();
+  ppc::core::set_time_limit_policy(previous);
+
+  ASSERT_EQ(violations.size(), 1U);
+  EXPECT_EQ(violations[0].kind, ppc::core::TimeLimitKind::PERF);
+  EXPECT_DOUBLE_EQ(violations[0].time_sec, 2.0);
+  EXPECT_NE(output.find("tasks/seq/some_task:pipeline:-1.0000000000"), std::string::npos);
+}
+
+TEST(perf_tests, check_regression_policy) {
+  ppc::core::RegressionViolation violation{0.015, 0.01, 1.5, 0.001};
+  auto message = ppc::core::time_limit_message(violation);
+  EXPECT_NE(message.find("0.015"), std::string::npos);
+  EXPECT_NE(message.find("0.01 secs"), std::string::npos);
+  EXPECT_NE(message.find("x1.5"), std::string::npos);
+
+  EXPECT_THROW(ppc::core::TimeLimitPolicy::fail().on_regression(violation), std::runtime_error);
+  EXPECT_TRUE(ppc::core::TimeLimitPolicy::report().on_regression);
+  EXPECT_FALSE(ppc::core::TimeLimitPolicy::ignore().on_regression);
+}
+
+TEST(perf_tests, check_tuning_cache) {
+  auto path = std::filesystem::temp_directory_path() / "ppc_tuning_cache_test.txt";
+  std::filesystem::remove(path);
+  ppc::core::TuningCache cache(path.string());
+  EXPECT_FALSE(cache.find("sum/1000").has_value());
+
+  cache.store("sum/1000", {{{"block", 64}, {"order", 1}}, 0.25});
+  cache.store("sum/10", {{{"block", 8}}, 0.5});
+  cache.store("sum/1000", {{{"block", 128}, {"order", 0}}, 0.125});
+  auto entry = cache.find("sum/1000");
+  ASSERT_TRUE(entry.has_value());
+  EXPECT_EQ(entry->config, (ppc::core::TuneConfig{{"block", 128}, {"order", 0}}));
+  EXPECT_DOUBLE_EQ(entry->time_sec, 0.125);
+  EXPECT_EQ(cache.find("sum/10")->config.at("block"), 8);
+  EXPECT_THROW(cache.store("bad\tkey", {}), std::invalid_argument);
+
+  EXPECT_EQ(cache.value("sum/1000", "block", 32), 128);
+  EXPECT_EQ(cache.value("sum/1000", "tile", 32), 32);
+  EXPECT_EQ(cache.value("sum/5", "block", 32), 32);
+  std::filesystem::remove(path);
+}
+
+TEST(perf_tests, check_autotuner) {
+  auto path = std::filesystem::temp_directory_path() / "ppc_autotuner_test.txt";
+  std::filesystem::remove(path);
+
+  // Create data
+  std::vector<int> in(100, 1);
+  std::vector<int> out(1, 0);
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Simulated time: block 64 is the fastest, 256 does not fit the input
+  double clock = 0.0;
+  int constructed = 0;
+  auto factory = [&](const ppc::core::TuneConfig &config) {
+    constructed++;
+    return std::make_shared<ppc::test::TestBlockTask>(taskData, config.at("block"), clock);
+  };
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 3;
+  perfAttr->current_timer = [&] { return clock; };
+
+  ppc::core::AutoTuner tuner("sum/100", {{"block", {16, 64, 256}}, {"unroll", {1, 2}}},
+                             ppc::core::TuningCache(path.string()));
+  EXPECT_EQ(tuner.configurations().size(), 6U);
+  EXPECT_EQ(tuner.defaults(), (ppc::core::TuneConfig{{"block", 16}, {"unroll", 1}}));
+  EXPECT_FALSE(tuner.is_tuned());
+  EXPECT_EQ(tuner.lookup(), tuner.defaults());
+
+  auto best = tuner.get(factory, perfAttr);
+  EXPECT_EQ(best.at("block"), 64);
+  EXPECT_EQ(tuner.measurements().size(), 4U);
+  EXPECT_EQ(out[0], 100);
+  EXPECT_EQ(constructed, 6);
+
+  // a later run takes the configuration from the cache
+  ppc::core::AutoTuner later("sum/100", {{"block", {16, 64, 256}}, {"unroll", {1, 2}}},
+                             ppc::core::TuningCache(path.string()));
+  EXPECT_TRUE(later.is_tuned());
+  EXPECT_EQ(later.get(factory, perfAttr), best);
+  EXPECT_EQ(constructed, 6);
+
+  // a changed space invalidates the cached configuration
+  ppc::core::AutoTuner changed("sum/100", {{"block", {16, 32}}}, ppc::core::TuningCache(path.string()));
+  EXPECT_FALSE(changed.is_tuned());
+  EXPECT_EQ(changed.lookup().at("block"), 16);
+  EXPECT_EQ(changed.tune(factory, perfAttr).at("block"), 32);
+
+  ppc::core::AutoTuner impossible("sum/100", {{"block", {1000}}}, ppc::core::TuningCache(path.string()));
+  EXPECT_THROW(static_cast<void>(impossible.tune(factory, perfAttr)), std::runtime_error);
+  EXPECT_THROW(ppc::core::AutoTuner("sum", {{"block", {}}}), std::invalid_argument);
+  EXPECT_THROW(ppc::core::AutoTuner("sum", {{"block", {1}}, {"block", {2}}}), std::invalid_argument);
+  std::filesystem::remove(path);
+}
+
+TEST(perf_tests, check_autotuner_across_ranks) {
+  auto path = std::filesystem::temp_directory_path() / "ppc_autotuner_ranks_test.txt";
+  std::filesystem::remove(path);
+
+  // Create data
+  std::vector<int> in(100, 1);
+  std::vector<int> out(1, 0);
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  double clock = 0.0;
+  auto factory = [&](const ppc::core::TuneConfig &config) {
+    return std::make_shared<ppc::test::TestBlockTask>(taskData, config.at("block"), clock);
+  };
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 3;
+  perfAttr->current_timer = [&] { return clock; };
+  perfAttr->reduce_across_ranks = [](const ppc::core::PerfResults &) { return ppc::core::RankTimings(); };
+
+  ppc::core::AutoTuner tuner("sum/100", {{"block", {16, 64}}}, ppc::core::TuningCache(path.string()));
+  EXPECT_THROW(static_cast<void>(tuner.tune(factory, perfAttr)), std::invalid_argument);
+
+  // another rank rejects the first configuration, which passes validation here
+  int verdicts = 0;
+  perfAttr->max_across_ranks = [&](double value) { return verdicts++ == 0 ? 1.0 : value; };
+  EXPECT_EQ(tuner.tune(factory, perfAttr).at("block"), 64);
+  EXPECT_EQ(verdicts, 2);
+  EXPECT_EQ(tuner.measurements().size(), 1U);
+  std::filesystem::remove(path);
+}
+
+namespace {
+
+// count samples around mean, spread evenly over +-1%
+std::vector<double> jittered_samples(double mean, int count) {
+  std::vector<double> samples;
+  for (int i = 0; i < count; i++) {
+    samples.push_back(mean * (0.99 + 0.02 * i / (count - 1)));
+  }
+  return samples;
+}
+
+}  // namespace
+
+TEST(perf_tests, check_baseline_comparison) {
+  auto baseline = jittered_samples(1.0, 20);
+
+  auto slower = ppc::core::compare_samples(baseline, jittered_samples(1.2, 20));
+  EXPECT_EQ(slower.verdict, ppc::core::BaselineVerdict::SLOWER);
+  EXPECT_NEAR(slower.ratio, 1.2, 1e-9);
+  EXPECT_LT(slower.p_value, 1e-6);
+
+  auto faster = ppc::core::compare_samples(baseline, jittered_samples(0.8, 20));
+  EXPECT_EQ(faster.verdict, ppc::core::BaselineVerdict::FASTER);
+  EXPECT_LT(faster.p_value, 1e-6);
+
+  // significant, but below the smallest change worth reporting
+  auto small = ppc::core::compare_samples(baseline, jittered_samples(1.03, 20));
+  EXPECT_EQ(small.verdict, ppc::core::BaselineVerdict::UNCHANGED);
+  EXPECT_LT(small.p_value, 0.01);
+
+  // one preempted iteration moves the mean, not the verdict
+  auto noisy = baseline;
+  noisy[3] = 100.0;
+  auto unchanged = ppc::core::compare_samples(baseline, noisy);
+  EXPECT_EQ(unchanged.verdict, ppc::core::BaselineVerdict::UNCHANGED);
+  EXPECT_GT(unchanged.p_value, 0.1);
+
+  EXPECT_EQ(ppc::core::compare_samples(baseline, {2.0, 2.0}).verdict, ppc::core::BaselineVerdict::TOO_FEW_SAMPLES);
+  EXPECT_EQ(ppc::core::compare_samples({}, baseline).verdict, ppc::core::BaselineVerdict::NO_BASELINE);
+  EXPECT_EQ(ppc::core::compare_samples(std::vector<double>(10, 1.0), std::vector<double>(10, 1.0)).verdict,
+            ppc::core::BaselineVerdict::UNCHANGED);
+}
+
+TEST(perf_tests, check_baseline_store) {
+  auto directory = std::filesystem::temp_directory_path() / "ppc_perf_baseline_test";
+  std::filesystem::remove_all(directory);
+  auto machine = ppc::core::MachineFingerprint::from_description("test cpu|4 cpus|8 GiB|Linux x86_64");
+  ppc::core::BaselineStore store(directory.string(), ppc::core::BaselineStore::Mode::COMPARE, machine);
+
+  ppc::core::PerfResults perfResults;
+  perfResults.type_of_running = ppc::core::PerfResults::TypeOfRunning::PIPELINE;
+  perfResults.problem_size = 1000;
+  perfResults.samples_sec = jittered_samples(0.01, 10);
+  auto record = ppc::core::make_perf_record("tasks/seq/example", perfResults);
+
+  // the first run becomes the baseline
+  EXPECT_EQ(store.check(record).verdict, ppc::core::BaselineVerdict::NO_BASELINE);
+  EXPECT_EQ(std::filesystem::path(store.path(record)).parent_path().filename().string(), machine.id);
+  auto stored = store.find(record);
+  ASSERT_TRUE(stored.has_value());
+  EXPECT_EQ(stored->machine, machine.description);
+  EXPECT_EQ(stored->samples_sec, perfResults.samples_sec);
+  EXPECT_EQ(store.check(record).verdict, ppc::core::BaselineVerdict::UNCHANGED);
+
+  // a regression is reported and does not replace the baseline
+  auto slow = record;
+  slow.results.samples_sec = jittered_samples(0.015, 10);
+  EXPECT_EQ(store.check(slow).verdict, ppc::core::BaselineVerdict::SLOWER);
+  EXPECT_EQ(store.find(record)->samples_sec, perfResults.samples_sec);
+  ppc::core::BaselineStore update(directory.string(), ppc::core::BaselineStore::Mode::UPDATE, machine);
+  EXPECT_EQ(update.check(slow).verdict, ppc::core::BaselineVerdict::SLOWER);
+  EXPECT_EQ(store.check(slow).verdict, ppc::core::BaselineVerdict::UNCHANGED);
+
+  // other machines and problem sizes have baselines of their own
+  ppc::core::BaselineStore other(directory.string(), ppc::core::BaselineStore::Mode::COMPARE,
+                                 ppc::core::MachineFingerprint::from_description("other cpu"));
+  EXPECT_FALSE(other.find(record).has_value());
+  auto larger = record;
+  larger.results.problem_size = 2000;
+  EXPECT_FALSE(store.find(larger).has_value());
+
+  {
+    std::ofstream damaged(store.path(record), std::ios::trunc);
+    damaged << "ppc-baseline 1\nmachine test\nsamples 10\n0.5\n";
+  }
+  EXPECT_FALSE(store.find(record).has_value());
+
+  auto detected = ppc::core::MachineFingerprint::detect();
+  EXPECT_EQ(detected.id.size(), 16U);
+  EXPECT_EQ(detected.id, ppc::core::MachineFingerprint::detect().id);
+  std::filesystem::remove_all(directory);
+}
+
+TEST(perf_tests, check_roofline_point) {
+  ppc::core::PerfResults perfResults;
+  perfResults.stage_timings.total_sec[static_cast<size_t>(ppc::core::TaskStage::RUN)] = 2.0;
+  perfResults.stage_timings.calls[static_cast<size_t>(ppc::core::TaskStage::RUN)] = 4;
+  ppc::core::MachinePeak peak;
+  peak.bandwidth_gbs = 10.0;
+  peak.gflops = 100.0;
+  EXPECT_DOUBLE_EQ(peak.ridge_point(), 10.0);
+
+  // nothing declared, nothing reported
+  auto none = ppc::core::roofline_point(perfResults, peak);
+  EXPECT_EQ(none.gflops, 0.0);
+  EXPECT_EQ(none.efficiency, 0.0);
+
+  // memory bound: 1 operation per byte, attainable 10 GFLOP/s
+  perfResults.work = {500000000, 500000000};
+  auto point = ppc::core::roofline_point(perfResults, peak);
+  EXPECT_DOUBLE_EQ(point.bandwidth_gbs, 1.0);
+  EXPECT_DOUBLE_EQ(point.gflops, 1.0);
+  EXPECT_DOUBLE_EQ(point.intensity, 1.0);
+  EXPECT_DOUBLE_EQ(point.attainable_gflops, 10.0);
+  EXPECT_DOUBLE_EQ(point.efficiency, 0.1);
+
+  // compute bound: 100 operations per byte are capped by the arithmetic peak
+  perfResults.work = {5000000, 500000000};
+  point = ppc::core::roofline_point(perfResults, peak);
+  EXPECT_DOUBLE_EQ(point.attainable_gflops, 100.0);
+  EXPECT_DOUBLE_EQ(point.efficiency, 0.01);
+
+  // bytes only: share of the peak bandwidth
+  perfResults.work = {5000000000, 0};
+  EXPECT_DOUBLE_EQ(ppc::core::roofline_point(perfResults, peak).efficiency, 1.0);
+}
+
+TEST(perf_tests, check_perf_declared_work) {
+  std::vector<double> in(1 << 16, 1.0);
+  std::vector<double> out(1, 0.0);
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+  auto testTask = std::make_shared<ppc::test::TestWorkTask<double>>(taskData);
+
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 5;
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+  ppc::core::Perf perfAnalyzer(testTask);
+  perfAnalyzer.task_run(perfAttr, perfResults);
+  EXPECT_EQ(perfResults->work.bytes, in.size() * sizeof(double));
+  EXPECT_EQ(perfResults->work.operations, in.size());
+  EXPECT_GT(perfResults->gflops(), 0.0);
+  EXPECT_DOUBLE_EQ(perfResults->bandwidth_gbs(), perfResults->gflops() * sizeof(double));
+
+  const auto &peak = ppc::core::MachinePeak::get();
+  EXPECT_TRUE(peak.available());
+  EXPECT_GE(peak.threads, 0);
+  testing::internal::CaptureStdout();
+  ppc::core::Perf::print_perf_statistic(perfResults, "tasks/seq/some_task/perf_tests/main.cpp");
+  auto output = testing::internal::GetCapturedStdout();
+  EXPECT_NE(output.find("tasks/seq/some_task:task_run:roofline:bytes=524288,operations=65536,"), std::string::npos);
+  EXPECT_NE(output.find(",peak_gb_per_s="), std::string::npos);
+}
@@ -5,7 +5,11 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
 #include <memory>
+#include <numeric>
 #include <vector>
 
 #include "core/task/include/task.hpp"
@@ -31,7 +35,7 @@ class TestTask : public ppc::core::Task {
 
   bool run() override {
     internal_order_test();
-    for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
+    for (size_t i = 0; i < taskData->inputs_count[0]; i++) {
       output_[0] += input_[i];
     }
     return true;
@@ -47,6 +51,94 @@ class TestTask : public ppc::core::Task {
   T *output_{};
 };
 
+// TestTask declaring its work: one pass over the input, one addition per element
+template <class T>
+class TestWorkTask : public TestTask<T> {
+ public:
+  explicit TestWorkTask(std::shared_ptr<ppc::core::TaskData> taskData_) : TestTask<T>(taskData_) {}
+  [[nodiscard]] ppc::core::TaskWork work() const override {
+    uint64_t count = this->taskData->inputs_count[0];
+    return {count * sizeof(T), count};
+  }
+};
+
+// Keeps a private copy of the input like most course tasks, but refills it
+// with assign() so repeated pipelines reuse the allocation
+template <class T>
+class TestVectorTask : public ppc::core::Task {
+ public:
+  explicit TestVectorTask(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(taskData_) {}
+  bool pre_processing() override {
+    internal_order_test();
+    auto *input = reinterpret_cast<T *>(taskData->inputs[0]);
+    input_.assign(input, input + taskData->inputs_count[0]);
+    return true;
+  }
+
+  bool validation() override {
+    internal_order_test();
+    return taskData->outputs_count[0] == 1;
+  }
+
+  bool run() override {
+    internal_order_test();
+    result_ = std::accumulate(input_.begin(), input_.end(), T{});
+    return true;
+  }
+
+  bool post_processing() override {
+    internal_order_test();
+    reinterpret_cast<T *>(taskData->outputs[0])[0] = result_;
+    return true;
+  }
+
+ private:
+  std::vector<T> input_;
+  T result_{};
+};
+
+// Sums the input in blocks of a tunable size and advances a simulated clock by
+// a cost that is lowest for blocks of 64; blocks larger than the input fail
+// validation
+class TestBlockTask : public ppc::core::Task {
+ public:
+  TestBlockTask(std::shared_ptr<ppc::core::TaskData> taskData_, int64_t block_, double &clock_)
+      : Task(taskData_), block(block_), clock(clock_) {}
+  bool pre_processing() override {
+    internal_order_test();
+    input_ = reinterpret_cast<int *>(taskData->inputs[0]);
+    output_ = reinterpret_cast<int *>(taskData->outputs[0]);
+    return true;
+  }
+
+  bool validation() override {
+    internal_order_test();
+    return taskData->outputs_count[0] == 1 && block > 0 && static_cast<uint64_t>(block) <= taskData->inputs_count[0];
+  }
+
+  bool run() override {
+    internal_order_test();
+    output_[0] = 0;
+    for (size_t begin = 0; begin < taskData->inputs_count[0]; begin += block) {
+      auto end = std::min<size_t>(begin + block, taskData->inputs_count[0]);
+      output_[0] = std::accumulate(input_ + begin, input_ + end, output_[0]);
+    }
+    clock += 1e-3 * static_cast<double>(1 + std::abs(block - 64));
+    return true;
+  }
+
+  bool post_processing() override {
+    internal_order_test();
+    return true;
+  }
+
+ private:
+  int64_t block;
+  double &clock;
+  int *input_{};
+  int *output_{};
+};
+
 }  // namespace ppc::test
 
 #endif  // MODULES_CORE_TESTS_TEST_TASK_HPP_
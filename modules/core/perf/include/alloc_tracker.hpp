@@ -0,0 +1,52 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_ALLOC_TRACKER_HPP_
+#define MODULES_CORE_INCLUDE_ALLOC_TRACKER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ppc::core {
+
+// Heap allocations made through new (std containers included; plain malloc is
+// not seen), counted in process-wide atomics. The replaced global operator
+// new/delete live in the core_alloc_tracker object library, linked into
+// core_func_tests and, with -D USE_ALLOC_TRACKER=ON, into the task tests;
+// elsewhere nothing is counted and the snapshots stay zero.
+struct AllocationSnapshot {
+  // allocations and bytes requested since start
+  std::uint64_t count = 0;
+  std::uint64_t bytes = 0;
+  // bytes currently allocated and the maximum since reset_allocation_peak()
+  std::uint64_t live_bytes = 0;
+  std::uint64_t peak_bytes = 0;
+};
+
+// true if the binary is linked with core_alloc_tracker
+bool allocation_tracking();
+
+AllocationSnapshot allocation_snapshot();
+
+// restart peak tracking from the current live size
+void reset_allocation_peak();
+
+// Allocations made during some region of code
+struct AllocationStats {
+  std::uint64_t count = 0;
+  std::uint64_t bytes = 0;
+  // largest growth of live heap above the size at the start of the region
+  std::uint64_t peak_bytes = 0;
+};
+
+namespace detail {
+
+// called by the core_alloc_tracker hooks
+void enable_allocation_tracking();
+void record_allocation(std::size_t size);
+void record_free(std::size_t size);
+
+}  // namespace detail
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_ALLOC_TRACKER_HPP_
@@ -0,0 +1,114 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_AUTOTUNE_HPP_
+#define MODULES_CORE_INCLUDE_AUTOTUNE_HPP_
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/perf/include/perf.hpp"
+
+namespace ppc::core {
+
+// A tunable parameter of a task (block size, tile size, loop order, ...) and
+// the values worth trying
+struct TuneParameter {
+  std::string name;
+  std::vector<int64_t> values;
+};
+
+// value of every parameter by name
+using TuneConfig = std::map<std::string, int64_t>;
+
+struct TunedEntry {
+  TuneConfig config;
+  // mean pipeline time of config when it was tuned
+  double time_sec = 0.0;
+};
+
+// Best configurations by key, kept in a text file with one
+// "key<TAB>name=value,...<TAB>time" line per key
+class TuningCache {
+ public:
+  explicit TuningCache(std::string path);
+
+  // PPC_TUNING_CACHE if set, ppc_tuning_cache.txt in the working directory otherwise
+  static TuningCache from_env();
+
+  // nothing if the file or the key does not exist
+  [[nodiscard]] std::optional<TunedEntry> find(const std::string& key) const;
+  // replaces the entry of key; the file is rewritten through a temporary and a
+  // rename, so concurrent writers (e.g. the ranks of an MPI job) do not tear it.
+  // Throws std::runtime_error if it cannot be written.
+  void store(const std::string& key, const TunedEntry& entry) const;
+  // value of parameter name in the entry of key, or fallback
+  [[nodiscard]] int64_t value(const std::string& key, const std::string& name, int64_t fallback) const;
+
+  [[nodiscard]] const std::string& path() const { return path_; }
+
+ private:
+  std::map<std::string, TunedEntry> load() const;
+
+  std::string path_;
+};
+
+// TuningCache::from_env().value(key, name, fallback). Meant for task
+// constructors: it reads the cache file, so keep it out of run().
+int64_t tuned_value(const std::string& key, const std::string& name, int64_t fallback);
+
+// Benchmarks every combination of a parameter space for a task on this
+// machine and keeps the fastest in a TuningCache under key (e.g. task id and
+// problem size), so later runs construct the task tuned.
+//
+// Each configuration is first run once through the whole lifecycle; those
+// failing validation (e.g. a block larger than the input) are skipped. The
+// rest are measured with Perf::pipeline_run and compared by mean time, or by
+// the slowest rank if perfAttr reduces across ranks. Across ranks perfAttr
+// also needs max_across_ranks, through which the ranks agree on the
+// validation verdicts; then every rank of an MPI job measures the same
+// configurations and picks the same one.
+class AutoTuner {
+ public:
+  using TaskFactory = std::function<std::shared_ptr<Task>(const TuneConfig&)>;
+
+  // throws std::invalid_argument if a parameter has no values or names repeat
+  AutoTuner(std::string key_, std::vector<TuneParameter> space_, TuningCache cache_ = TuningCache::from_env());
+
+  // all combinations, the first parameter changing slowest
+  [[nodiscard]] std::vector<TuneConfig> configurations() const;
+  // first value of every parameter
+  [[nodiscard]] TuneConfig defaults() const;
+
+  // cached configuration if it fits the space, defaults otherwise; measures nothing
+  [[nodiscard]] TuneConfig lookup() const;
+  [[nodiscard]] bool is_tuned() const;
+
+  // measure the space and store the fastest configuration; throws
+  // std::runtime_error if no configuration passes validation and
+  // std::invalid_argument for reduce_across_ranks without max_across_ranks
+  TuneConfig tune(const TaskFactory& factory, const std::shared_ptr<PerfAttr>& perfAttr);
+  // lookup() if already tuned, tune() otherwise
+  TuneConfig get(const TaskFactory& factory, const std::shared_ptr<PerfAttr>& perfAttr);
+
+  // time of every configuration measured by the last tune()
+  [[nodiscard]] const std::vector<std::pair<TuneConfig, double>>& measurements() const { return measured; }
+  [[nodiscard]] const TuningCache& cache() const { return cache_; }
+
+ private:
+  [[nodiscard]] bool fits(const TuneConfig& config) const;
+
+  std::string key;
+  std::vector<TuneParameter> space;
+  TuningCache cache_;
+  std::vector<std::pair<TuneConfig, double>> measured;
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_AUTOTUNE_HPP_
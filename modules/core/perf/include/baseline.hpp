@@ -0,0 +1,114 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_BASELINE_HPP_
+#define MODULES_CORE_INCLUDE_BASELINE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "core/perf/include/results_sink.hpp"
+
+namespace ppc::core {
+
+// The hardware a measurement ran on. Baselines are kept per machine, so runs
+// are only ever compared with runs of the same kind of machine.
+struct MachineFingerprint {
+  // CPU model, logical CPUs, memory and OS, e.g.
+  // "Intel(R) Xeon(R) Gold 6248 CPU @ 2.50GHz|80 cpus|376 GiB|Linux x86_64"
+  std::string description;
+  // 16 hex digits hashed from description, used as a directory name
+  std::string id;
+
+  static MachineFingerprint from_description(std::string description);
+  // /proc/cpuinfo and /proc/meminfo on Linux; CPU count and OS elsewhere
+  static MachineFingerprint detect();
+};
+
+// Per-iteration samples of a measurement kept as the reference for later runs
+struct Baseline {
+  std::string machine;
+  std::vector<double> samples_sec;
+};
+
+enum class BaselineVerdict : uint8_t { NO_BASELINE, TOO_FEW_SAMPLES, UNCHANGED, FASTER, SLOWER };
+
+const char* baseline_verdict_name(BaselineVerdict verdict);
+
+// When a difference between two sets of samples counts
+struct BaselineCriteria {
+  // significance level of the one-sided test
+  double alpha = 0.01;
+  // smallest relative change of the median worth reporting
+  double min_change = 0.05;
+  // samples needed on each side; with fewer the test has no power
+  std::size_t min_samples = 5;
+};
+
+struct BaselineComparison {
+  BaselineVerdict verdict = BaselineVerdict::NO_BASELINE;
+  double baseline_median = 0.0;
+  double current_median = 0.0;
+  // current_median / baseline_median: above 1 is slower
+  double ratio = 0.0;
+  // one-sided p-value in the direction of the change
+  double p_value = 1.0;
+};
+
+// Mann-Whitney U test of the per-iteration samples, which needs no normality
+// and is robust to the occasional preempted iteration. A change is SLOWER or
+// FASTER only if it is significant at criteria.alpha and the medians differ by
+// at least criteria.min_change.
+BaselineComparison compare_samples(const std::vector<double>& baseline, const std::vector<double>& current,
+                                   const BaselineCriteria& criteria = {});
+
+// Baselines in a directory: one text file per measurement, named after the
+// backend, task, type of running, problem size, processes and threads, under
+// a subdirectory per machine fingerprint. Files are replaced through a
+// temporary and a rename, so concurrent writers do not tear them.
+class BaselineStore {
+ public:
+  enum class Mode : uint8_t {
+    // compare with the stored baseline, storing the run if there is none
+    COMPARE,
+    // replace the stored baseline with the run
+    UPDATE
+  };
+
+  explicit BaselineStore(std::string directory, Mode mode = Mode::COMPARE,
+                         MachineFingerprint machine = MachineFingerprint::detect());
+
+  // Store in PPC_PERF_BASELINE, or nullptr if it is not set. PPC_PERF_BASELINE_MODE
+  // is "compare" (default) or "update"; PPC_PERF_BASELINE_ALPHA and
+  // PPC_PERF_BASELINE_MIN_CHANGE override the criteria. Throws
+  // std::invalid_argument for an unknown mode.
+  static std::unique_ptr<BaselineStore> from_env();
+
+  [[nodiscard]] std::string path(const PerfRecord& record) const;
+  // nothing if there is no baseline or the file is damaged
+  [[nodiscard]] std::optional<Baseline> find(const PerfRecord& record) const;
+  // throws std::runtime_error if the file cannot be written
+  void store(const PerfRecord& record) const;
+
+  // compare the samples of record with its baseline, then store them if there
+  // was none or the mode is UPDATE
+  BaselineComparison check(const PerfRecord& record) const;
+  // what check() counts as a change
+  BaselineCriteria criteria;
+
+  [[nodiscard]] const std::string& directory() const { return directory_; }
+  [[nodiscard]] Mode mode() const { return mode_; }
+  [[nodiscard]] const MachineFingerprint& machine() const { return machine_; }
+
+ private:
+  std::string directory_;
+  Mode mode_;
+  MachineFingerprint machine_;
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_BASELINE_HPP_
@@ -0,0 +1,61 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_HW_COUNTERS_HPP_
+#define MODULES_CORE_INCLUDE_HW_COUNTERS_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace ppc::core {
+
+enum class HwCounter : std::uint8_t { CYCLES, INSTRUCTIONS, LLC_MISSES, BRANCH_MISSES, DTLB_MISSES };
+
+constexpr std::size_t kNumHwCounters = 5;
+
+const char* hw_counter_name(HwCounter counter);
+
+// Totals over the measured runs. A counter is valid only if the kernel let
+// us open it (perf_event_paranoid, containers and VMs often forbid some or
+// all of them); values of invalid counters are zero.
+//
+// Only the measuring thread and the threads started after the counters were
+// opened are counted. Perf opens them before it first calls the task, so an
+// OpenMP or TBB pool the task starts, even in its warmup, is included; a pool
+// that already exists (started by an earlier test in the same process) is not,
+// and its work is missing from the totals.
+struct HwCounterReadings {
+  std::array<std::uint64_t, kNumHwCounters> values{};
+  std::array<bool, kNumHwCounters> valid{};
+
+  [[nodiscard]] bool available() const;
+  [[nodiscard]] bool is_valid(HwCounter counter) const { return valid[static_cast<std::size_t>(counter)]; }
+  [[nodiscard]] std::uint64_t value(HwCounter counter) const { return values[static_cast<std::size_t>(counter)]; }
+  // instructions per cycle, 0 if either counter is missing
+  [[nodiscard]] double ipc() const;
+};
+
+// User-space hardware counters of the calling thread (and threads it spawns
+// later, see HwCounterReadings) via perf_event_open. The counters are opened
+// disabled; start() zeroes and enables them.
+// Every counter is opened separately so a missing one does not disable the
+// rest. On platforms without perf events the collector is always empty.
+class HwCounterCollector {
+ public:
+  HwCounterCollector();
+  ~HwCounterCollector();
+  HwCounterCollector(const HwCounterCollector&) = delete;
+  HwCounterCollector& operator=(const HwCounterCollector&) = delete;
+
+  [[nodiscard]] bool available() const;
+  void start();
+  void stop();
+  [[nodiscard]] HwCounterReadings read() const;
+
+ private:
+  std::array<int, kNumHwCounters> fds_;
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_HW_COUNTERS_HPP_
@@ -3,29 +3,132 @@
 #ifndef MODULES_CORE_INCLUDE_PERF_HPP_
 #define MODULES_CORE_INCLUDE_PERF_HPP_
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <optional>
+#include <string>
+#include <utility>
 #include <vector>
 
+#include "core/perf/include/alloc_tracker.hpp"
+#include "core/perf/include/hw_counters.hpp"
+#include "core/placement/include/placement.hpp"
 #include "core/task/include/task.hpp"
 
 namespace ppc {
 namespace core {
 
+// Spread of one timing over the ranks of a communicator
+struct RankSpread {
+  double min = 0.0;
+  double max = 0.0;
+  double mean = 0.0;
+  // max / mean: 1 for perfectly balanced ranks, grows with the straggler
+  [[nodiscard]] double imbalance() const { return mean > 0.0 ? max / mean : 0.0; }
+};
+
+// Cross-rank view of a perf run: whole measurement and mean time of one call
+// of each stage
+struct RankTimings {
+  int num_ranks = 0;
+  RankSpread total;
+  std::array<RankSpread, kNumTaskStages> stages;
+  [[nodiscard]] bool available() const { return num_ranks > 0; }
+};
+
+struct PerfResults;
+
 struct PerfAttr {
   // count of task's running
   uint64_t num_running;
+  // count of untimed runs before measurement (cold caches, first-touch)
+  uint64_t num_warmup = 0;
+  // if positive, num_running is calibrated so that measurement takes about
+  // this long (in seconds), but never more than max_running runs
+  double target_time_sec = 0.0;
+  uint64_t max_running = 1000000;
+  // read hardware counters around the measured runs, see hw_counters.hpp
+  bool collect_hw_counters = false;
+  // heap allocations allowed over all measured runs; exceeding it is reported
+  // to TimeLimitPolicy::on_allocation_violation. Checked only in binaries
+  // counting allocations, see alloc_tracker.hpp
+  std::optional<uint64_t> max_allocations;
   std::function<double(void)> current_timer = [&] { return 0.0; };
+  // collective reduction of the per-rank results, called on every rank after
+  // the measured runs; see core/mpi/include/perf_reduce.hpp
+  std::function<RankTimings(const PerfResults&)> reduce_across_ranks;
+  // collective maximum of a value over the ranks, called on every rank while
+  // calibrating so that all of them settle on the same num_running; required
+  // for target_time_sec together with reduce_across_ranks
+  std::function<double(double)> max_across_ranks;
 };
 
+// Summary of per-iteration samples (in seconds)
+struct PerfStatistics {
+  double min = 0.0;
+  double max = 0.0;
+  double mean = 0.0;
+  double median = 0.0;
+  double p95 = 0.0;
+  double p99 = 0.0;
+  double stddev = 0.0;
+};
+
+PerfStatistics compute_statistics(std::vector<double> samples);
+
 struct PerfResults {
   // measurement of task's time (in seconds)
   double time_sec = 0.0;
   enum TypeOfRunning { PIPELINE, TASK_RUN, NONE } type_of_running = NONE;
+  // total element count of the task's inputs
+  uint64_t problem_size = 0;
+  // runs actually performed (num_running may come from calibration)
+  uint64_t num_running = 0;
+  uint64_t num_warmup = 0;
+  // time of every measured run and statistics over them
+  std::vector<double> samples_sec;
+  PerfStatistics statistics;
+  // totals over the measured runs; empty if not requested or not permitted
+  HwCounterReadings hw_counters;
+  // time of validation / pre_processing / run / post_processing over the
+  // measured runs (task_run measures run() only)
+  StageTimings stage_timings;
+  // heap allocations over the measured runs, in total and per stage; zero
+  // unless allocation_tracking()
+  AllocationStats allocations;
+  std::array<AllocationStats, kNumTaskStages> stage_allocations;
+  // filled if PerfAttr::reduce_across_ranks is set
+  RankTimings rank_timings;
+  // problem instances per run: the batch size of a BatchTask, 1 otherwise
+  uint64_t num_instances = 1;
+  // pinning policy and CPUs of the measuring thread, see placement.hpp
+  Placement placement;
+  // work of one run() as declared by the task, see Task::work()
+  TaskWork work;
+  // figures a perf test adds about its task (e.g. checkpoint overhead), as
+  // name and value; printed with the statistics and kept in JSON records
+  std::vector<std::pair<std::string, double>> metrics;
+  // mean time of one instance (in seconds)
+  [[nodiscard]] double time_per_instance() const {
+    return num_instances == 0 ? 0.0 : statistics.mean / static_cast<double>(num_instances);
+  }
+  // declared work of one run() over the mean time of run(); 0 if the task
+  // declares none
+  [[nodiscard]] double bandwidth_gbs() const;
+  [[nodiscard]] double gflops() const;
+  // default of TimeLimitPolicy::perf_limit_sec
   constexpr const static double MAX_TIME = 10.0;
 };
 
+// Source file of the running test; perf results are named after it. The gtest
+// adapter (core/testing) installs a provider, otherwise it returns "".
+using TestPathProvider = std::function<std::string()>;
+void set_test_path_provider(TestPathProvider provider);
+std::string current_test_path();
+
 class Perf {
  public:
   // Init performance analysis with initialized task and initialized data
@@ -39,13 +142,48 @@ class Perf {
                     const std::shared_ptr<ppc::core::PerfResults>& perfResults);
   // Check performance of task's run() function
   void task_run(const std::shared_ptr<PerfAttr>& perfAttr, const std::shared_ptr<ppc::core::PerfResults>& perfResults);
-  // Pint results for automation checkers
+  // Pint results for automation checkers; the test file path comes from the
+  // provider set by set_test_path_provider()
   static void print_perf_statistic(const std::shared_ptr<PerfResults>& perfResults);
+  static void print_perf_statistic(const std::shared_ptr<PerfResults>& perfResults, const std::string& test_file_path);
 
  private:
   std::shared_ptr<Task> task;
-  static void common_run(const std::shared_ptr<PerfAttr>& perfAttr, const std::function<void()>& pipeline,
-                         const std::shared_ptr<ppc::core::PerfResults>& perfResults);
+  // opened before the task is first called and enabled only around the
+  // measured runs, so threads its warmup starts are counted as well
+  std::unique_ptr<HwCounterCollector> counters;
+  void open_counters(const PerfAttr& perfAttr);
+  void common_run(const std::shared_ptr<PerfAttr>& perfAttr, const std::function<void()>& pipeline,
+                  const std::shared_ptr<ppc::core::PerfResults>& perfResults);
+  static uint64_t calibrate(const std::shared_ptr<PerfAttr>& perfAttr, const std::function<void()>& pipeline);
+
+  // allocation accounting of the measured runs
+  bool measuring = false;
+  AllocationSnapshot measure_start;
+  std::uint64_t measure_peak = 0;
+  std::array<AllocationStats, kNumTaskStages> stage_allocations;
+
+  template <class Call>
+  void run_stage(TaskStage stage, Call&& call) {
+    if (!measuring) {
+      call();
+      return;
+    }
+    auto before = allocation_snapshot();
+    reset_allocation_peak();
+    call();
+    auto after = allocation_snapshot();
+    auto& stats = stage_allocations[static_cast<size_t>(stage)];
+    stats.count += after.count - before.count;
+    stats.bytes += after.bytes - before.bytes;
+    // other threads may free memory meanwhile, so the peak can end up below the start
+    if (after.peak_bytes > before.live_bytes) {
+      stats.peak_bytes = std::max(stats.peak_bytes, after.peak_bytes - before.live_bytes);
+    }
+    if (after.peak_bytes > measure_start.live_bytes) {
+      measure_peak = std::max(measure_peak, after.peak_bytes - measure_start.live_bytes);
+    }
+  }
 };
 
 }  // namespace core
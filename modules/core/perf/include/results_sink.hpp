@@ -0,0 +1,73 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_RESULTS_SINK_HPP_
+#define MODULES_CORE_INCLUDE_RESULTS_SINK_HPP_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/perf/include/perf.hpp"
+
+namespace ppc::core {
+
+// One perf measurement together with where and how it was taken
+struct PerfRecord {
+  // task directory name and backend (mpi/omp/seq/stl/tbb), e.g. "example", "seq"
+  std::string task_id;
+  std::string backend;
+  // "pipeline" or "task_run"
+  std::string type_of_running;
+  std::string host;
+  int num_procs = 1;
+  int num_threads = 1;
+  // set when run from a scaling sweep
+  std::string scaling = "none";
+  int workers = 1;
+  PerfResults results;
+};
+
+// Fill task id and backend from a path containing "tasks/<backend>/<task>"
+// (e.g. the perf test source file) and the rest
+// from the environment (MPI launcher variables, thread count of the backend,
+// scaling sweep settings, host name); num_threads is 1 for seq and mpi
+PerfRecord make_perf_record(const std::string& task_path, const PerfResults& results);
+
+const char* type_of_running_name(PerfResults::TypeOfRunning type);
+
+// Appends perf records to a file as JSON lines or CSV
+class ResultsSink {
+ public:
+  enum class Format { JSON_LINES, CSV };
+
+  ResultsSink(std::string path, Format format);
+
+  // Sink configured by the PPC_PERF_RESULTS variable (CSV if the path ends
+  // with .csv, JSON lines otherwise), or nullptr if it is not set
+  static std::unique_ptr<ResultsSink> from_env();
+
+  // throws std::runtime_error if the file cannot be opened or, for CSV,
+  // starts with a header other than csv_header()
+  void write(const PerfRecord& record) const;
+
+  [[nodiscard]] const std::string& path() const { return path_; }
+  [[nodiscard]] Format format() const { return format_; }
+
+  static std::string to_json(const PerfRecord& record);
+  static std::string csv_header();
+  static std::string to_csv(const PerfRecord& record);
+
+  // Records of a file written by write(), CSV if the path ends with .csv;
+  // only the flat fields are read back (no samples, stages or counters).
+  // Returns nothing if the file does not exist.
+  static std::vector<PerfRecord> read(const std::string& path);
+
+ private:
+  std::string path_;
+  Format format_;
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_RESULTS_SINK_HPP_
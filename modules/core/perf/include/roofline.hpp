@@ -0,0 +1,61 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_ROOFLINE_HPP_
+#define MODULES_CORE_INCLUDE_ROOFLINE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "core/perf/include/perf.hpp"
+
+namespace ppc::core {
+
+// Work of C = A * B with A m x k and B k x n: A and B read and C written once,
+// a multiply and an add per term
+inline TaskWork matmul_work(std::uint64_t m, std::uint64_t k, std::uint64_t n, std::size_t element_size) {
+  return {(m * k + k * n + m * n) * element_size, 2 * m * n * k};
+}
+
+// Peak rates of this machine as built-in kernels compiled with the course's
+// flags reach them, so a task is compared with what its own code could attain
+struct MachinePeak {
+  // STREAM triad a[i] = b[i] + s * c[i] over arrays far larger than the
+  // caches, counting 24 bytes per element as STREAM does
+  double bandwidth_gbs = 0.0;
+  // independent multiply-add chains, 2 operations per update
+  double gflops = 0.0;
+  // workers the kernels ran on
+  int threads = 0;
+
+  [[nodiscard]] bool available() const { return bandwidth_gbs > 0.0 && gflops > 0.0; }
+  // operations per byte at which a kernel stops being memory bound
+  [[nodiscard]] double ridge_point() const { return available() ? gflops / bandwidth_gbs : 0.0; }
+
+  // best of a few repetitions on threads workers, one per CPU the process may
+  // use if threads is 0; takes a few tenths of a second
+  static MachinePeak measure(int threads = 0);
+  // "<GB/s>,<GFLOP/s>" from PPC_MACHINE_PEAK if set (e.g. measured once on a
+  // quiet machine), otherwise measure() on first use and kept for the process
+  static const MachinePeak& get();
+};
+
+// Where a perf measurement lies on the roofline of the machine
+struct RooflinePoint {
+  // declared work of one run() over its mean time
+  double bandwidth_gbs = 0.0;
+  double gflops = 0.0;
+  // operations per byte, 0 if the task moves no bytes
+  double intensity = 0.0;
+  // min(peak GFLOP/s, intensity * peak GB/s): the best the kernel can do
+  double attainable_gflops = 0.0;
+  // achieved share of the attainable rate; of the peak bandwidth for kernels
+  // declaring bytes only
+  double efficiency = 0.0;
+};
+
+// 0 throughout if the task declares no work or run() was not timed
+RooflinePoint roofline_point(const PerfResults& results, const MachinePeak& peak);
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_ROOFLINE_HPP_
@@ -0,0 +1,34 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_SCALING_HPP_
+#define MODULES_CORE_INCLUDE_SCALING_HPP_
+
+#include <cstdint>
+
+namespace ppc::core {
+
+// Scaling sweeps rerun a perf test with 1..N workers (ranks or threads):
+// strong scaling keeps the total problem size, weak scaling keeps the size
+// per worker. See scripts/run_scaling_sweep.sh.
+enum class ScalingMode : std::uint8_t { NONE, STRONG, WEAK };
+
+const char* scaling_mode_name(ScalingMode mode);
+
+struct ScalingConfig {
+  ScalingMode mode = ScalingMode::NONE;
+  int workers = 1;
+
+  // PPC_SCALING_MODE ("strong" or "weak") and PPC_NUM_WORKERS
+  static ScalingConfig from_env();
+
+  // problem size to use in a perf test given its size for one worker
+  [[nodiscard]] std::uint64_t problem_size(std::uint64_t base_size) const;
+};
+
+// PPC_NUM_THREADS if set, hardware concurrency otherwise; threaded tasks
+// should size their pools with it so sweeps can vary the thread count
+int get_num_threads();
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_SCALING_HPP_
@@ -0,0 +1,42 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/perf/include/alloc_tracker.hpp"
+
+#include <atomic>
+
+namespace {
+
+std::atomic<bool> tracking{false};
+std::atomic<std::uint64_t> allocation_count{0};
+std::atomic<std::uint64_t> allocation_bytes{0};
+std::atomic<std::uint64_t> live_bytes{0};
+std::atomic<std::uint64_t> peak_bytes{0};
+
+}  // namespace
+
+bool ppc::core::allocation_tracking() { return tracking.load(std::memory_order_relaxed); }
+
+ppc::core::AllocationSnapshot ppc::core::allocation_snapshot() {
+  AllocationSnapshot snapshot;
+  snapshot.count = allocation_count.load(std::memory_order_relaxed);
+  snapshot.bytes = allocation_bytes.load(std::memory_order_relaxed);
+  snapshot.live_bytes = live_bytes.load(std::memory_order_relaxed);
+  snapshot.peak_bytes = peak_bytes.load(std::memory_order_relaxed);
+  return snapshot;
+}
+
+void ppc::core::reset_allocation_peak() {
+  peak_bytes.store(live_bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+void ppc::core::detail::enable_allocation_tracking() { tracking.store(true, std::memory_order_relaxed); }
+
+void ppc::core::detail::record_allocation(std::size_t size) {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  allocation_bytes.fetch_add(size, std::memory_order_relaxed);
+  auto live = live_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+  auto peak = peak_bytes.load(std::memory_order_relaxed);
+  while (live > peak && !peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+  }
+}
+
+void ppc::core::detail::record_free(std::size_t size) { live_bytes.fetch_sub(size, std::memory_order_relaxed); }
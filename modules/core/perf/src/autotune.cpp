@@ -0,0 +1,213 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/perf/include/autotune.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <random>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+std::string format_config(const ppc::core::TuneConfig& config) {
+  std::string str;
+  for (const auto& [name, value] : config) {
+    str += (str.empty() ? "" : ",") + name + "=" + std::to_string(value);
+  }
+  return str;
+}
+
+ppc::core::TuneConfig parse_config(const std::string& str) {
+  ppc::core::TuneConfig config;
+  std::stringstream in(str);
+  for (std::string item; std::getline(in, item, ',');) {
+    auto eq = item.find('=');
+    if (eq != std::string::npos) {
+      config[item.substr(0, eq)] = std::strtoll(item.c_str() + eq + 1, nullptr, 10);
+    }
+  }
+  return config;
+}
+
+}  // namespace
+
+ppc::core::TuningCache::TuningCache(std::string path) : path_(std::move(path)) {}
+
+ppc::core::TuningCache ppc::core::TuningCache::from_env() {
+  const char* path = std::getenv("PPC_TUNING_CACHE");
+  return TuningCache(path != nullptr && *path != '\0' ? path : "ppc_tuning_cache.txt");
+}
+
+std::map<std::string, ppc::core::TunedEntry> ppc::core::TuningCache::load() const {
+  std::map<std::string, TunedEntry> entries;
+  std::ifstream in(path_);
+  for (std::string line; std::getline(in, line);) {
+    std::stringstream fields(line);
+    std::string key;
+    std::string config;
+    std::string time;
+    if (std::getline(fields, key, '\t') && std::getline(fields, config, '\t') && std::getline(fields, time)) {
+      entries[key] = {parse_config(config), std::strtod(time.c_str(), nullptr)};
+    }
+  }
+  return entries;
+}
+
+std::optional<ppc::core::TunedEntry> ppc::core::TuningCache::find(const std::string& key) const {
+  auto entries = load();
+  auto it = entries.find(key);
+  if (it == entries.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+void ppc::core::TuningCache::store(const std::string& key, const TunedEntry& entry) const {
+  if (key.empty() || key.find_first_of("\t\n") != std::string::npos) {
+    throw std::invalid_argument("Tuning key must be a non-empty single field: " + key);
+  }
+  auto entries = load();
+  entries[key] = entry;
+
+  std::random_device random;
+  auto temp_path = path_ + ".tmp" + std::to_string(random());
+  {
+    std::ofstream out(temp_path, std::ios::trunc);
+    if (!out.is_open()) {
+      throw std::runtime_error("Cannot write tuning cache: " + temp_path);
+    }
+    for (const auto& [name, value] : entries) {
+      out << name << '\t' << format_config(value.config) << '\t' << std::setprecision(10) << value.time_sec << '\n';
+    }
+  }
+  std::error_code error;
+  std::filesystem::rename(temp_path, path_, error);
+  if (error) {
+    std::filesystem::remove(temp_path, error);
+    throw std::runtime_error("Cannot write tuning cache: " + path_);
+  }
+}
+
+int64_t ppc::core::TuningCache::value(const std::string& key, const std::string& name, int64_t fallback) const {
+  auto entry = find(key);
+  if (!entry) {
+    return fallback;
+  }
+  auto it = entry->config.find(name);
+  return it != entry->config.end() ? it->second : fallback;
+}
+
+int64_t ppc::core::tuned_value(const std::string& key, const std::string& name, int64_t fallback) {
+  return TuningCache::from_env().value(key, name, fallback);
+}
+
+ppc::core::AutoTuner::AutoTuner(std::string key_, std::vector<TuneParameter> space_, TuningCache cache_)
+    : key(std::move(key_)), space(std::move(space_)), cache_(std::move(cache_)) {
+  std::set<std::string> names;
+  for (const auto& parameter : space) {
+    if (parameter.values.empty()) {
+      throw std::invalid_argument("Tuning parameter without values: " + parameter.name);
+    }
+    if (parameter.name.empty() || parameter.name.find_first_of("=,\t\n") != std::string::npos ||
+        !names.insert(parameter.name).second) {
+      throw std::invalid_argument("Bad or repeated tuning parameter name: " + parameter.name);
+    }
+  }
+}
+
+std::vector<ppc::core::TuneConfig> ppc::core::AutoTuner::configurations() const {
+  std::vector<TuneConfig> configs(1);
+  for (const auto& parameter : space) {
+    std::vector<TuneConfig> extended;
+    extended.reserve(configs.size() * parameter.values.size());
+    for (const auto& config : configs) {
+      for (auto value : parameter.values) {
+        extended.push_back(config);
+        extended.back()[parameter.name] = value;
+      }
+    }
+    configs = std::move(extended);
+  }
+  return configs;
+}
+
+ppc::core::TuneConfig ppc::core::AutoTuner::defaults() const {
+  TuneConfig config;
+  for (const auto& parameter : space) {
+    config[parameter.name] = parameter.values.front();
+  }
+  return config;
+}
+
+bool ppc::core::AutoTuner::fits(const TuneConfig& config) const {
+  if (config.size() != space.size()) {
+    return false;
+  }
+  return std::all_of(space.begin(), space.end(), [&](const TuneParameter& parameter) {
+    auto it = config.find(parameter.name);
+    return it != config.end() &&
+           std::find(parameter.values.begin(), parameter.values.end(), it->second) != parameter.values.end();
+  });
+}
+
+ppc::core::TuneConfig ppc::core::AutoTuner::lookup() const {
+  auto entry = cache_.find(key);
+  return entry && fits(entry->config) ? entry->config : defaults();
+}
+
+bool ppc::core::AutoTuner::is_tuned() const {
+  auto entry = cache_.find(key);
+  return entry && fits(entry->config);
+}
+
+ppc::core::TuneConfig ppc::core::AutoTuner::tune(const TaskFactory& factory,
+                                                 const std::shared_ptr<PerfAttr>& perfAttr) {
+  if (perfAttr->reduce_across_ranks && !perfAttr->max_across_ranks) {
+    throw std::invalid_argument("Tuning " + key + " across ranks needs PerfAttr::max_across_ranks");
+  }
+  measured.clear();
+  TunedEntry best{{}, std::numeric_limits<double>::infinity()};
+  for (const auto& config : configurations()) {
+    auto task = factory(config);
+    // MPI tasks often validate on one rank only; a configuration is skipped on
+    // all ranks or on none, so they keep running the same pipelines
+    double failed = task->validation() ? 0.0 : 1.0;
+    if (perfAttr->max_across_ranks) {
+      failed = perfAttr->max_across_ranks(failed);
+    }
+    if (failed > 0.0) {
+      continue;
+    }
+    task->pre_processing();
+    task->run();
+    task->post_processing();
+
+    auto perfResults = std::make_shared<PerfResults>();
+    Perf perf(task);
+    perf.pipeline_run(perfAttr, perfResults);
+    auto time = perfResults->statistics.mean;
+    const auto& ranks = perfResults->rank_timings;
+    if (ranks.available() && perfResults->num_running > 0) {
+      time = ranks.total.max / static_cast<double>(perfResults->num_running);
+    }
+    measured.emplace_back(config, time);
+    if (time < best.time_sec) {
+      best = {config, time};
+    }
+  }
+  if (measured.empty()) {
+    throw std::runtime_error("No configuration of " + key + " passed validation");
+  }
+  cache_.store(key, best);
+  return best.config;
+}
+
+ppc::core::TuneConfig ppc::core::AutoTuner::get(const TaskFactory& factory,
+                                                const std::shared_ptr<PerfAttr>& perfAttr) {
+  return is_tuned() ? lookup() : tune(factory, perfAttr);
+}
@@ -0,0 +1,296 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/perf/include/baseline.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/utsname.h>
+#endif
+
+namespace {
+
+constexpr const char* kBaselineMagic = "ppc-baseline 1";
+
+#if defined(__linux__)
+// value after the colon of the first line of a /proc file starting with key
+std::string proc_field(const char* file, const std::string& key) {
+  std::ifstream in(file);
+  for (std::string line; std::getline(in, line);) {
+    if (line.compare(0, key.size(), key) == 0) {
+      auto colon = line.find(':');
+      if (colon == std::string::npos) {
+        continue;
+      }
+      auto begin = line.find_first_not_of(" \t", colon + 1);
+      return begin == std::string::npos ? std::string() : line.substr(begin);
+    }
+  }
+  return {};
+}
+#endif
+
+// letters, digits, '.', '_' and '-' as they are, '_' for the rest
+std::string file_name_part(const std::string& str) {
+  std::string part;
+  for (char c : str) {
+    auto safe = std::isalnum(static_cast<unsigned char>(c)) != 0 || c == '.' || c == '_' || c == '-';
+    part += safe ? c : '_';
+  }
+  return part.empty() ? std::string("_") : part;
+}
+
+double median(std::vector<double> samples) { return ppc::core::compute_statistics(std::move(samples)).median; }
+
+// upper tail of the standard normal distribution
+double normal_upper_tail(double z) { return 0.5 * std::erfc(z / std::sqrt(2.0)); }
+
+double env_double(const char* name, double fallback) {
+  const char* value = std::getenv(name);
+  return value != nullptr && *value != '\0' ? std::strtod(value, nullptr) : fallback;
+}
+
+}  // namespace
+
+ppc::core::MachineFingerprint ppc::core::MachineFingerprint::from_description(std::string description) {
+  MachineFingerprint machine;
+  uint64_t hash = 14695981039346656037ULL;
+  for (char c : description) {
+    hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+  }
+  std::stringstream id;
+  id << std::hex << std::setw(16) << std::setfill('0') << hash;
+  machine.description = std::move(description);
+  machine.id = id.str();
+  return machine;
+}
+
+ppc::core::MachineFingerprint ppc::core::MachineFingerprint::detect() {
+  std::string cpu;
+  std::string memory;
+  std::string os = "unknown";
+#if defined(__linux__)
+  // "model name" on x86, "Hardware" or "CPU part" on some ARM kernels
+  for (const char* key : {"model name", "Hardware", "CPU part"}) {
+    cpu = proc_field("/proc/cpuinfo", key);
+    if (!cpu.empty()) {
+      break;
+    }
+  }
+  auto kilobytes = std::strtoull(proc_field("/proc/meminfo", "MemTotal").c_str(), nullptr, 10);
+  if (kilobytes > 0) {
+    // rounded, so memory taken by the firmware or a kernel update does not change it
+    memory = std::to_string((kilobytes + (1ULL << 19)) >> 20) + " GiB";
+  }
+#endif
+#if defined(__linux__) || defined(__APPLE__)
+  utsname name{};
+  if (uname(&name) == 0) {
+    os = name.sysname;
+    os += ' ';
+    os += name.machine;
+  }
+#elif defined(_WIN32)
+  os = "Windows";
+#endif
+  std::string description = cpu.empty() ? "unknown cpu" : cpu;
+  description += '|';
+  description += std::to_string(std::thread::hardware_concurrency());
+  description += " cpus";
+  if (!memory.empty()) {
+    description += '|';
+    description += memory;
+  }
+  description += '|';
+  description += os;
+  return from_description(description);
+}
+
+const char* ppc::core::baseline_verdict_name(BaselineVerdict verdict) {
+  switch (verdict) {
+    case BaselineVerdict::TOO_FEW_SAMPLES:
+      return "too_few_samples";
+    case BaselineVerdict::UNCHANGED:
+      return "unchanged";
+    case BaselineVerdict::FASTER:
+      return "faster";
+    case BaselineVerdict::SLOWER:
+      return "slower";
+    default:
+      return "no_baseline";
+  }
+}
+
+ppc::core::BaselineComparison ppc::core::compare_samples(const std::vector<double>& baseline,
+                                                         const std::vector<double>& current,
+                                                         const BaselineCriteria& criteria) {
+  BaselineComparison comparison;
+  if (baseline.empty()) {
+    return comparison;
+  }
+  comparison.baseline_median = median(baseline);
+  comparison.current_median = median(current);
+  if (comparison.baseline_median > 0.0) {
+    comparison.ratio = comparison.current_median / comparison.baseline_median;
+  } else {
+    comparison.ratio = comparison.current_median > 0.0 ? std::numeric_limits<double>::infinity() : 1.0;
+  }
+  auto min_samples = std::max<std::size_t>(criteria.min_samples, 1);
+  if (baseline.size() < min_samples || current.size() < min_samples) {
+    comparison.verdict = BaselineVerdict::TOO_FEW_SAMPLES;
+    return comparison;
+  }
+
+  // ranks of the pooled samples, ties sharing their mean rank
+  std::vector<std::pair<double, bool>> pooled;
+  pooled.reserve(baseline.size() + current.size());
+  for (auto sample : baseline) {
+    pooled.emplace_back(sample, false);
+  }
+  for (auto sample : current) {
+    pooled.emplace_back(sample, true);
+  }
+  std::sort(pooled.begin(), pooled.end());
+  double current_rank_sum = 0.0;
+  double ties = 0.0;
+  for (std::size_t begin = 0; begin < pooled.size();) {
+    auto end = begin;
+    while (end < pooled.size() && pooled[end].first == pooled[begin].first) {
+      end++;
+    }
+    auto count = static_cast<double>(end - begin);
+    auto rank = static_cast<double>(begin + end + 1) / 2.0;
+    for (auto i = begin; i < end; i++) {
+      current_rank_sum += pooled[i].second ? rank : 0.0;
+    }
+    ties += count * count * count - count;
+    begin = end;
+  }
+
+  // U counts the pairs in which the current sample is the larger one; normal
+  // approximation with tie and continuity corrections
+  auto n1 = static_cast<double>(baseline.size());
+  auto n2 = static_cast<double>(current.size());
+  auto n = n1 + n2;
+  auto u = current_rank_sum - n2 * (n2 + 1.0) / 2.0;
+  auto mean = n1 * n2 / 2.0;
+  auto variance = n1 * n2 / 12.0 * ((n + 1.0) - ties / (n * (n - 1.0)));
+  double p_slower = 1.0;
+  double p_faster = 1.0;
+  if (variance > 0.0) {
+    p_slower = std::min(1.0, normal_upper_tail((u - mean - 0.5) / std::sqrt(variance)));
+    p_faster = std::min(1.0, normal_upper_tail((mean - u - 0.5) / std::sqrt(variance)));
+  }
+
+  comparison.p_value = comparison.ratio >= 1.0 ? p_slower : p_faster;
+  comparison.verdict = BaselineVerdict::UNCHANGED;
+  if (comparison.ratio >= 1.0 + criteria.min_change && p_slower < criteria.alpha) {
+    comparison.verdict = BaselineVerdict::SLOWER;
+  } else if (comparison.ratio * (1.0 + criteria.min_change) <= 1.0 && p_faster < criteria.alpha) {
+    comparison.verdict = BaselineVerdict::FASTER;
+  }
+  return comparison;
+}
+
+ppc::core::BaselineStore::BaselineStore(std::string directory, Mode mode, MachineFingerprint machine)
+    : directory_(std::move(directory)), mode_(mode), machine_(std::move(machine)) {}
+
+std::unique_ptr<ppc::core::BaselineStore> ppc::core::BaselineStore::from_env() {
+  const char* directory = std::getenv("PPC_PERF_BASELINE");
+  if (directory == nullptr || *directory == '\0') {
+    return nullptr;
+  }
+  const char* mode_name = std::getenv("PPC_PERF_BASELINE_MODE");
+  std::string mode_str = mode_name != nullptr ? mode_name : "";
+  Mode mode = Mode::COMPARE;
+  if (mode_str == "update") {
+    mode = Mode::UPDATE;
+  } else if (!mode_str.empty() && mode_str != "compare") {
+    throw std::invalid_argument("PPC_PERF_BASELINE_MODE must be compare or update: " + mode_str);
+  }
+  auto store = std::make_unique<BaselineStore>(directory, mode);
+  store->criteria.alpha = env_double("PPC_PERF_BASELINE_ALPHA", store->criteria.alpha);
+  store->criteria.min_change = env_double("PPC_PERF_BASELINE_MIN_CHANGE", store->criteria.min_change);
+  return store;
+}
+
+std::string ppc::core::BaselineStore::path(const PerfRecord& record) const {
+  auto name = file_name_part(record.backend) + "-" + file_name_part(record.task_id) + "-" +
+              file_name_part(record.type_of_running) + "-n" + std::to_string(record.results.problem_size) + "-p" +
+              std::to_string(record.num_procs) + "-t" + std::to_string(record.num_threads) + ".txt";
+  return (std::filesystem::path(directory_) / machine_.id / name).string();
+}
+
+std::optional<ppc::core::Baseline> ppc::core::BaselineStore::find(const PerfRecord& record) const {
+  std::ifstream in(path(record));
+  std::string line;
+  if (!std::getline(in, line) || line != kBaselineMagic) {
+    return std::nullopt;
+  }
+  Baseline baseline;
+  std::size_t count = 0;
+  std::string key;
+  if (!std::getline(in, line) || line.compare(0, 8, "machine ") != 0) {
+    return std::nullopt;
+  }
+  baseline.machine = line.substr(8);
+  if (!(in >> key >> count) || key != "samples") {
+    return std::nullopt;
+  }
+  baseline.samples_sec.resize(count);
+  for (auto& sample : baseline.samples_sec) {
+    if (!(in >> sample)) {
+      return std::nullopt;
+    }
+  }
+  return baseline;
+}
+
+void ppc::core::BaselineStore::store(const PerfRecord& record) const {
+  auto final_path = path(record);
+  std::error_code error;
+  std::filesystem::create_directories(std::filesystem::path(final_path).parent_path(), error);
+
+  std::random_device random;
+  auto temp_path = final_path + ".tmp" + std::to_string(random());
+  {
+    std::ofstream out(temp_path, std::ios::trunc);
+    if (!out.is_open()) {
+      throw std::runtime_error("Cannot write perf baseline: " + temp_path);
+    }
+    out << kBaselineMagic << "\nmachine " << machine_.description << "\nsamples "
+        << record.results.samples_sec.size() << '\n'
+        << std::setprecision(17);
+    for (auto sample : record.results.samples_sec) {
+      out << sample << '\n';
+    }
+  }
+  std::filesystem::rename(temp_path, final_path, error);
+  if (error) {
+    std::filesystem::remove(temp_path, error);
+    throw std::runtime_error("Cannot write perf baseline: " + final_path);
+  }
+}
+
+ppc::core::BaselineComparison ppc::core::BaselineStore::check(const PerfRecord& record) const {
+  BaselineComparison comparison;
+  auto baseline = find(record);
+  if (baseline) {
+    comparison = compare_samples(baseline->samples_sec, record.results.samples_sec, criteria);
+  }
+  if ((!baseline || mode_ == Mode::UPDATE) && !record.results.samples_sec.empty()) {
+    store(record);
+  }
+  return comparison;
+}
@@ -0,0 +1,150 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/perf/include/hw_counters.hpp"
+
+#include <algorithm>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cmath>
+#include <cstring>
+#endif
+
+const char* ppc::core::hw_counter_name(HwCounter counter) {
+  switch (counter) {
+    case HwCounter::CYCLES:
+      return "cycles";
+    case HwCounter::INSTRUCTIONS:
+      return "instructions";
+    case HwCounter::LLC_MISSES:
+      return "llc_misses";
+    case HwCounter::BRANCH_MISSES:
+      return "branch_misses";
+    case HwCounter::DTLB_MISSES:
+      return "dtlb_misses";
+    default:
+      return "unknown";
+  }
+}
+
+bool ppc::core::HwCounterReadings::available() const {
+  return std::any_of(valid.begin(), valid.end(), [](bool v) { return v; });
+}
+
+double ppc::core::HwCounterReadings::ipc() const {
+  if (!is_valid(HwCounter::CYCLES) || !is_valid(HwCounter::INSTRUCTIONS) || value(HwCounter::CYCLES) == 0) {
+    return 0.0;
+  }
+  return static_cast<double>(value(HwCounter::INSTRUCTIONS)) / static_cast<double>(value(HwCounter::CYCLES));
+}
+
+#if defined(__linux__)
+
+namespace {
+
+int open_counter(std::uint32_t type, std::uint64_t config) {
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = type;
+  attr.config = config;
+  attr.disabled = 1;
+  // kernel and hypervisor events need privileges we usually do not have
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  // also count threads spawned by the task after the counters were opened
+  attr.inherit = 1;
+  attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+constexpr std::uint64_t cache_config(std::uint64_t cache, std::uint64_t op, std::uint64_t result) {
+  return cache | (op << 8) | (result << 16);
+}
+
+}  // namespace
+
+ppc::core::HwCounterCollector::HwCounterCollector() {
+  fds_[static_cast<std::size_t>(HwCounter::CYCLES)] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+  fds_[static_cast<std::size_t>(HwCounter::INSTRUCTIONS)] =
+      open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+  fds_[static_cast<std::size_t>(HwCounter::LLC_MISSES)] =
+      open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+  fds_[static_cast<std::size_t>(HwCounter::BRANCH_MISSES)] =
+      open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+  fds_[static_cast<std::size_t>(HwCounter::DTLB_MISSES)] =
+      open_counter(PERF_TYPE_HW_CACHE, cache_config(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ,
+                                                    PERF_COUNT_HW_CACHE_RESULT_MISS));
+}
+
+ppc::core::HwCounterCollector::~HwCounterCollector() {
+  for (auto fd : fds_) {
+    if (fd >= 0) {
+      close(fd);
+    }
+  }
+}
+
+void ppc::core::HwCounterCollector::start() {
+  for (auto fd : fds_) {
+    if (fd >= 0) {
+      ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+      ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+}
+
+void ppc::core::HwCounterCollector::stop() {
+  for (auto fd : fds_) {
+    if (fd >= 0) {
+      ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+  }
+}
+
+ppc::core::HwCounterReadings ppc::core::HwCounterCollector::read() const {
+  HwCounterReadings readings;
+  for (std::size_t i = 0; i < kNumHwCounters; i++) {
+    // value, time enabled, time running
+    std::uint64_t data[3] = {0, 0, 0};
+    if (fds_[i] < 0 || ::read(fds_[i], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data))) {
+      continue;
+    }
+    if (data[1] > 0 && data[2] == 0) {
+      // enabled but never scheduled on the PMU
+      continue;
+    }
+    readings.valid[i] = true;
+    // scale up if the kernel multiplexed the counter
+    if (data[2] > 0 && data[2] < data[1]) {
+      readings.values[i] = static_cast<std::uint64_t>(
+          std::llround(static_cast<double>(data[0]) * static_cast<double>(data[1]) / static_cast<double>(data[2])));
+    } else {
+      readings.values[i] = data[0];
+    }
+  }
+  return readings;
+}
+
+bool ppc::core::HwCounterCollector::available() const {
+  return std::any_of(fds_.begin(), fds_.end(), [](int fd) { return fd >= 0; });
+}
+
+#else
+
+ppc::core::HwCounterCollector::HwCounterCollector() { fds_.fill(-1); }
+
+ppc::core::HwCounterCollector::~HwCounterCollector() = default;
+
+void ppc::core::HwCounterCollector::start() {}
+
+void ppc::core::HwCounterCollector::stop() {}
+
+ppc::core::HwCounterReadings ppc::core::HwCounterCollector::read() const { return {}; }
+
+bool ppc::core::HwCounterCollector::available() const { return false; }
+
+#endif
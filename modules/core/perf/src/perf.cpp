@@ -1,13 +1,34 @@
 // Copyright 2023 Nesterov Alexander
 #include "core/perf/include/perf.hpp"
 
-#include <gtest/gtest.h>
-
+#include <algorithm>
+#include <cmath>
 #include <iomanip>
 #include <iostream>
+#include <memory>
+#include <numeric>
 #include <sstream>
+#include <stdexcept>
 #include <utility>
 
+#include "core/batch/include/batch.hpp"
+#include "core/perf/include/baseline.hpp"
+#include "core/perf/include/results_sink.hpp"
+#include "core/perf/include/roofline.hpp"
+#include "core/task/include/time_limit.hpp"
+
+namespace {
+
+void check_perf_attr(const ppc::core::PerfAttr& perfAttr) {
+  if (perfAttr.target_time_sec > 0.0 && perfAttr.reduce_across_ranks && !perfAttr.max_across_ranks) {
+    // every rank would calibrate its own run count and the collectives in the
+    // runs would no longer match
+    throw std::invalid_argument("PerfAttr::target_time_sec across ranks needs PerfAttr::max_across_ranks");
+  }
+}
+
+}  // namespace
+
 ppc::core::Perf::Perf(std::shared_ptr<Task> task_) { set_task(std::move(task_)); }
 
 void ppc::core::Perf::set_task(std::shared_ptr<Task> task_) {
@@ -17,26 +38,31 @@ void ppc::core::Perf::set_task(std::shared_ptr<Task> task_) {
 
 void ppc::core::Perf::pipeline_run(const std::shared_ptr<PerfAttr>& perfAttr,
                                    const std::shared_ptr<ppc::core::PerfResults>& perfResults) {
+  check_perf_attr(*perfAttr);
+  open_counters(*perfAttr);
   perfResults->type_of_running = PerfResults::TypeOfRunning::PIPELINE;
 
   common_run(
       std::move(perfAttr),
       [&]() {
-        task->validation();
-        task->pre_processing();
-        task->run();
-        task->post_processing();
+        run_stage(TaskStage::VALIDATION, [&] { task->validation(); });
+        run_stage(TaskStage::PRE_PROCESSING, [&] { task->pre_processing(); });
+        run_stage(TaskStage::RUN, [&] { task->run(); });
+        run_stage(TaskStage::POST_PROCESSING, [&] { task->post_processing(); });
       },
       std::move(perfResults));
 }
 
 void ppc::core::Perf::task_run(const std::shared_ptr<PerfAttr>& perfAttr,
                                const std::shared_ptr<ppc::core::PerfResults>& perfResults) {
+  check_perf_attr(*perfAttr);
+  open_counters(*perfAttr);
   perfResults->type_of_running = PerfResults::TypeOfRunning::TASK_RUN;
 
   task->validation();
   task->pre_processing();
-  common_run(std::move(perfAttr), [&]() { task->run(); }, std::move(perfResults));
+  common_run(
+      std::move(perfAttr), [&]() { run_stage(TaskStage::RUN, [&] { task->run(); }); }, std::move(perfResults));
   task->post_processing();
 
   task->validation();
@@ -45,18 +71,167 @@ void ppc::core::Perf::task_run(const std::shared_ptr<PerfAttr>& perfAttr,
   task->post_processing();
 }
 
+void ppc::core::Perf::open_counters(const PerfAttr& perfAttr) {
+  counters.reset();
+  if (perfAttr.collect_hw_counters) {
+    counters = std::make_unique<HwCounterCollector>();
+  }
+}
+
 void ppc::core::Perf::common_run(const std::shared_ptr<PerfAttr>& perfAttr, const std::function<void()>& pipeline,
                                  const std::shared_ptr<ppc::core::PerfResults>& perfResults) {
+  for (uint64_t i = 0; i < perfAttr->num_warmup; i++) {
+    pipeline();
+  }
+  auto num_running = perfAttr->num_running;
+  if (perfAttr->target_time_sec > 0.0) {
+    num_running = calibrate(perfAttr, pipeline);
+  }
+
+  auto& samples = perfResults->samples_sec;
+  samples.clear();
+  samples.reserve(num_running);
+  if (counters) {
+    counters->start();
+  }
+  task->time_stages(true);
+  task->reset_stage_timings();
+  stage_allocations = {};
+  measure_peak = 0;
+  measure_start = allocation_snapshot();
+  measuring = true;
   auto begin = perfAttr->current_timer();
-  for (uint64_t i = 0; i < perfAttr->num_running; i++) {
+  auto previous = begin;
+  for (uint64_t i = 0; i < num_running; i++) {
     pipeline();
+    auto current = perfAttr->current_timer();
+    samples.push_back(current - previous);
+    previous = current;
+  }
+  measuring = false;
+  auto measure_end = allocation_snapshot();
+  perfResults->allocations = {measure_end.count - measure_start.count, measure_end.bytes - measure_start.bytes,
+                              measure_peak};
+  perfResults->stage_allocations = stage_allocations;
+  const auto& policy = time_limit_policy();
+  if (perfAttr->max_allocations && allocation_tracking() && policy.on_allocation_violation &&
+      perfResults->allocations.count > *perfAttr->max_allocations) {
+    policy.on_allocation_violation({perfResults->allocations.count, *perfAttr->max_allocations});
+  }
+  if (counters) {
+    counters->stop();
+    perfResults->hw_counters = counters->read();
+    counters.reset();
+  } else {
+    perfResults->hw_counters = HwCounterReadings();
+  }
+  task->close_stage();
+  perfResults->stage_timings = task->stage_timings();
+  perfResults->time_sec = previous - begin;
+  perfResults->num_running = num_running;
+  perfResults->num_warmup = perfAttr->num_warmup;
+  const auto& inputs_count = task->get_data()->inputs_count;
+  perfResults->problem_size = std::accumulate(inputs_count.begin(), inputs_count.end(), uint64_t{0});
+  perfResults->statistics = compute_statistics(samples);
+  perfResults->work = task->work();
+  auto batch = std::dynamic_pointer_cast<BatchTask>(task);
+  perfResults->num_instances = batch ? batch->size() : 1;
+  perfResults->placement = Placement::current();
+  perfResults->rank_timings = RankTimings();
+  if (perfAttr->reduce_across_ranks) {
+    perfResults->rank_timings = perfAttr->reduce_across_ranks(*perfResults);
+  }
+}
+
+uint64_t ppc::core::Perf::calibrate(const std::shared_ptr<PerfAttr>& perfAttr, const std::function<void()>& pipeline) {
+  // Double the batch until it takes a tenth of the target, then extrapolate
+  uint64_t batch = 1;
+  while (true) {
+    auto begin = perfAttr->current_timer();
+    for (uint64_t i = 0; i < batch; i++) {
+      pipeline();
+    }
+    auto elapsed = perfAttr->current_timer() - begin;
+    if (perfAttr->max_across_ranks) {
+      // the slowest rank decides, so all ranks take the same branches
+      elapsed = perfAttr->max_across_ranks(elapsed);
+    }
+    if (elapsed <= 0.0) {
+      // the timer does not advance, nothing to calibrate against
+      return perfAttr->num_running;
+    }
+    if (elapsed * 10.0 >= perfAttr->target_time_sec || batch >= perfAttr->max_running) {
+      auto estimate = std::llround(perfAttr->target_time_sec * static_cast<double>(batch) / elapsed);
+      return std::clamp<uint64_t>(static_cast<uint64_t>(std::max<long long>(estimate, 1)), 1, perfAttr->max_running);
+    }
+    batch *= 2;
+  }
+}
+
+double ppc::core::PerfResults::bandwidth_gbs() const {
+  auto run_sec = stage_timings.mean(TaskStage::RUN);
+  return run_sec > 0.0 ? static_cast<double>(work.bytes) / run_sec * 1e-9 : 0.0;
+}
+
+double ppc::core::PerfResults::gflops() const {
+  auto run_sec = stage_timings.mean(TaskStage::RUN);
+  return run_sec > 0.0 ? static_cast<double>(work.operations) / run_sec * 1e-9 : 0.0;
+}
+
+ppc::core::PerfStatistics ppc::core::compute_statistics(std::vector<double> samples) {
+  PerfStatistics statistics;
+  if (samples.empty()) {
+    return statistics;
+  }
+  std::sort(samples.begin(), samples.end());
+  // linear interpolation between closest ranks
+  auto percentile = [&](double p) {
+    auto position = p * static_cast<double>(samples.size() - 1);
+    auto lower = static_cast<size_t>(position);
+    auto upper = std::min(lower + 1, samples.size() - 1);
+    return samples[lower] + (position - static_cast<double>(lower)) * (samples[upper] - samples[lower]);
+  };
+
+  auto count = static_cast<double>(samples.size());
+  statistics.min = samples.front();
+  statistics.max = samples.back();
+  statistics.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / count;
+  statistics.median = percentile(0.5);
+  statistics.p95 = percentile(0.95);
+  statistics.p99 = percentile(0.99);
+  if (samples.size() > 1) {
+    double sum_sq = 0.0;
+    for (auto sample : samples) {
+      sum_sq += (sample - statistics.mean) * (sample - statistics.mean);
+    }
+    statistics.stddev = std::sqrt(sum_sq / (count - 1.0));
   }
-  auto end = perfAttr->current_timer();
-  perfResults->time_sec = end - begin;
+  return statistics;
+}
+
+namespace {
+
+ppc::core::TestPathProvider& test_path_provider() {
+  static ppc::core::TestPathProvider provider;
+  return provider;
+}
+
+}  // namespace
+
+void ppc::core::set_test_path_provider(TestPathProvider provider) { test_path_provider() = std::move(provider); }
+
+std::string ppc::core::current_test_path() {
+  const auto& provider = test_path_provider();
+  return provider ? provider() : std::string();
 }
 
 void ppc::core::Perf::print_perf_statistic(const std::shared_ptr<PerfResults>& perfResults) {
-  std::string relative_path(::testing::UnitTest::GetInstance()->current_test_info()->file());
+  print_perf_statistic(perfResults, current_test_path());
+}
+
+void ppc::core::Perf::print_perf_statistic(const std::shared_ptr<PerfResults>& perfResults,
+                                           const std::string& test_file_path) {
+  std::string relative_path(test_file_path);
   std::string ppc_regex_template("parallel_programming_course");
   std::string perf_regex_template("perf_tests");
   std::string type_test_name;
@@ -71,22 +246,140 @@ void ppc::core::Perf::print_perf_statistic(const std::shared_ptr<PerfResults>& p
     type_test_name = "none";
   }
 
-  auto first_found_position = relative_path.find(ppc_regex_template) + ppc_regex_template.length() + 1;
-  relative_path.erase(0, first_found_position);
+  // without a test path (e.g. outside of gtest) the record is printed unnamed
+  auto first_found_position = relative_path.find(ppc_regex_template);
+  if (first_found_position != std::string::npos) {
+    relative_path.erase(0, first_found_position + ppc_regex_template.length() + 1);
+  }
 
-  auto last_found_position = relative_path.find(perf_regex_template) - 1;
-  relative_path.erase(last_found_position, relative_path.length() - 1);
+  auto last_found_position = relative_path.find(perf_regex_template);
+  if (last_found_position != std::string::npos && last_found_position > 0) {
+    relative_path.erase(last_found_position - 1, relative_path.length() - 1);
+  }
 
   std::stringstream perf_res_str;
-  if (time_secs < PerfResults::MAX_TIME) {
+  const auto& policy = time_limit_policy();
+  if (!policy.on_violation || time_secs < policy.perf_limit_sec) {
     perf_res_str << std::fixed << std::setprecision(10) << time_secs;
   } else {
-    std::cerr << "Task execute time need to be: ";
-    std::cerr << " time < " << PerfResults::MAX_TIME << " secs." << std::endl;
-    std::cerr << "Original time in secs: " << time_secs;
     perf_res_str << std::fixed << std::setprecision(10) << -1.0;
-    EXPECT_TRUE(time_secs < PerfResults::MAX_TIME);
+    policy.on_violation({TimeLimitKind::PERF, time_secs, policy.perf_limit_sec});
   }
 
   std::cout << relative_path << ":" << type_test_name << ":" << perf_res_str.str() << std::endl;
+
+  const auto& stats = perfResults->statistics;
+  std::stringstream stats_str;
+  stats_str << std::fixed << std::setprecision(10) << "iterations=" << perfResults->num_running
+            << ",warmup=" << perfResults->num_warmup << ",min=" << stats.min << ",max=" << stats.max
+            << ",mean=" << stats.mean << ",median=" << stats.median << ",p95=" << stats.p95 << ",p99=" << stats.p99
+            << ",stddev=" << stats.stddev;
+  std::cout << relative_path << ":" << type_test_name << ":stats:" << stats_str.str() << std::endl;
+
+  const auto& stages = perfResults->stage_timings;
+  std::stringstream stages_str;
+  stages_str << std::fixed << std::setprecision(10);
+  for (size_t i = 0; i < kNumTaskStages; i++) {
+    auto stage = static_cast<TaskStage>(i);
+    stages_str << (i == 0 ? "" : ",") << task_stage_name(stage) << "=" << stages.mean(stage);
+  }
+  std::cout << relative_path << ":" << type_test_name << ":stages:" << stages_str.str() << std::endl;
+
+  const auto& counters = perfResults->hw_counters;
+  if (counters.available()) {
+    std::stringstream counters_str;
+    for (size_t i = 0; i < kNumHwCounters; i++) {
+      if (counters.valid[i]) {
+        counters_str << hw_counter_name(static_cast<HwCounter>(i)) << "=" << counters.values[i] << ",";
+      }
+    }
+    counters_str << std::fixed << std::setprecision(4) << "ipc=" << counters.ipc();
+    std::cout << relative_path << ":" << type_test_name << ":counters:" << counters_str.str() << std::endl;
+  }
+
+  const auto& ranks = perfResults->rank_timings;
+  if (ranks.available()) {
+    std::stringstream ranks_str;
+    ranks_str << std::fixed << std::setprecision(10) << "ranks=" << ranks.num_ranks;
+    auto print_spread = [&](const std::string& name, const RankSpread& spread) {
+      ranks_str << "," << name << "_min=" << spread.min << "," << name << "_max=" << spread.max << "," << name
+                << "_mean=" << spread.mean << "," << name << "_imbalance=" << spread.imbalance();
+    };
+    print_spread("time", ranks.total);
+    for (size_t i = 0; i < kNumTaskStages; i++) {
+      print_spread(task_stage_name(static_cast<TaskStage>(i)), ranks.stages[i]);
+    }
+    std::cout << relative_path << ":" << type_test_name << ":ranks:" << ranks_str.str() << std::endl;
+  }
+
+  if (perfResults->num_instances > 1) {
+    std::stringstream batch_str;
+    batch_str << "instances=" << perfResults->num_instances << "," << std::fixed << std::setprecision(10)
+              << "time_per_instance=" << perfResults->time_per_instance();
+    std::cout << relative_path << ":" << type_test_name << ":batch:" << batch_str.str() << std::endl;
+  }
+
+  const auto& placement = perfResults->placement;
+  std::cout << relative_path << ":" << type_test_name << ":placement:policy=" << placement.policy
+            << ",cpus=" << format_cpu_list(placement.cpus) << ",numa_nodes=" << format_cpu_list(placement.nodes)
+            << std::endl;
+
+  if (allocation_tracking()) {
+    const auto& allocations = perfResults->allocations;
+    std::stringstream allocations_str;
+    allocations_str << "count=" << allocations.count << ",bytes=" << allocations.bytes
+                    << ",peak_bytes=" << allocations.peak_bytes;
+    for (size_t i = 0; i < kNumTaskStages; i++) {
+      const auto& stage = perfResults->stage_allocations[i];
+      std::string name = task_stage_name(static_cast<TaskStage>(i));
+      allocations_str << "," << name << "_count=" << stage.count << "," << name << "_bytes=" << stage.bytes << ","
+                      << name << "_peak_bytes=" << stage.peak_bytes;
+    }
+    std::cout << relative_path << ":" << type_test_name << ":allocations:" << allocations_str.str() << std::endl;
+  }
+
+  if (!perfResults->metrics.empty()) {
+    std::stringstream metrics_str;
+    metrics_str << std::setprecision(10);
+    for (size_t i = 0; i < perfResults->metrics.size(); i++) {
+      const auto& [name, value] = perfResults->metrics[i];
+      metrics_str << (i == 0 ? "" : ",") << name << "=" << value;
+    }
+    std::cout << relative_path << ":" << type_test_name << ":metrics:" << metrics_str.str() << std::endl;
+  }
+
+  if (perfResults->work.declared()) {
+    const auto& peak = MachinePeak::get();
+    auto point = roofline_point(*perfResults, peak);
+    std::stringstream roofline_str;
+    roofline_str << "bytes=" << perfResults->work.bytes << ",operations=" << perfResults->work.operations
+                 << std::fixed << std::setprecision(4) << ",intensity=" << point.intensity
+                 << ",gb_per_s=" << point.bandwidth_gbs << ",gflop_per_s=" << point.gflops
+                 << ",peak_gb_per_s=" << peak.bandwidth_gbs << ",peak_gflop_per_s=" << peak.gflops
+                 << ",attainable_gflop_per_s=" << point.attainable_gflops << ",efficiency=" << point.efficiency;
+    std::cout << relative_path << ":" << type_test_name << ":roofline:" << roofline_str.str() << std::endl;
+  }
+
+  auto sink = ResultsSink::from_env();
+  auto baseline = BaselineStore::from_env();
+  if (!sink && !baseline) {
+    return;
+  }
+  auto record = make_perf_record(test_file_path, *perfResults);
+  if (sink) {
+    sink->write(record);
+  }
+  if (baseline) {
+    auto comparison = baseline->check(record);
+    std::cout << relative_path << ":" << type_test_name
+              << ":baseline:verdict=" << baseline_verdict_name(comparison.verdict) << std::fixed
+              << std::setprecision(10) << ",baseline_median=" << comparison.baseline_median
+              << ",current_median=" << comparison.current_median << std::setprecision(4)
+              << ",ratio=" << comparison.ratio << std::setprecision(6) << ",p_value=" << comparison.p_value
+              << ",machine=" << baseline->machine().id << std::endl;
+    if (comparison.verdict == BaselineVerdict::SLOWER && policy.on_regression) {
+      policy.on_regression(
+          {comparison.current_median, comparison.baseline_median, comparison.ratio, comparison.p_value});
+    }
+  }
 }
@@ -0,0 +1,499 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/perf/include/results_sink.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <initializer_list>
+#include <iomanip>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "core/perf/include/scaling.hpp"
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+namespace {
+
+int env_int(std::initializer_list<const char*> names, int fallback) {
+  for (const auto* name : names) {
+    const char* value = std::getenv(name);
+    if (value != nullptr && std::atoi(value) > 0) {
+      return std::atoi(value);
+    }
+  }
+  return fallback;
+}
+
+std::string host_name() {
+#if defined(__linux__) || defined(__APPLE__)
+  char buffer[256] = {};
+  if (gethostname(buffer, sizeof(buffer) - 1) == 0) {
+    return buffer;
+  }
+#endif
+  const char* name = std::getenv("COMPUTERNAME");
+  return name != nullptr ? name : "unknown";
+}
+
+std::string json_string(const std::string& str) {
+  std::stringstream out;
+  out << '"';
+  for (char c : str) {
+    if (c == '"' || c == '\\') {
+      out << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+    } else {
+      out << c;
+    }
+  }
+  out << '"';
+  return out.str();
+}
+
+std::string csv_string(const std::string& str) {
+  if (str.find_first_of(",\"\n") == std::string::npos) {
+    return str;
+  }
+  std::string quoted = "\"";
+  for (char c : str) {
+    quoted += c == '"' ? std::string("\"\"") : std::string(1, c);
+  }
+  return quoted + "\"";
+}
+
+// JSON has no inf/nan
+std::string number(double value) {
+  if (!std::isfinite(value)) {
+    return "null";
+  }
+  std::stringstream out;
+  out << std::setprecision(10) << value;
+  return out.str();
+}
+
+// problem size, iterations, timing statistics and batch size, shared by both formats
+std::vector<std::pair<std::string, std::string>> timing_fields(const ppc::core::PerfResults& results) {
+  const auto& stats = results.statistics;
+  return {{"problem_size", std::to_string(results.problem_size)},
+          {"iterations", std::to_string(results.num_running)},
+          {"warmup", std::to_string(results.num_warmup)},
+          {"time_sec", number(results.time_sec)},
+          {"min", number(stats.min)},
+          {"max", number(stats.max)},
+          {"mean", number(stats.mean)},
+          {"median", number(stats.median)},
+          {"p95", number(stats.p95)},
+          {"p99", number(stats.p99)},
+          {"stddev", number(stats.stddev)},
+          {"instances", std::to_string(results.num_instances)},
+          {"time_per_instance", number(results.time_per_instance())}};
+}
+
+// declared work of one run() and the rates achieved, shared by both formats
+std::vector<std::pair<std::string, std::string>> work_fields(const ppc::core::PerfResults& results) {
+  return {{"bytes", std::to_string(results.work.bytes)},
+          {"operations", std::to_string(results.work.operations)},
+          {"gb_per_s", number(results.bandwidth_gbs())},
+          {"gflop_per_s", number(results.gflops())}};
+}
+
+// reads the string starting at line[pos] == '"' and moves pos past it
+std::string read_json_string(const std::string& line, size_t& pos) {
+  std::string str;
+  for (pos++; pos < line.size() && line[pos] != '"'; pos++) {
+    if (line[pos] == '\\' && pos + 1 < line.size()) {
+      pos++;
+      if (line[pos] == 'u' && pos + 4 < line.size()) {
+        str += static_cast<char>(std::strtol(line.substr(pos + 1, 4).c_str(), nullptr, 16));
+        pos += 4;
+        continue;
+      }
+    }
+    str += line[pos];
+  }
+  pos++;
+  return str;
+}
+
+// top-level fields of a JSON object written by to_json(); nested objects are
+// skipped and strings unescaped
+std::map<std::string, std::string> json_fields(const std::string& line) {
+  std::map<std::string, std::string> fields;
+  size_t pos = line.find('{');
+  if (pos == std::string::npos) {
+    return fields;
+  }
+  pos++;
+  auto skip = [&](const char* chars) {
+    while (pos < line.size() && std::strchr(chars, line[pos]) != nullptr) {
+      pos++;
+    }
+  };
+  while (true) {
+    skip(" \t,");
+    if (pos >= line.size() || line[pos] != '"') {
+      break;
+    }
+    auto key = read_json_string(line, pos);
+    skip(" \t");
+    if (pos >= line.size() || line[pos] != ':') {
+      break;
+    }
+    pos++;
+    skip(" \t");
+    if (pos >= line.size()) {
+      break;
+    }
+    if (line[pos] == '"') {
+      fields[key] = read_json_string(line, pos);
+    } else if (line[pos] == '{' || line[pos] == '[') {
+      for (int depth = 0; pos < line.size();) {
+        if (line[pos] == '"') {
+          read_json_string(line, pos);
+          continue;
+        }
+        depth += line[pos] == '{' || line[pos] == '[' ? 1 : 0;
+        depth -= line[pos] == '}' || line[pos] == ']' ? 1 : 0;
+        pos++;
+        if (depth == 0) {
+          break;
+        }
+      }
+    } else {
+      auto end = line.find_first_of(",}", pos);
+      end = end == std::string::npos ? line.size() : end;
+      auto value = line.substr(pos, end - pos);
+      value.erase(value.find_last_not_of(" \t") + 1);
+      fields[key] = value;
+      pos = end;
+    }
+  }
+  return fields;
+}
+
+std::vector<std::string> csv_fields(const std::string& line) {
+  std::vector<std::string> fields(1);
+  bool quoted = false;
+  for (size_t i = 0; i < line.size(); i++) {
+    char c = line[i];
+    if (quoted && c == '"' && i + 1 < line.size() && line[i + 1] == '"') {
+      fields.back() += c;
+      i++;
+    } else if (c == '"') {
+      quoted = !quoted;
+    } else if (c == ',' && !quoted) {
+      fields.emplace_back();
+    } else if (c != '\r') {
+      fields.back() += c;
+    }
+  }
+  return fields;
+}
+
+// field of either format back into the record; unknown keys and empty values are ignored
+void set_record_field(ppc::core::PerfRecord& record, const std::string& key, const std::string& value) {
+  if (value.empty() || value == "null") {
+    return;
+  }
+  auto& results = record.results;
+  auto& stats = results.statistics;
+  const std::map<std::string, std::string*> strings = {{"task", &record.task_id},
+                                                       {"backend", &record.backend},
+                                                       {"type", &record.type_of_running},
+                                                       {"host", &record.host},
+                                                       {"scaling", &record.scaling},
+                                                       {"placement", &results.placement.policy}};
+  const std::map<std::string, int*> ints = {
+      {"processes", &record.num_procs}, {"threads", &record.num_threads}, {"workers", &record.workers}};
+  const std::map<std::string, uint64_t*> counts = {{"problem_size", &results.problem_size},
+                                                   {"iterations", &results.num_running},
+                                                   {"warmup", &results.num_warmup},
+                                                   {"instances", &results.num_instances},
+                                                   {"bytes", &results.work.bytes},
+                                                   {"operations", &results.work.operations}};
+  const std::map<std::string, double*> numbers = {{"time_sec", &results.time_sec}, {"min", &stats.min},
+                                                  {"max", &stats.max},           {"mean", &stats.mean},
+                                                  {"median", &stats.median},     {"p95", &stats.p95},
+                                                  {"p99", &stats.p99},           {"stddev", &stats.stddev}};
+  if (auto it = strings.find(key); it != strings.end()) {
+    *it->second = value;
+  } else if (auto it = ints.find(key); it != ints.end()) {
+    *it->second = std::atoi(value.c_str());
+  } else if (auto it = counts.find(key); it != counts.end()) {
+    *it->second = std::strtoull(value.c_str(), nullptr, 10);
+  } else if (auto it = numbers.find(key); it != numbers.end()) {
+    *it->second = std::strtod(value.c_str(), nullptr);
+  }
+  if (key == "cpus") {
+    results.placement.cpus = ppc::core::parse_cpu_list(value);
+  } else if (key == "numa_nodes") {
+    results.placement.nodes = ppc::core::parse_cpu_list(value);
+  }
+  if (key == "type") {
+    results.type_of_running = value == "pipeline"   ? ppc::core::PerfResults::TypeOfRunning::PIPELINE
+                              : value == "task_run" ? ppc::core::PerfResults::TypeOfRunning::TASK_RUN
+                                                    : ppc::core::PerfResults::TypeOfRunning::NONE;
+  }
+}
+
+}  // namespace
+
+const char* ppc::core::type_of_running_name(PerfResults::TypeOfRunning type) {
+  switch (type) {
+    case PerfResults::TypeOfRunning::PIPELINE:
+      return "pipeline";
+    case PerfResults::TypeOfRunning::TASK_RUN:
+      return "task_run";
+    default:
+      return "none";
+  }
+}
+
+ppc::core::PerfRecord ppc::core::make_perf_record(const std::string& task_path, const PerfResults& results) {
+  PerfRecord record;
+  std::vector<std::string> parts(1);
+  for (char c : task_path) {
+    if (c == '/' || c == '\\') {
+      parts.emplace_back();
+    } else {
+      parts.back() += c;
+    }
+  }
+  // look for ".../tasks/<backend>/<task>/..." first, the path may point into perf_tests
+  auto it = std::find(parts.rbegin(), parts.rend(), "tasks");
+  auto tasks_index = static_cast<size_t>(std::distance(it, parts.rend()));
+  if (it != parts.rend() && tasks_index + 1 < parts.size()) {
+    record.backend = parts[tasks_index];
+    record.task_id = parts[tasks_index + 1];
+  } else {
+    record.task_id = parts.back();
+    record.backend = parts.size() > 1 ? parts[parts.size() - 2] : "";
+  }
+  record.type_of_running = type_of_running_name(results.type_of_running);
+  record.host = host_name();
+  record.num_procs = env_int({"OMPI_COMM_WORLD_SIZE", "PMI_SIZE"}, 1);
+  // the threads a task of the backend runs on: OpenMP takes OMP_NUM_THREADS,
+  // the other threaded backends size their pools with get_num_threads()
+  if (record.backend == "omp") {
+    record.num_threads = env_int({"OMP_NUM_THREADS"}, get_num_threads());
+  } else if (record.backend == "stl" || record.backend == "tbb") {
+    record.num_threads = get_num_threads();
+  }
+  auto scaling = ScalingConfig::from_env();
+  record.scaling = scaling_mode_name(scaling.mode);
+  record.workers = scaling.workers;
+  record.results = results;
+  return record;
+}
+
+ppc::core::ResultsSink::ResultsSink(std::string path, Format format) : path_(std::move(path)), format_(format) {}
+
+std::unique_ptr<ppc::core::ResultsSink> ppc::core::ResultsSink::from_env() {
+  const char* path = std::getenv("PPC_PERF_RESULTS");
+  if (path == nullptr || *path == '\0') {
+    return nullptr;
+  }
+  std::string str(path);
+  auto is_csv = str.size() >= 4 && str.compare(str.size() - 4, 4, ".csv") == 0;
+  return std::make_unique<ResultsSink>(str, is_csv ? Format::CSV : Format::JSON_LINES);
+}
+
+void ppc::core::ResultsSink::write(const PerfRecord& record) const {
+  // the first line of a CSV file; appended rows must match its columns
+  std::string first_line;
+  {
+    std::ifstream existing(path_, std::ios::binary);
+    std::getline(existing, first_line);
+    if (!first_line.empty() && first_line.back() == '\r') {
+      first_line.pop_back();
+    }
+  }
+  if (format_ == Format::CSV && !first_line.empty() && first_line != csv_header()) {
+    throw std::runtime_error("Perf results file has other CSV columns than this build writes: " + path_);
+  }
+  std::ofstream out(path_, std::ios::app);
+  if (!out.is_open()) {
+    throw std::runtime_error("Cannot open perf results file: " + path_);
+  }
+  if (format_ == Format::CSV) {
+    if (first_line.empty()) {
+      out << csv_header() << '\n';
+    }
+    out << to_csv(record) << '\n';
+  } else {
+    out << to_json(record) << '\n';
+  }
+}
+
+std::string ppc::core::ResultsSink::to_json(const PerfRecord& record) {
+  const auto& results = record.results;
+  std::stringstream out;
+  out << "{\"task\":" << json_string(record.task_id) << ",\"backend\":" << json_string(record.backend)
+      << ",\"type\":" << json_string(record.type_of_running) << ",\"host\":" << json_string(record.host)
+      << ",\"processes\":" << record.num_procs << ",\"threads\":" << record.num_threads
+      << ",\"scaling\":" << json_string(record.scaling) << ",\"workers\":" << record.workers;
+  const auto& placement = results.placement;
+  out << ",\"placement\":" << json_string(placement.policy)
+      << ",\"cpus\":" << json_string(format_cpu_list(placement.cpus))
+      << ",\"numa_nodes\":" << json_string(format_cpu_list(placement.nodes));
+  for (const auto& [key, value] : timing_fields(results)) {
+    out << ",\"" << key << "\":" << value;
+  }
+  for (const auto& [key, value] : work_fields(results)) {
+    out << ",\"" << key << "\":" << value;
+  }
+
+  out << ",\"stages\":{";
+  for (size_t i = 0; i < kNumTaskStages; i++) {
+    auto stage = static_cast<TaskStage>(i);
+    out << (i == 0 ? "" : ",") << '"' << task_stage_name(stage) << "\":" << number(results.stage_timings.mean(stage));
+  }
+  out << "},\"counters\":{";
+  bool first = true;
+  for (size_t i = 0; i < kNumHwCounters; i++) {
+    if (results.hw_counters.valid[i]) {
+      out << (first ? "" : ",") << '"' << hw_counter_name(static_cast<HwCounter>(i))
+          << "\":" << results.hw_counters.values[i];
+      first = false;
+    }
+  }
+  out << "}";
+
+  auto allocation = [](const AllocationStats& stats) {
+    return "{\"count\":" + std::to_string(stats.count) + ",\"bytes\":" + std::to_string(stats.bytes) +
+           ",\"peak_bytes\":" + std::to_string(stats.peak_bytes) + "}";
+  };
+  // left out where nothing is counted
+  if (allocation_tracking()) {
+    out << ",\"allocations\":" << allocation(results.allocations) << ",\"stage_allocations\":{";
+    for (size_t i = 0; i < kNumTaskStages; i++) {
+      out << (i == 0 ? "" : ",") << '"' << task_stage_name(static_cast<TaskStage>(i))
+          << "\":" << allocation(results.stage_allocations[i]);
+    }
+    out << "}";
+  }
+
+  if (!results.metrics.empty()) {
+    out << ",\"metrics\":{";
+    for (size_t i = 0; i < results.metrics.size(); i++) {
+      out << (i == 0 ? "" : ",") << json_string(results.metrics[i].first) << ':' << number(results.metrics[i].second);
+    }
+    out << "}";
+  }
+
+  const auto& ranks = results.rank_timings;
+  if (ranks.available()) {
+    auto spread = [&](const RankSpread& value) {
+      return "{\"min\":" + number(value.min) + ",\"max\":" + number(value.max) + ",\"mean\":" + number(value.mean) +
+             ",\"imbalance\":" + number(value.imbalance()) + "}";
+    };
+    out << ",\"ranks\":{\"count\":" << ranks.num_ranks << ",\"time\":" << spread(ranks.total);
+    for (size_t i = 0; i < kNumTaskStages; i++) {
+      out << ",\"" << task_stage_name(static_cast<TaskStage>(i)) << "\":" << spread(ranks.stages[i]);
+    }
+    out << "}";
+  }
+  out << "}";
+  return out.str();
+}
+
+std::string ppc::core::ResultsSink::csv_header() {
+  std::stringstream out;
+  out << "task,backend,type,host,processes,threads,scaling,workers";
+  for (const auto& field : timing_fields(PerfResults())) {
+    out << ',' << field.first;
+  }
+  for (size_t i = 0; i < kNumTaskStages; i++) {
+    out << ',' << task_stage_name(static_cast<TaskStage>(i)) << "_sec";
+  }
+  for (size_t i = 0; i < kNumHwCounters; i++) {
+    out << ',' << hw_counter_name(static_cast<HwCounter>(i));
+  }
+  out << ",alloc_count,alloc_bytes,alloc_peak_bytes";
+  out << ",ranks,time_min,time_max,time_mean,time_imbalance";
+  out << ",placement,cpus,numa_nodes";
+  for (const auto& field : work_fields(PerfResults())) {
+    out << ',' << field.first;
+  }
+  return out.str();
+}
+
+std::string ppc::core::ResultsSink::to_csv(const PerfRecord& record) {
+  const auto& results = record.results;
+  std::stringstream out;
+  out << csv_string(record.task_id) << ',' << csv_string(record.backend) << ',' << csv_string(record.type_of_running)
+      << ',' << csv_string(record.host) << ',' << record.num_procs << ',' << record.num_threads << ','
+      << csv_string(record.scaling) << ',' << record.workers;
+  for (const auto& field : timing_fields(results)) {
+    out << ',' << field.second;
+  }
+  for (size_t i = 0; i < kNumTaskStages; i++) {
+    out << ',' << number(results.stage_timings.mean(static_cast<TaskStage>(i)));
+  }
+  // unavailable counters stay empty
+  for (size_t i = 0; i < kNumHwCounters; i++) {
+    out << ',';
+    if (results.hw_counters.valid[i]) {
+      out << results.hw_counters.values[i];
+    }
+  }
+  if (allocation_tracking()) {
+    out << ',' << results.allocations.count << ',' << results.allocations.bytes << ','
+        << results.allocations.peak_bytes;
+  } else {
+    out << ",,,";
+  }
+  const auto& ranks = results.rank_timings;
+  if (ranks.available()) {
+    out << ',' << ranks.num_ranks << ',' << number(ranks.total.min) << ',' << number(ranks.total.max) << ','
+        << number(ranks.total.mean) << ',' << number(ranks.total.imbalance());
+  } else {
+    out << ",,,,,";
+  }
+  const auto& placement = results.placement;
+  out << ',' << csv_string(placement.policy) << ',' << csv_string(format_cpu_list(placement.cpus)) << ','
+      << csv_string(format_cpu_list(placement.nodes));
+  for (const auto& field : work_fields(results)) {
+    out << ',' << field.second;
+  }
+  return out.str();
+}
+
+std::vector<ppc::core::PerfRecord> ppc::core::ResultsSink::read(const std::string& path) {
+  std::vector<PerfRecord> records;
+  std::ifstream in(path);
+  auto is_csv = path.size() >= 4 && path.compare(path.size() - 4, 4, ".csv") == 0;
+  std::vector<std::string> header;
+  for (std::string line; std::getline(in, line);) {
+    if (line.empty() || line == "\r") {
+      continue;
+    }
+    PerfRecord record;
+    if (is_csv) {
+      if (header.empty()) {
+        header = csv_fields(line);
+        continue;
+      }
+      auto values = csv_fields(line);
+      for (size_t i = 0; i < header.size() && i < values.size(); i++) {
+        set_record_field(record, header[i], values[i]);
+      }
+    } else {
+      for (const auto& [key, value] : json_fields(line)) {
+        set_record_field(record, key, value);
+      }
+    }
+    records.push_back(std::move(record));
+  }
+  return records;
+}
@@ -0,0 +1,205 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/perf/include/roofline.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "core/async/include/worker_pool.hpp"
+#include "core/placement/include/placement.hpp"
+
+namespace {
+
+// elements of each triad array: 3 x 32 MiB, well past the last level cache
+constexpr std::size_t kStreamElements = std::size_t{1} << 22;
+constexpr int kStreamRepetitions = 5;
+// independent accumulators, enough to hide the latency of vector mul + add
+constexpr std::size_t kFmaChains = 32;
+constexpr std::size_t kFmaIterations = std::size_t{1} << 21;
+constexpr int kFmaRepetitions = 3;
+
+// Lets a fixed set of workers pass only together. The last one to arrive runs
+// on_release before any of them goes on, so a time taken there is not skewed
+// by a worker that starts early. std::barrier is not there on every compiler
+// the course uses.
+class Barrier {
+ public:
+  explicit Barrier(std::size_t count) : count_(count) {}
+
+  template <class OnRelease>
+  void wait(const OnRelease& on_release) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto generation = generation_;
+    if (++arrived_ < count_) {
+      released_.wait(lock, [&] { return generation != generation_; });
+      return;
+    }
+    on_release();
+    arrived_ = 0;
+    generation_++;
+    released_.notify_all();
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable released_;
+  std::size_t count_;
+  std::size_t arrived_ = 0;
+  std::uint64_t generation_ = 0;
+};
+
+// Workers started once per measurement; seconds() times body(worker) run
+// concurrently on all of them from the moment every worker is ready until
+// the last one is done, leaving out thread start-up and wake-up
+class KernelTimer {
+ public:
+  explicit KernelTimer(int threads) : pool_(static_cast<std::size_t>(threads)), barrier_(pool_.size()) {}
+
+  [[nodiscard]] int threads() const { return static_cast<int>(pool_.size()); }
+
+  template <class Body>
+  double seconds(const Body& body) {
+    std::chrono::steady_clock::time_point start;
+    std::chrono::steady_clock::time_point end;
+    pool_.run([&](std::size_t worker) {
+      barrier_.wait([&] { start = std::chrono::steady_clock::now(); });
+      body(static_cast<int>(worker));
+      barrier_.wait([&] { end = std::chrono::steady_clock::now(); });
+    });
+    return std::chrono::duration<double>(end - start).count();
+  }
+
+ private:
+  ppc::core::WorkerPool pool_;
+  Barrier barrier_;
+};
+
+double stream_triad_gbs(KernelTimer& timer) {
+  const int threads = timer.threads();
+  std::vector<double> a(kStreamElements);
+  std::vector<double> b(kStreamElements);
+  std::vector<double> c(kStreamElements);
+  auto slice = [&](int worker) {
+    return std::make_pair(kStreamElements * worker / threads, kStreamElements * (worker + 1) / threads);
+  };
+  // each worker touches its own slice first, so its pages are local to it
+  timer.seconds([&](int worker) {
+    auto [begin, end] = slice(worker);
+    std::fill(a.begin() + begin, a.begin() + end, 0.0);
+    std::fill(b.begin() + begin, b.begin() + end, 1.0);
+    std::fill(c.begin() + begin, c.begin() + end, 2.0);
+  });
+  volatile double scalar_source = 3.0;
+  const double scalar = scalar_source;
+  double best = std::numeric_limits<double>::max();
+  for (int repetition = 0; repetition < kStreamRepetitions; repetition++) {
+    auto seconds = timer.seconds([&](int worker) {
+      auto [begin, end] = slice(worker);
+      for (auto i = begin; i < end; i++) {
+        a[i] = b[i] + scalar * c[i];
+      }
+    });
+    best = std::min(best, seconds);
+  }
+  volatile double sink = a[kStreamElements / 2];
+  static_cast<void>(sink);
+  return 3.0 * sizeof(double) * static_cast<double>(kStreamElements) / best * 1e-9;
+}
+
+double multiply_add_gflops(KernelTimer& timer) {
+  const int threads = timer.threads();
+  volatile double multiplier_source = 0.999999;
+  volatile double addend_source = 1e-6;
+  const double multiplier = multiplier_source;
+  const double addend = addend_source;
+  std::vector<double> results(threads);
+  double best = std::numeric_limits<double>::max();
+  for (int repetition = 0; repetition < kFmaRepetitions; repetition++) {
+    auto seconds = timer.seconds([&](int worker) {
+      // x = x * m + a converges to 1, values stay normal
+      double chains[kFmaChains];
+      for (std::size_t j = 0; j < kFmaChains; j++) {
+        chains[j] = static_cast<double>(j);
+      }
+      for (std::size_t i = 0; i < kFmaIterations; i++) {
+        for (auto& x : chains) {
+          x = x * multiplier + addend;
+        }
+      }
+      double sum = 0.0;
+      for (auto x : chains) {
+        sum += x;
+      }
+      results[worker] = sum;
+    });
+    best = std::min(best, seconds);
+  }
+  volatile double sink = results[0];
+  static_cast<void>(sink);
+  auto operations = 2.0 * static_cast<double>(kFmaChains) * static_cast<double>(kFmaIterations) * threads;
+  return operations / best * 1e-9;
+}
+
+}  // namespace
+
+ppc::core::MachinePeak ppc::core::MachinePeak::measure(int threads) {
+  if (threads <= 0) {
+    auto cpus = current_affinity();
+    threads = cpus.empty() ? static_cast<int>(std::max(1U, std::thread::hardware_concurrency()))
+                           : static_cast<int>(cpus.size());
+  }
+  MachinePeak peak;
+  KernelTimer timer(threads);
+  peak.threads = timer.threads();
+  peak.bandwidth_gbs = stream_triad_gbs(timer);
+  peak.gflops = multiply_add_gflops(timer);
+  return peak;
+}
+
+const ppc::core::MachinePeak& ppc::core::MachinePeak::get() {
+  static const MachinePeak peak = [] {
+    const char* value = std::getenv("PPC_MACHINE_PEAK");
+    if (value != nullptr && *value != '\0') {
+      MachinePeak given;
+      char* end = nullptr;
+      given.bandwidth_gbs = std::strtod(value, &end);
+      if (*end == ',') {
+        given.gflops = std::strtod(end + 1, nullptr);
+      }
+      if (given.available()) {
+        return given;
+      }
+    }
+    return measure();
+  }();
+  return peak;
+}
+
+ppc::core::RooflinePoint ppc::core::roofline_point(const PerfResults& results, const MachinePeak& peak) {
+  RooflinePoint point;
+  const auto& work = results.work;
+  point.bandwidth_gbs = results.bandwidth_gbs();
+  point.gflops = results.gflops();
+  if (work.bytes > 0) {
+    point.intensity = static_cast<double>(work.operations) / static_cast<double>(work.bytes);
+  }
+  if (!peak.available() || (point.bandwidth_gbs <= 0.0 && point.gflops <= 0.0)) {
+    return point;
+  }
+  if (work.operations == 0) {
+    point.efficiency = point.bandwidth_gbs / peak.bandwidth_gbs;
+    return point;
+  }
+  point.attainable_gflops =
+      work.bytes > 0 ? std::min(peak.gflops, point.intensity * peak.bandwidth_gbs) : peak.gflops;
+  point.efficiency = point.gflops / point.attainable_gflops;
+  return point;
+}
@@ -0,0 +1,61 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/perf/include/scaling.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace {
+
+int positive_env(const char* name, int fallback) {
+  const char* value = std::getenv(name);
+  if (value == nullptr || *value == '\0') {
+    return fallback;
+  }
+  int result = std::atoi(value);
+  if (result <= 0) {
+    throw std::invalid_argument(std::string(name) + " must be a positive integer, got: " + value);
+  }
+  return result;
+}
+
+}  // namespace
+
+const char* ppc::core::scaling_mode_name(ScalingMode mode) {
+  switch (mode) {
+    case ScalingMode::STRONG:
+      return "strong";
+    case ScalingMode::WEAK:
+      return "weak";
+    default:
+      return "none";
+  }
+}
+
+ppc::core::ScalingConfig ppc::core::ScalingConfig::from_env() {
+  ScalingConfig config;
+  const char* mode = std::getenv("PPC_SCALING_MODE");
+  if (mode == nullptr || *mode == '\0') {
+    return config;
+  }
+  std::string str(mode);
+  if (str == "strong") {
+    config.mode = ScalingMode::STRONG;
+  } else if (str == "weak") {
+    config.mode = ScalingMode::WEAK;
+  } else {
+    throw std::invalid_argument("PPC_SCALING_MODE must be 'strong' or 'weak', got: " + str);
+  }
+  config.workers = positive_env("PPC_NUM_WORKERS", 1);
+  return config;
+}
+
+std::uint64_t ppc::core::ScalingConfig::problem_size(std::uint64_t base_size) const {
+  return mode == ScalingMode::WEAK ? base_size * static_cast<std::uint64_t>(workers) : base_size;
+}
+
+int ppc::core::get_num_threads() {
+  return positive_env("PPC_NUM_THREADS", std::max(1, static_cast<int>(std::thread::hardware_concurrency())));
+}
@@ -0,0 +1,90 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "core/placement/include/placement.hpp"
+
+namespace {
+
+// two nodes of four CPUs each
+ppc::core::CpuTopology two_nodes() {
+  ppc::core::CpuTopology topology;
+  topology.cpus = {0, 1, 2, 3, 4, 5, 6, 7};
+  topology.nodes = {0, 0, 0, 0, 1, 1, 1, 1};
+  topology.num_nodes = 2;
+  return topology;
+}
+
+}  // namespace
+
+TEST(placement_tests, check_cpu_lists) {
+  EXPECT_EQ(ppc::core::format_cpu_list({3, 0, 1, 2, 8, 11, 10}), "0-3,8,10-11");
+  EXPECT_EQ(ppc::core::format_cpu_list({}), "");
+  EXPECT_EQ(ppc::core::parse_cpu_list("0-3,8,10-11"), std::vector<int>({0, 1, 2, 3, 8, 10, 11}));
+  EXPECT_TRUE(ppc::core::parse_cpu_list("").empty());
+  EXPECT_STREQ(ppc::core::pin_policy_name(ppc::core::PinPolicy::SCATTER), "scatter");
+}
+
+TEST(placement_tests, check_worker_cpus) {
+  auto topology = two_nodes();
+  EXPECT_TRUE(ppc::core::worker_cpus(ppc::core::PinPolicy::NONE, topology, 4).empty());
+  EXPECT_EQ(ppc::core::worker_cpus(ppc::core::PinPolicy::COMPACT, topology, 3), std::vector<int>({0, 1, 2}));
+  EXPECT_EQ(ppc::core::worker_cpus(ppc::core::PinPolicy::SCATTER, topology, 4), std::vector<int>({0, 4, 1, 5}));
+  EXPECT_EQ(ppc::core::worker_cpus(ppc::core::PinPolicy::COMPACT, topology, 10),
+            std::vector<int>({0, 1, 2, 3, 4, 5, 6, 7, 0, 1}));
+}
+
+TEST(placement_tests, check_rank_cpus) {
+  auto topology = two_nodes();
+  EXPECT_TRUE(ppc::core::rank_cpus(ppc::core::PinPolicy::NONE, topology, 0, 2).empty());
+  EXPECT_EQ(ppc::core::rank_cpus(ppc::core::PinPolicy::COMPACT, topology, 0, 2), std::vector<int>({0, 1, 2, 3}));
+  EXPECT_EQ(ppc::core::rank_cpus(ppc::core::PinPolicy::COMPACT, topology, 1, 2), std::vector<int>({4, 5, 6, 7}));
+  EXPECT_EQ(ppc::core::rank_cpus(ppc::core::PinPolicy::COMPACT, topology, 1, 4), std::vector<int>({2, 3}));
+
+  // consecutive ranks alternate nodes and split them
+  EXPECT_EQ(ppc::core::rank_cpus(ppc::core::PinPolicy::SCATTER, topology, 0, 4), std::vector<int>({0, 1}));
+  EXPECT_EQ(ppc::core::rank_cpus(ppc::core::PinPolicy::SCATTER, topology, 1, 4), std::vector<int>({4, 5}));
+  EXPECT_EQ(ppc::core::rank_cpus(ppc::core::PinPolicy::SCATTER, topology, 2, 4), std::vector<int>({2, 3}));
+  EXPECT_EQ(ppc::core::rank_cpus(ppc::core::PinPolicy::SCATTER, topology, 1, 3), std::vector<int>({4, 5, 6, 7}));
+
+  // more ranks than CPUs share them one each
+  EXPECT_EQ(ppc::core::rank_cpus(ppc::core::PinPolicy::COMPACT, topology, 9, 16), std::vector<int>({1}));
+}
+
+TEST(placement_tests, check_pinning_and_first_touch) {
+  auto topology = ppc::core::CpuTopology::detect();
+  ASSERT_FALSE(topology.cpus.empty());
+  EXPECT_EQ(topology.cpus.size(), topology.nodes.size());
+  EXPECT_GE(topology.num_nodes, 1);
+
+  auto placement = ppc::core::Placement::current();
+  EXPECT_FALSE(placement.cpus.empty());
+  EXPECT_FALSE(placement.nodes.empty());
+
+  // pinning changes only the calling thread
+  std::vector<int> affinity;
+  bool pinned = false;
+  std::thread worker([&] {
+    pinned = ppc::core::pin_current_thread({topology.cpus.back()});
+    affinity = ppc::core::current_affinity();
+  });
+  worker.join();
+  if (pinned) {
+    EXPECT_EQ(affinity, std::vector<int>({topology.cpus.back()}));
+    EXPECT_EQ(ppc::core::current_affinity().size(), topology.cpus.size());
+  }
+
+  std::vector<int> data(100000, 7);
+  auto cpus = ppc::core::worker_cpus(ppc::core::PinPolicy::SCATTER, topology, 3);
+  ppc::core::first_touch(data.data(), data.size() * sizeof(int), cpus);
+  EXPECT_TRUE(std::all_of(data.begin(), data.end(), [](int value) { return value == 0; }));
+  data.assign(data.size(), 7);
+  ppc::core::first_touch(data.data(), data.size() * sizeof(int), {});
+  EXPECT_EQ(std::count(data.begin(), data.end(), 0), static_cast<std::ptrdiff_t>(data.size()));
+
+  auto buffer = ppc::core::make_first_touched<double>(1000, cpus);
+  EXPECT_TRUE(std::all_of(buffer.get(), buffer.get() + 1000, [](double value) { return value == 0.0; }));
+}
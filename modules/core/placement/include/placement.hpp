@@ -0,0 +1,97 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_PLACEMENT_HPP_
+#define MODULES_CORE_INCLUDE_PLACEMENT_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace ppc::core {
+
+// How ranks and worker threads are pinned to CPUs:
+// COMPACT fills the CPUs of one NUMA node before moving to the next,
+// SCATTER spreads consecutive workers (or ranks) over the nodes
+enum class PinPolicy : uint8_t { NONE, COMPACT, SCATTER };
+
+const char* pin_policy_name(PinPolicy policy);
+// PPC_PIN ("none", "compact" or "scatter"), NONE if unset; throws
+// std::invalid_argument for other values
+PinPolicy pin_policy_from_env();
+
+// CPUs the calling thread may run on and their NUMA nodes
+struct CpuTopology {
+  // ordered by node, then by id
+  std::vector<int> cpus;
+  // node of each entry of cpus
+  std::vector<int> nodes;
+  int num_nodes = 1;
+
+  // affinity mask of the calling thread and the node map from /sys on Linux;
+  // one node of hardware_concurrency() CPUs elsewhere
+  static CpuTopology detect();
+};
+
+// CPU of each of count workers: workers wrap around when there are more of
+// them than CPUs; empty for NONE
+std::vector<int> worker_cpus(PinPolicy policy, const CpuTopology& topology, std::size_t count);
+// CPUs of rank local_rank out of local_size ranks sharing topology: COMPACT
+// gives contiguous blocks, SCATTER puts consecutive ranks on different nodes
+std::vector<int> rank_cpus(PinPolicy policy, const CpuTopology& topology, int local_rank, int local_size);
+
+// Restrict the calling thread to cpus; false if unsupported or rejected.
+// Threads started afterwards inherit the mask.
+bool pin_current_thread(const std::vector<int>& cpus);
+// affinity mask of the calling thread, empty if unknown
+std::vector<int> current_affinity();
+
+// CPUs pin_worker() puts count workers on, empty for NONE
+std::vector<int> pinned_worker_cpus(std::size_t count);
+// Pin the calling thread as worker index of count under the PPC_PIN policy,
+// within the CPUs its process may use; does nothing for NONE. Threaded tasks
+// call it first thing in each worker.
+bool pin_worker(std::size_t index, std::size_t count);
+// Pin the calling process to its share of the node under the PPC_PIN policy,
+// using the local rank from the MPI launcher; does nothing for NONE or if the
+// process is already bound to part of the machine (e.g. by mpirun). Call once
+// after MPI init, before workers are started and data is allocated.
+bool pin_rank();
+
+// Zero freshly allocated memory from one thread per entry of cpus, each
+// pinned to its CPU and touching one contiguous block, so that the pages land
+// on the node of the worker that will process the block (same split as
+// worker i taking block i of cpus.size()). Touches from the calling thread if
+// cpus is empty.
+void first_touch(void* data, std::size_t bytes, const std::vector<int>& cpus);
+
+// Zeroed buffer of count elements placed by first_touch(); unlike a
+// std::vector, which the allocating thread zeroes, so its pages all land on
+// that thread's node
+template <class T>
+std::unique_ptr<T[]> make_first_touched(std::size_t count, const std::vector<int>& cpus) {
+  static_assert(std::is_trivial_v<T>, "first_touch() zeroes the bytes, T must be trivial");
+  std::unique_ptr<T[]> data(new T[count]);
+  first_touch(data.get(), count * sizeof(T), cpus);
+  return data;
+}
+
+// "0-3,8,10-11" and back
+std::string format_cpu_list(const std::vector<int>& cpus);
+std::vector<int> parse_cpu_list(const std::string& str);
+
+// Placement a measurement ran with, recorded in PerfResults
+struct Placement {
+  std::string policy = "none";
+  std::vector<int> cpus;
+  std::vector<int> nodes;
+
+  // PPC_PIN and the affinity mask of the calling thread
+  static Placement current();
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_PLACEMENT_HPP_
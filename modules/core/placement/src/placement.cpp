@@ -0,0 +1,319 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/placement/include/placement.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <initializer_list>
+#include <map>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// NUMA node of every CPU of the machine; read once, the topology does not change
+const std::map<int, int>& node_map() {
+  static const std::map<int, int> nodes = [] {
+    std::map<int, int> result;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator("/sys/devices/system/node", error)) {
+      auto name = entry.path().filename().string();
+      if (name.rfind("node", 0) != 0 || name.size() == 4 ||
+          name.find_first_not_of("0123456789", 4) != std::string::npos) {
+        continue;
+      }
+      std::ifstream list(entry.path() / "cpulist");
+      std::string str;
+      std::getline(list, str);
+      for (int cpu : ppc::core::parse_cpu_list(str)) {
+        result[cpu] = std::atoi(name.c_str() + 4);
+      }
+    }
+    return result;
+  }();
+  return nodes;
+}
+
+int node_of(int cpu) {
+  const auto& nodes = node_map();
+  auto it = nodes.find(cpu);
+  return it != nodes.end() ? it->second : 0;
+}
+
+// CPUs of topology grouped by node, in node order
+std::vector<std::vector<int>> cpus_by_node(const ppc::core::CpuTopology& topology) {
+  std::vector<std::vector<int>> groups;
+  for (size_t i = 0; i < topology.cpus.size(); i++) {
+    if (i == 0 || topology.nodes[i] != topology.nodes[i - 1]) {
+      groups.emplace_back();
+    }
+    groups.back().push_back(topology.cpus[i]);
+  }
+  return groups;
+}
+
+// part index of parts equal blocks of cpus, or a single CPU if there are fewer CPUs than parts
+std::vector<int> block_of(const std::vector<int>& cpus, size_t index, size_t parts) {
+  if (cpus.empty()) {
+    return {};
+  }
+  if (parts >= cpus.size()) {
+    return {cpus[index % cpus.size()]};
+  }
+  auto begin = cpus.begin() + static_cast<std::ptrdiff_t>(index * cpus.size() / parts);
+  auto end = cpus.begin() + static_cast<std::ptrdiff_t>((index + 1) * cpus.size() / parts);
+  return {begin, end};
+}
+
+int env_int(std::initializer_list<const char*> names, int fallback) {
+  for (const auto* name : names) {
+    const char* value = std::getenv(name);
+    if (value != nullptr && *value != '\0') {
+      return std::atoi(value);
+    }
+  }
+  return fallback;
+}
+
+}  // namespace
+
+const char* ppc::core::pin_policy_name(PinPolicy policy) {
+  switch (policy) {
+    case PinPolicy::COMPACT:
+      return "compact";
+    case PinPolicy::SCATTER:
+      return "scatter";
+    default:
+      return "none";
+  }
+}
+
+ppc::core::PinPolicy ppc::core::pin_policy_from_env() {
+  const char* value = std::getenv("PPC_PIN");
+  if (value == nullptr || *value == '\0') {
+    return PinPolicy::NONE;
+  }
+  std::string str(value);
+  for (auto policy : {PinPolicy::NONE, PinPolicy::COMPACT, PinPolicy::SCATTER}) {
+    if (str == pin_policy_name(policy)) {
+      return policy;
+    }
+  }
+  throw std::invalid_argument("PPC_PIN must be 'none', 'compact' or 'scatter', got: " + str);
+}
+
+ppc::core::CpuTopology ppc::core::CpuTopology::detect() {
+  auto cpus = current_affinity();
+  if (cpus.empty()) {
+    for (int cpu = 0; cpu < static_cast<int>(std::max(1U, std::thread::hardware_concurrency())); cpu++) {
+      cpus.push_back(cpu);
+    }
+  }
+  std::vector<std::pair<int, int>> by_node;
+  by_node.reserve(cpus.size());
+  for (int cpu : cpus) {
+    by_node.emplace_back(node_of(cpu), cpu);
+  }
+  std::sort(by_node.begin(), by_node.end());
+
+  CpuTopology topology;
+  std::set<int> nodes;
+  for (const auto& [node, cpu] : by_node) {
+    topology.cpus.push_back(cpu);
+    topology.nodes.push_back(node);
+    nodes.insert(node);
+  }
+  topology.num_nodes = static_cast<int>(nodes.size());
+  return topology;
+}
+
+std::vector<int> ppc::core::worker_cpus(PinPolicy policy, const CpuTopology& topology, std::size_t count) {
+  if (policy == PinPolicy::NONE || topology.cpus.empty()) {
+    return {};
+  }
+  std::vector<int> order = topology.cpus;
+  if (policy == PinPolicy::SCATTER) {
+    // one CPU of every node in turn
+    auto groups = cpus_by_node(topology);
+    order.clear();
+    for (size_t i = 0; order.size() < topology.cpus.size(); i++) {
+      for (const auto& group : groups) {
+        if (i < group.size()) {
+          order.push_back(group[i]);
+        }
+      }
+    }
+  }
+  std::vector<int> result(count);
+  for (size_t i = 0; i < count; i++) {
+    result[i] = order[i % order.size()];
+  }
+  return result;
+}
+
+std::vector<int> ppc::core::rank_cpus(PinPolicy policy, const CpuTopology& topology, int local_rank, int local_size) {
+  if (policy == PinPolicy::NONE || topology.cpus.empty()) {
+    return {};
+  }
+  auto size = static_cast<size_t>(std::max(local_size, 1));
+  auto rank = static_cast<size_t>(std::max(local_rank, 0)) % size;
+  if (policy == PinPolicy::COMPACT) {
+    return block_of(topology.cpus, rank, size);
+  }
+  // rank r goes to node r % G and shares it with the other ranks of that node
+  auto groups = cpus_by_node(topology);
+  auto node = rank % groups.size();
+  auto ranks_on_node = (size - node + groups.size() - 1) / groups.size();
+  return block_of(groups[node], rank / groups.size(), ranks_on_node);
+}
+
+bool ppc::core::pin_current_thread(const std::vector<int>& cpus) {
+#if defined(__linux__)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  bool any = false;
+  for (int cpu : cpus) {
+    if (cpu >= 0 && cpu < CPU_SETSIZE) {
+      CPU_SET(cpu, &set);
+      any = true;
+    }
+  }
+  return any && sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+  static_cast<void>(cpus);
+  return false;
+#endif
+}
+
+std::vector<int> ppc::core::current_affinity() {
+  std::vector<int> cpus;
+#if defined(__linux__)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+      if (CPU_ISSET(cpu, &set)) {
+        cpus.push_back(cpu);
+      }
+    }
+  }
+#endif
+  return cpus;
+}
+
+std::vector<int> ppc::core::pinned_worker_cpus(std::size_t count) {
+  // workers cannot report a bad PPC_PIN; Placement::current() does in perf runs
+  PinPolicy policy = PinPolicy::NONE;
+  try {
+    policy = pin_policy_from_env();
+  } catch (const std::invalid_argument&) {
+    return {};
+  }
+  if (policy == PinPolicy::NONE || count == 0) {
+    return {};
+  }
+  return worker_cpus(policy, CpuTopology::detect(), count);
+}
+
+bool ppc::core::pin_worker(std::size_t index, std::size_t count) {
+  auto cpus = pinned_worker_cpus(count);
+  if (cpus.empty()) {
+    return false;
+  }
+  return pin_current_thread({cpus[index % count]});
+}
+
+bool ppc::core::pin_rank() {
+  auto policy = pin_policy_from_env();
+  if (policy == PinPolicy::NONE) {
+    return false;
+  }
+  auto topology = CpuTopology::detect();
+  auto online = static_cast<size_t>(std::max(1U, std::thread::hardware_concurrency()));
+  if (topology.cpus.size() < online) {
+    return false;
+  }
+  auto local_rank = env_int({"OMPI_COMM_WORLD_LOCAL_RANK", "MPI_LOCALRANKID", "SLURM_LOCALID"}, 0);
+  auto local_size = env_int({"OMPI_COMM_WORLD_LOCAL_SIZE", "MPI_LOCALNRANKS"}, 1);
+  return pin_current_thread(rank_cpus(policy, topology, local_rank, local_size));
+}
+
+void ppc::core::first_touch(void* data, std::size_t bytes, const std::vector<int>& cpus) {
+  auto* bytes_ptr = static_cast<unsigned char*>(data);
+  if (cpus.size() <= 1) {
+    std::memset(bytes_ptr, 0, bytes);
+    return;
+  }
+  std::vector<std::thread> threads;
+  threads.reserve(cpus.size());
+  for (size_t i = 0; i < cpus.size(); i++) {
+    auto begin = i * bytes / cpus.size();
+    auto end = (i + 1) * bytes / cpus.size();
+    threads.emplace_back([=] {
+      pin_current_thread({cpus[i]});
+      std::memset(bytes_ptr + begin, 0, end - begin);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+std::string ppc::core::format_cpu_list(const std::vector<int>& cpus) {
+  std::vector<int> sorted(cpus);
+  std::sort(sorted.begin(), sorted.end());
+  sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+  std::stringstream out;
+  for (size_t i = 0; i < sorted.size();) {
+    size_t j = i;
+    while (j + 1 < sorted.size() && sorted[j + 1] == sorted[j] + 1) {
+      j++;
+    }
+    out << (i == 0 ? "" : ",") << sorted[i];
+    if (j > i) {
+      out << '-' << sorted[j];
+    }
+    i = j + 1;
+  }
+  return out.str();
+}
+
+std::vector<int> ppc::core::parse_cpu_list(const std::string& str) {
+  std::vector<int> cpus;
+  std::stringstream in(str);
+  for (std::string range; std::getline(in, range, ',');) {
+    if (range.empty()) {
+      continue;
+    }
+    auto dash = range.find('-');
+    int first = std::atoi(range.c_str());
+    int last = dash == std::string::npos ? first : std::atoi(range.c_str() + dash + 1);
+    for (int cpu = first; cpu <= last; cpu++) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+ppc::core::Placement ppc::core::Placement::current() {
+  Placement placement;
+  placement.policy = pin_policy_name(pin_policy_from_env());
+  placement.cpus = CpuTopology::detect().cpus;
+  std::sort(placement.cpus.begin(), placement.cpus.end());
+  std::set<int> nodes;
+  for (int cpu : placement.cpus) {
+    nodes.insert(node_of(cpu));
+  }
+  placement.nodes.assign(nodes.begin(), nodes.end());
+  return placement;
+}
@@ -0,0 +1,209 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <cctype>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "core/stream/include/stream.hpp"
+#include "core/task/include/data_view.hpp"
+
+namespace {
+
+const std::string kText = "  the quick brown fox\njumps over   the lazy dog\n\tagain ";
+const uint64_t kWords = 10;
+
+bool is_letter(char c) { return std::isspace(static_cast<unsigned char>(c)) == 0; }
+
+// Counts words of a text; a word split between chunks is carried in in_word
+class WordCountTask : public ppc::core::StreamingTask {
+ public:
+  using StreamingTask::StreamingTask;
+
+  bool pre_processing() override {
+    internal_order_test();
+    words = 0;
+    in_word = false;
+    return true;
+  }
+
+  bool validation() override {
+    internal_order_test();
+    return taskData->outputs_count[0] == 1 && (is_streaming() || taskData->inputs_count.size() == 1);
+  }
+
+  bool post_processing() override {
+    internal_order_test();
+    reinterpret_cast<uint64_t *>(taskData->outputs[0])[0] = words;
+    return true;
+  }
+
+ protected:
+  bool consume(const ppc::core::Chunk &chunk) override {
+    for (auto c : chunk.as<char>()) {
+      words += is_letter(c) && !in_word ? 1 : 0;
+      in_word = is_letter(c);
+    }
+    return true;
+  }
+
+ private:
+  uint64_t words = 0;
+  bool in_word = false;
+};
+
+// Words of a text piece; the flags let adjacent pieces join a word split
+// between them
+struct WordState {
+  uint64_t words = 0;
+  bool empty = true;
+  bool starts_in_word = false;
+  bool ends_in_word = false;
+};
+
+void count_words(WordState &state, const ppc::core::Chunk &chunk) {
+  for (auto c : chunk.as<char>()) {
+    if (state.empty) {
+      state.starts_in_word = is_letter(c);
+      state.empty = false;
+    }
+    state.words += is_letter(c) && !state.ends_in_word ? 1 : 0;
+    state.ends_in_word = is_letter(c);
+  }
+}
+
+WordState merge_words(WordState left, WordState right) {
+  if (left.empty || right.empty) {
+    return left.empty ? right : left;
+  }
+  left.words += right.words - (left.ends_in_word && right.starts_in_word ? 1 : 0);
+  left.ends_in_word = right.ends_in_word;
+  return left;
+}
+
+}  // namespace
+
+TEST(stream_tests, check_chunk_reader) {
+  std::vector<uint8_t> data(10);
+  std::iota(data.begin(), data.end(), 0);
+  ppc::core::ChunkReader reader(std::make_shared<ppc::core::MemorySource>(data.data(), data.size()), 4);
+
+  std::vector<size_t> sizes;
+  std::vector<uint64_t> offsets;
+  std::vector<bool> last;
+  while (auto chunk = reader.next()) {
+    sizes.push_back(chunk->bytes.size());
+    offsets.push_back(chunk->offset);
+    last.push_back(chunk->last);
+    EXPECT_EQ(chunk->bytes[0], chunk->offset);
+  }
+  EXPECT_EQ(sizes, std::vector<size_t>({4, 4, 2}));
+  EXPECT_EQ(offsets, std::vector<uint64_t>({0, 4, 8}));
+  EXPECT_EQ(last, std::vector<bool>({false, false, true}));
+
+  reader.rewind();
+  EXPECT_EQ(reader.next()->index, 0U);
+
+  // chunks hold whole elements
+  std::vector<int> ints(5, 1);
+  ppc::core::ChunkReader int_reader(std::make_shared<ppc::core::MemorySource>(ints.data(), 18), 6, sizeof(int));
+  EXPECT_EQ(int_reader.chunk_bytes(), sizeof(int));
+  for (int i = 0; i < 3; i++) {
+    EXPECT_EQ(int_reader.next()->as<int>().size(), 1U);
+  }
+  // the read-ahead behind the fourth element hits the torn fifth one
+  EXPECT_THROW(static_cast<void>(int_reader.next()), std::runtime_error);
+  EXPECT_THROW(ppc::core::ChunkReader(nullptr, 4), std::invalid_argument);
+}
+
+TEST(stream_tests, check_word_split_across_chunks) {
+  std::vector<uint64_t> out(1, 0);
+  auto make_data = [&] {
+    auto taskData = std::make_shared<ppc::core::TaskData>();
+    ppc::core::add_output(*taskData, out.data(), {1});
+    return taskData;
+  };
+
+  // whole buffer
+  auto inMemory = make_data();
+  ppc::core::add_input(*inMemory, kText.data(), {kText.size()});
+  WordCountTask task(inMemory);
+  ASSERT_TRUE(task.validation());
+  task.pre_processing();
+  task.run();
+  task.post_processing();
+  EXPECT_EQ(out[0], kWords);
+
+  // every chunk size cuts some word in two; the second pipeline rewinds the stream
+  for (size_t chunk_bytes = 1; chunk_bytes <= 8; chunk_bytes++) {
+    WordCountTask streamed(make_data(), std::make_shared<ppc::core::MemorySource>(kText.data(), kText.size()),
+                           chunk_bytes);
+    EXPECT_TRUE(streamed.is_streaming());
+    for (int run = 0; run < 2; run++) {
+      out[0] = 0;
+      ASSERT_TRUE(streamed.validation());
+      streamed.pre_processing();
+      streamed.run();
+      streamed.post_processing();
+      EXPECT_EQ(out[0], kWords) << "chunk of " << chunk_bytes;
+    }
+  }
+}
+
+TEST(stream_tests, check_parallel_reduction) {
+  for (size_t workers : {1, 3}) {
+    for (size_t chunk_bytes : {1, 3, 7, 64}) {
+      ppc::core::ChunkReader reader(std::make_shared<ppc::core::MemorySource>(kText.data(), kText.size()),
+                                    chunk_bytes);
+      auto state = ppc::core::reduce_stream(reader, workers, WordState(), count_words, merge_words);
+      EXPECT_EQ(state.words, kWords) << workers << " workers, chunk of " << chunk_bytes;
+    }
+  }
+
+  std::vector<int64_t> values(10000);
+  std::iota(values.begin(), values.end(), 1);
+  ppc::core::ChunkReader reader(
+      std::make_shared<ppc::core::MemorySource>(values.data(), values.size() * sizeof(int64_t)), 1000,
+      sizeof(int64_t));
+  auto sum = ppc::core::reduce_stream(
+      reader, 4, int64_t{0},
+      [](int64_t &total, const ppc::core::Chunk &chunk) {
+        for (auto value : chunk.as<int64_t>()) {
+          total += value;
+        }
+      },
+      [](int64_t left, int64_t right) { return left + right; });
+  EXPECT_EQ(sum, 10000 * 10001 / 2);
+}
+
+TEST(stream_tests, check_file_source_and_errors) {
+  auto path = (std::filesystem::temp_directory_path() / "ppc_stream_test.txt").string();
+  {
+    std::ofstream out(path, std::ios::binary);
+    out << kText;
+  }
+  // bytes [2, 21): "the quick brown fox"
+  ppc::core::ChunkReader reader(std::make_shared<ppc::core::FileSource>(path, 2, 21), 5);
+  std::string text;
+  ppc::core::for_each_chunk(reader, 1, [&](const ppc::core::Chunk &chunk) {
+    text.append(chunk.as<char>().begin(), chunk.as<char>().end());
+  });
+  EXPECT_EQ(text, "the quick brown fox");
+
+  ppc::core::ChunkReader whole(std::make_shared<ppc::core::FileSource>(path), 4);
+  EXPECT_THROW(ppc::core::for_each_chunk(whole, 3,
+                                         [](const ppc::core::Chunk &chunk) {
+                                           if (chunk.index == 5) {
+                                             throw std::runtime_error("bad chunk");
+                                           }
+                                         }),
+               std::runtime_error);
+  std::filesystem::remove(path);
+  EXPECT_THROW(ppc::core::FileSource{path}, std::runtime_error);
+}
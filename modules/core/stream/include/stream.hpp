@@ -0,0 +1,170 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_STREAM_HPP_
+#define MODULES_CORE_INCLUDE_STREAM_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/task/include/task.hpp"
+
+namespace ppc::core {
+
+// A piece of a stream handed to a task
+struct Chunk {
+  std::span<const uint8_t> bytes;
+  // position of the chunk in the stream and of its first byte
+  uint64_t index = 0;
+  uint64_t offset = 0;
+  // no data follows: state spanning chunks (an unfinished word) must be
+  // settled now
+  bool last = false;
+
+  template <class T>
+  [[nodiscard]] std::span<const T> as() const {
+    return {reinterpret_cast<const T *>(bytes.data()), bytes.size() / sizeof(T)};
+  }
+};
+
+// Where a stream comes from
+class ChunkSource {
+ public:
+  virtual ~ChunkSource() = default;
+  // copy up to max_bytes of the stream into buffer; 0 at the end
+  virtual std::size_t read(uint8_t *buffer, std::size_t max_bytes) = 0;
+  // start over so a task can be run again; throws std::logic_error if the
+  // source cannot
+  virtual void rewind() = 0;
+};
+
+class MemorySource : public ChunkSource {
+ public:
+  MemorySource(const void *data_, std::size_t size_);
+  std::size_t read(uint8_t *buffer, std::size_t max_bytes) override;
+  void rewind() override { position = 0; }
+
+ private:
+  const uint8_t *data;
+  std::size_t size;
+  std::size_t position = 0;
+};
+
+// Bytes [begin, end) of a file, read as needed
+class FileSource : public ChunkSource {
+ public:
+  static constexpr uint64_t kToEnd = std::numeric_limits<uint64_t>::max();
+
+  // throws std::runtime_error if the file cannot be opened
+  explicit FileSource(const std::string &path, uint64_t begin_ = 0, uint64_t end_ = kToEnd);
+  std::size_t read(uint8_t *buffer, std::size_t max_bytes) override;
+  void rewind() override;
+
+ private:
+  std::ifstream file;
+  uint64_t begin;
+  uint64_t end;
+  uint64_t position;
+};
+
+// Cuts a source into chunks of chunk_bytes holding whole elements of
+// element_size (chunk_bytes is rounded down to a multiple of it); the last
+// chunk may be shorter. Memory stays at two chunks however long the stream
+// is: one returned, one read ahead to know whether it is the last.
+class ChunkReader {
+ public:
+  // throws std::invalid_argument for zero sizes
+  ChunkReader(std::shared_ptr<ChunkSource> source_, std::size_t chunk_bytes_, std::size_t element_size_ = 1);
+
+  // next chunk, nothing at the end; its bytes stay valid until the next call.
+  // Throws std::runtime_error if the stream ends inside an element.
+  std::optional<Chunk> next();
+  // start the stream over (see ChunkSource::rewind())
+  void rewind();
+
+  [[nodiscard]] std::size_t chunk_bytes() const { return chunk_size; }
+
+ private:
+  std::size_t fill(std::vector<uint8_t> &buffer);
+
+  std::shared_ptr<ChunkSource> source;
+  std::size_t chunk_size;
+  std::size_t element_size;
+  std::vector<uint8_t> current;
+  std::vector<uint8_t> ahead;
+  std::size_t ahead_size = 0;
+  bool started = false;
+  uint64_t index = 0;
+  uint64_t offset = 0;
+};
+
+// Run body on every chunk of reader from num_workers threads (0 -
+// get_num_threads()) while the calling thread reads ahead. At most
+// 2 * num_workers chunks are held at a time. An exception thrown by body is
+// rethrown after the workers have stopped.
+void for_each_chunk(ChunkReader &reader, std::size_t num_workers, const std::function<void(const Chunk &)> &body);
+
+// Parallel reduction of a stream: consume(state, chunk) folds one chunk into
+// a fresh copy of init, merge(left, right) combines the states of adjacent
+// stream pieces and is applied in stream order, so state spanning chunk
+// boundaries can be fixed up there (e.g. a word split between left and
+// right).
+template <class State, class Consume, class Merge>
+State reduce_stream(ChunkReader &reader, std::size_t num_workers, const State &init, Consume consume, Merge merge) {
+  State total = init;
+  uint64_t next_index = 0;
+  std::map<uint64_t, State> pending;
+  std::mutex mutex;
+  for_each_chunk(reader, num_workers, [&](const Chunk &chunk) {
+    State state = init;
+    consume(state, chunk);
+    std::lock_guard<std::mutex> lock(mutex);
+    pending.emplace(chunk.index, std::move(state));
+    for (auto it = pending.begin(); it != pending.end() && it->first == next_index; it = pending.erase(it)) {
+      total = merge(std::move(total), std::move(it->second));
+      next_index++;
+    }
+  });
+  return total;
+}
+
+// Task fed by a stream: run() passes the input to consume() chunk by chunk.
+// Without a source the whole of inputs[0] is consumed as a single last chunk,
+// so one implementation serves both in-memory and streamed inputs. Reset
+// the state spanning chunks in pre_processing() and write the result in
+// post_processing().
+class StreamingTask : public Task {
+ public:
+  static constexpr std::size_t kDefaultChunkBytes = std::size_t{1} << 20;
+
+  explicit StreamingTask(std::shared_ptr<TaskData> taskData_, std::shared_ptr<ChunkSource> source_ = nullptr,
+                         std::size_t chunk_bytes = kDefaultChunkBytes, std::size_t element_size_ = 1);
+
+  // rewinds the source on every run after the first, so each pipeline run
+  // sees the whole stream; an empty input gives one empty last chunk
+  bool run() final;
+
+  [[nodiscard]] bool is_streaming() const { return reader != nullptr; }
+
+ protected:
+  virtual bool consume(const Chunk &chunk) = 0;
+
+ private:
+  std::unique_ptr<ChunkReader> reader;
+  std::size_t element_size;
+  bool streamed = false;
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_STREAM_HPP_
@@ -0,0 +1,236 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/stream/include/stream.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+
+#include "core/perf/include/scaling.hpp"
+
+ppc::core::MemorySource::MemorySource(const void *data_, std::size_t size_)
+    : data(static_cast<const uint8_t *>(data_)), size(size_) {}
+
+std::size_t ppc::core::MemorySource::read(uint8_t *buffer, std::size_t max_bytes) {
+  auto count = std::min(max_bytes, size - position);
+  std::memcpy(buffer, data + position, count);
+  position += count;
+  return count;
+}
+
+ppc::core::FileSource::FileSource(const std::string &path, uint64_t begin_, uint64_t end_)
+    : file(path, std::ios::binary), begin(begin_), end(end_), position(begin_) {
+  if (!file.is_open()) {
+    throw std::runtime_error("Cannot open file: " + path);
+  }
+  file.seekg(0, std::ios::end);
+  end = std::min(end, static_cast<uint64_t>(file.tellg()));
+  begin = std::min(begin, end);
+  rewind();
+}
+
+std::size_t ppc::core::FileSource::read(uint8_t *buffer, std::size_t max_bytes) {
+  auto count = static_cast<std::size_t>(std::min<uint64_t>(max_bytes, end - position));
+  if (count == 0) {
+    return 0;
+  }
+  file.read(reinterpret_cast<char *>(buffer), static_cast<std::streamsize>(count));
+  auto got = static_cast<std::size_t>(file.gcount());
+  position += got;
+  return got;
+}
+
+void ppc::core::FileSource::rewind() {
+  file.clear();
+  file.seekg(static_cast<std::streamoff>(begin));
+  position = begin;
+}
+
+ppc::core::ChunkReader::ChunkReader(std::shared_ptr<ChunkSource> source_, std::size_t chunk_bytes_,
+                                    std::size_t element_size_)
+    : source(std::move(source_)), chunk_size(chunk_bytes_), element_size(element_size_) {
+  if (!source || chunk_size == 0 || element_size == 0) {
+    throw std::invalid_argument("Chunk reader needs a source and non-zero chunk and element sizes");
+  }
+  chunk_size = std::max(element_size, chunk_size / element_size * element_size);
+  current.resize(chunk_size);
+  ahead.resize(chunk_size);
+}
+
+std::size_t ppc::core::ChunkReader::fill(std::vector<uint8_t> &buffer) {
+  // sources may return less than asked before the end
+  std::size_t size = 0;
+  while (size < buffer.size()) {
+    auto count = source->read(buffer.data() + size, buffer.size() - size);
+    if (count == 0) {
+      break;
+    }
+    size += count;
+  }
+  if (size % element_size != 0) {
+    throw std::runtime_error("Stream ends inside an element of " + std::to_string(element_size) + " bytes");
+  }
+  return size;
+}
+
+std::optional<ppc::core::Chunk> ppc::core::ChunkReader::next() {
+  if (!started) {
+    ahead_size = fill(ahead);
+    started = true;
+  }
+  if (ahead_size == 0) {
+    return std::nullopt;
+  }
+  std::swap(current, ahead);
+  auto size = ahead_size;
+  ahead_size = fill(ahead);
+
+  Chunk chunk;
+  chunk.bytes = std::span<const uint8_t>(current.data(), size);
+  chunk.index = index++;
+  chunk.offset = offset;
+  chunk.last = ahead_size == 0;
+  offset += size;
+  return chunk;
+}
+
+void ppc::core::ChunkReader::rewind() {
+  source->rewind();
+  started = false;
+  ahead_size = 0;
+  index = 0;
+  offset = 0;
+}
+
+void ppc::core::for_each_chunk(ChunkReader &reader, std::size_t num_workers,
+                               const std::function<void(const Chunk &)> &body) {
+  if (num_workers == 0) {
+    num_workers = static_cast<std::size_t>(get_num_threads());
+  }
+  if (num_workers == 1) {
+    while (auto chunk = reader.next()) {
+      body(*chunk);
+    }
+    return;
+  }
+
+  struct Item {
+    Chunk chunk;
+    std::vector<uint8_t> bytes;
+  };
+  std::mutex mutex;
+  std::condition_variable changed;
+  std::deque<Item> queue;
+  std::vector<std::vector<uint8_t>> free_buffers(2 * num_workers);
+  bool done = false;
+  std::exception_ptr error;
+
+  std::vector<std::thread> workers;
+  workers.reserve(num_workers);
+  for (std::size_t i = 0; i < num_workers; i++) {
+    workers.emplace_back([&] {
+      std::unique_lock<std::mutex> lock(mutex);
+      while (true) {
+        changed.wait(lock, [&] { return !queue.empty() || done; });
+        if (queue.empty()) {
+          return;
+        }
+        Item item = std::move(queue.front());
+        queue.pop_front();
+        lock.unlock();
+        try {
+          item.chunk.bytes = std::span<const uint8_t>(item.bytes.data(), item.bytes.size());
+          body(item.chunk);
+        } catch (...) {
+          std::lock_guard<std::mutex> guard(mutex);
+          if (!error) {
+            error = std::current_exception();
+          }
+        }
+        lock.lock();
+        free_buffers.push_back(std::move(item.bytes));
+        changed.notify_all();
+      }
+    });
+  }
+
+  try {
+    while (true) {
+      std::vector<uint8_t> buffer;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [&] { return !free_buffers.empty() || error; });
+        if (error) {
+          break;
+        }
+        buffer = std::move(free_buffers.back());
+        free_buffers.pop_back();
+      }
+      auto chunk = reader.next();
+      if (!chunk) {
+        break;
+      }
+      buffer.assign(chunk->bytes.begin(), chunk->bytes.end());
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back({*chunk, std::move(buffer)});
+      }
+      changed.notify_one();
+    }
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!error) {
+      error = std::current_exception();
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    done = true;
+  }
+  changed.notify_all();
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+ppc::core::StreamingTask::StreamingTask(std::shared_ptr<TaskData> taskData_, std::shared_ptr<ChunkSource> source_,
+                                        std::size_t chunk_bytes, std::size_t element_size_)
+    : Task(std::move(taskData_)), element_size(element_size_) {
+  if (source_) {
+    reader = std::make_unique<ChunkReader>(std::move(source_), chunk_bytes, element_size);
+  }
+}
+
+bool ppc::core::StreamingTask::run() {
+  internal_order_test();
+  if (!reader) {
+    Chunk chunk;
+    chunk.bytes = std::span<const uint8_t>(taskData->inputs[0], taskData->inputs_count[0] * element_size);
+    chunk.last = true;
+    return consume(chunk);
+  }
+  if (streamed) {
+    reader->rewind();
+  }
+  streamed = true;
+  auto chunk = reader->next();
+  if (!chunk) {
+    // an empty stream still ends with a last chunk, as an empty buffer does
+    Chunk empty;
+    empty.last = true;
+    return consume(empty);
+  }
+  for (; chunk; chunk = reader->next()) {
+    if (!consume(*chunk)) {
+      return false;
+    }
+  }
+  return true;
+}
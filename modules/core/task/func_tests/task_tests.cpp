@@ -1,10 +1,14 @@
 // Copyright 2023 Nesterov Alexander
 #include <gtest/gtest.h>
 
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 #include "core/task/func_tests/test_task.hpp"
+#include "core/task/include/data_view.hpp"
 #include "core/task/include/task.hpp"
+#include "core/task/include/time_limit.hpp"
 
 TEST(task_tests, check_int32_t) {
   // Create data
@@ -134,6 +138,7 @@ TEST(task_tests, check_float) {
   EXPECT_NEAR(out[0], in.size(), 1e-3);
 }
 
+#ifndef DISABLE_ORDER_CHECK
 TEST(task_tests, check_wrong_order) {
   // Create data
   std::vector<float> in(20, 1);
@@ -151,10 +156,304 @@ TEST(task_tests, check_wrong_order) {
   bool isValid = testTask.validation();
   ASSERT_EQ(isValid, true);
   testTask.pre_processing();
-  ASSERT_ANY_THROW(testTask.post_processing());
+  try {
+    testTask.post_processing();
+    FAIL() << "post_processing() after pre_processing() must throw";
+  } catch (const std::invalid_argument &error) {
+    std::string message = error.what();
+    EXPECT_NE(message.find("Serial number: 3"), std::string::npos);
+    EXPECT_NE(message.find("Yours function: post_processing"), std::string::npos);
+    EXPECT_NE(message.find("Expected function: run"), std::string::npos);
+  }
+}
+#else
+TEST(task_tests, check_order_check_disabled) {
+  // Create data
+  std::vector<float> in(20, 1);
+  std::vector<float> out(1, 0);
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task; outside of a FUNC run no time limit needs the stage clock
+  ppc::test::TestTask<float> testTask(taskData);
+  taskData->state_of_testing = ppc::core::TaskData::StateOfTesting::PERF;
+  ASSERT_TRUE(testTask.validation());
+  testTask.pre_processing();
+  EXPECT_NO_THROW(testTask.post_processing());
+  const auto &timings = testTask.stage_timings();
+  EXPECT_EQ(timings.count(ppc::core::TaskStage::VALIDATION), 0U);
+  EXPECT_EQ(timings.count(ppc::core::TaskStage::POST_PROCESSING), 0U);
+
+  // requested timings are recorded without the check
+  testTask.time_stages(true);
+  testTask.validation();
+  testTask.pre_processing();
+  testTask.run();
+  testTask.post_processing();
+  testTask.close_stage();
+  EXPECT_EQ(timings.count(ppc::core::TaskStage::VALIDATION), 1U);
+  EXPECT_EQ(timings.count(ppc::core::TaskStage::RUN), 1U);
+  EXPECT_EQ(timings.count(ppc::core::TaskStage::POST_PROCESSING), 1U);
+}
+#endif
+
+TEST(task_tests, check_input_output_views) {
+  // Create data
+  std::vector<int32_t> in(20, 1);
+  std::vector<int32_t> out(1, 0);
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Views alias the caller's memory
+  auto input = ppc::core::input_view<int32_t>(*taskData, 0);
+  auto output = ppc::core::output_view<int32_t>(*taskData, 0);
+  ASSERT_EQ(input.size(), in.size());
+  ASSERT_EQ(input.data(), in.data());
+  output[0] = 42;
+  ASSERT_EQ(out[0], 42);
+
+  ASSERT_ANY_THROW(ppc::core::input_view<int32_t>(*taskData, 1));
+  ASSERT_ANY_THROW(ppc::core::output_view<int32_t>(*taskData, 1));
+}
+
+TEST(task_tests, check_matrix_view) {
+  // Create data
+  std::vector<double> in(12);
+  for (size_t i = 0; i < in.size(); i++) {
+    in[i] = static_cast<double>(i);
+  }
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+
+  auto matrix = ppc::core::input_matrix_view<double>(*taskData, 0, 3, 4);
+  ASSERT_EQ(matrix.rows(), 3U);
+  ASSERT_EQ(matrix.cols(), 4U);
+  EXPECT_NEAR(matrix(1, 2), 6.0, 1e-6);
+  EXPECT_NEAR(matrix.row(2)[0], 8.0, 1e-6);
+  ASSERT_EQ(matrix.row(2).size(), 4U);
+  ASSERT_ANY_THROW(matrix.at(3, 0));
+  ASSERT_ANY_THROW(matrix.at(0, 4));
+  ASSERT_ANY_THROW(ppc::core::input_matrix_view<double>(*taskData, 0, 4, 4));
+}
+
+TEST(task_tests, check_buffer_desc) {
+  // Create data
+  std::vector<float> in(12, 1.0F);
+  std::vector<int32_t> sizes = {3, 4};
+  std::vector<float> out(3, 0.0F);
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(sizes.data()));
+  taskData->inputs_count.emplace_back(sizes.size());
+  ppc::core::add_input(*taskData, in.data(), {3, 4});
+  ppc::core::add_output(*taskData, out.data(), {3});
+
+  // Legacy buffers stay undescribed and accept any type
+  ASSERT_EQ(ppc::core::input_desc(*taskData, 0), nullptr);
+  ASSERT_TRUE(ppc::core::has_input<int32_t>(*taskData, 0));
+
+  const auto *desc = ppc::core::input_desc(*taskData, 1);
+  ASSERT_NE(desc, nullptr);
+  ASSERT_EQ(desc->dtype, ppc::core::DataType::FLOAT);
+  ASSERT_EQ(desc->size(), in.size());
+  ASSERT_EQ(desc->strides, std::vector<size_t>({4, 1}));
+  ASSERT_TRUE(desc->is_contiguous());
+  ASSERT_GE(desc->alignment, alignof(float));
+  ASSERT_EQ(taskData->inputs_count[1], in.size());
+
+  ASSERT_TRUE(ppc::core::has_input<float>(*taskData, 1, 2));
+  ASSERT_FALSE(ppc::core::has_input<float>(*taskData, 1, 1));
+  ASSERT_FALSE(ppc::core::has_input<double>(*taskData, 1));
+  ASSERT_FALSE(ppc::core::has_input<float>(*taskData, 2));
+  ASSERT_TRUE(ppc::core::has_output<float>(*taskData, 0, 1));
+  ASSERT_ANY_THROW(ppc::core::input_view<double>(*taskData, 1));
+
+  auto matrix = ppc::core::input_matrix_view<float>(*taskData, 1);
+  ASSERT_EQ(matrix.rows(), 3U);
+  ASSERT_EQ(matrix.cols(), 4U);
+  ASSERT_ANY_THROW(ppc::core::input_matrix_view<int32_t>(*taskData, 0));
+}
+
+TEST(task_tests, check_padded_matrix_desc) {
+  // 2x3 matrix stored with a row pitch of 4 elements
+  std::vector<int32_t> in = {1, 2, 3, -1, 4, 5, 6, -1};
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  ppc::core::add_input(*taskData, in.data(), {2, 3});
+  taskData->inputs_desc[0].strides = {4, 1};
+  ASSERT_FALSE(taskData->inputs_desc[0].is_contiguous());
+  ASSERT_THROW(ppc::core::input_view<int32_t>(*taskData, 0), std::invalid_argument);
+
+  auto matrix = ppc::core::input_matrix_view<int32_t>(*taskData, 0);
+  ASSERT_EQ(matrix.row_stride(), 4U);
+  ASSERT_EQ(matrix(1, 0), 4);
+  ASSERT_EQ(matrix.row(1)[2], 6);
+}
+
+TEST(task_tests, check_64bit_counts) {
+  // Create data
+  std::vector<uint8_t> in(1, 1);
+
+  // Counts and shapes are not truncated to 32 bits
+  const uint64_t huge_count = uint64_t{1} << 33;
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs_count.emplace_back(huge_count);
+  ASSERT_EQ(taskData->inputs_count[0], huge_count);
+
+  auto desc = ppc::core::make_buffer_desc(in.data(), {uint64_t{1} << 17, uint64_t{1} << 16});
+  ASSERT_EQ(desc.size(), huge_count);
+  ASSERT_EQ(desc.strides[0], uint64_t{1} << 16);
+}
+
+TEST(task_tests, check_stage_timings) {
+  // Create data
+  std::vector<int32_t> in(20, 1);
+  std::vector<int32_t> out(1, 0);
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task; without the order check timings are kept only on request
+  ppc::test::TestTask<int32_t> testTask(taskData);
+  testTask.time_stages(true);
+  ASSERT_EQ(testTask.validation(), true);
+  testTask.pre_processing();
+  testTask.run();
+  testTask.run();
+  testTask.post_processing();
+  testTask.close_stage();
+
+  const auto &timings = testTask.stage_timings();
+  EXPECT_EQ(timings.count(ppc::core::TaskStage::VALIDATION), 1U);
+  EXPECT_EQ(timings.count(ppc::core::TaskStage::PRE_PROCESSING), 1U);
+  EXPECT_EQ(timings.count(ppc::core::TaskStage::RUN), 2U);
+  EXPECT_EQ(timings.count(ppc::core::TaskStage::POST_PROCESSING), 1U);
+  for (auto total : timings.total_sec) {
+    EXPECT_GE(total, 0.0);
+  }
+
+  testTask.reset_stage_timings();
+  EXPECT_EQ(testTask.stage_timings().count(ppc::core::TaskStage::RUN), 0U);
+  EXPECT_DOUBLE_EQ(testTask.stage_timings().mean(ppc::core::TaskStage::RUN), 0.0);
+}
+
+TEST(task_tests, check_reset_and_rebind) {
+  // Create data
+  std::vector<int32_t> in(20, 1);
+  std::vector<int32_t> out(1, 0);
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task; an aborted cycle is restarted with reset()
+  ppc::test::TestTask<int32_t> testTask(taskData);
+  ASSERT_EQ(testTask.validation(), true);
+  testTask.pre_processing();
+  if (ppc::core::kCheckStageOrder) {
+    ASSERT_ANY_THROW(testTask.validation());
+  }
+  testTask.reset();
+  ASSERT_EQ(testTask.validation(), true);
+  testTask.pre_processing();
+  testTask.run();
+  testTask.post_processing();
+  ASSERT_EQ(static_cast<size_t>(out[0]), in.size());
+
+  // Same task on other buffers
+  std::vector<int32_t> in2(30, 2);
+  std::vector<int32_t> out2(1, 0);
+  std::shared_ptr<ppc::core::TaskData> taskData2 = std::make_shared<ppc::core::TaskData>();
+  taskData2->inputs.emplace_back(reinterpret_cast<uint8_t *>(in2.data()));
+  taskData2->inputs_count.emplace_back(in2.size());
+  taskData2->outputs.emplace_back(reinterpret_cast<uint8_t *>(out2.data()));
+  taskData2->outputs_count.emplace_back(out2.size());
+  testTask.rebind(taskData2);
+  ASSERT_EQ(testTask.get_data(), taskData2);
+  ASSERT_EQ(testTask.validation(), true);
+  testTask.pre_processing();
+  testTask.run();
+  testTask.post_processing();
+  ASSERT_EQ(out2[0], 60);
+  ASSERT_EQ(static_cast<size_t>(out[0]), in.size());
 }
 
 int main(int argc, char **argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
 }
+
+TEST(task_tests, check_time_limit_policy) {
+  if (!ppc::core::kCheckStageOrder) {
+    GTEST_SKIP() << "The FUNC time limit is compiled out with the order check";
+  }
+
+  // Create data
+  std::vector<int32_t> in(20, 1);
+  std::vector<int32_t> out(1, 0);
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  auto previous = ppc::core::time_limit_policy();
+  std::vector<ppc::core::TimeLimitViolation> violations;
+  ppc::core::TimeLimitPolicy policy;
+  policy.task_limit_sec = -1.0;
+  policy.on_violation = [&](const ppc::core::TimeLimitViolation &violation) { violations.push_back(violation); };
+  ppc::core::set_time_limit_policy(policy);
+
+  ppc::test::TestTask<int32_t> testTask(taskData);
+  ASSERT_TRUE(testTask.validation());
+  testTask.pre_processing();
+  testTask.run();
+  testTask.post_processing();
+  ASSERT_EQ(violations.size(), 1U);
+  EXPECT_EQ(violations[0].kind, ppc::core::TimeLimitKind::TASK);
+  EXPECT_DOUBLE_EQ(violations[0].limit_sec, -1.0);
+
+  // PERF runs have no time limit
+  taskData->state_of_testing = ppc::core::TaskData::StateOfTesting::PERF;
+  ASSERT_TRUE(testTask.validation());
+  testTask.pre_processing();
+  testTask.run();
+  testTask.post_processing();
+  EXPECT_EQ(violations.size(), 1U);
+
+  // a failing policy throws from post_processing()
+  taskData->state_of_testing = ppc::core::TaskData::StateOfTesting::FUNC;
+  policy = ppc::core::TimeLimitPolicy::fail();
+  policy.task_limit_sec = -1.0;
+  ppc::core::set_time_limit_policy(policy);
+  ASSERT_TRUE(testTask.validation());
+  testTask.pre_processing();
+  testTask.run();
+  EXPECT_THROW(testTask.post_processing(), std::runtime_error);
+
+  ppc::core::set_time_limit_policy(previous);
+}
@@ -6,12 +6,29 @@
 #include <gtest/gtest.h>
 
 #include <memory>
+#include <span>
 #include <vector>
 
+#include "core/task/include/data_view.hpp"
 #include "core/task/include/task.hpp"
 
 namespace ppc::test {
 
+// TaskData over the given buffers, each added with its 1D shape. Leave the
+// inputs empty for tasks whose inputs are wired later, e.g. by a TaskGraph.
+template <class T>
+std::shared_ptr<ppc::core::TaskData> make_data(const std::vector<std::span<T>> &inputs,
+                                               const std::vector<std::span<T>> &outputs) {
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  for (auto input : inputs) {
+    ppc::core::add_input(*taskData, input.data(), {input.size()});
+  }
+  for (auto output : outputs) {
+    ppc::core::add_output(*taskData, output.data(), {output.size()});
+  }
+  return taskData;
+}
+
 template <class T>
 class TestTask : public ppc::core::Task {
  public:
@@ -31,7 +48,7 @@ class TestTask : public ppc::core::Task {
 
   bool run() override {
     internal_order_test();
-    for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
+    for (size_t i = 0; i < taskData->inputs_count[0]; i++) {
       output_[0] += input_[i];
     }
     return true;
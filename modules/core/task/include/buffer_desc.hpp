@@ -0,0 +1,96 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_BUFFER_DESC_HPP_
+#define MODULES_CORE_INCLUDE_BUFFER_DESC_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ppc::core {
+
+enum class DataType : std::uint8_t {
+  UNKNOWN,
+  BOOL,
+  CHAR,
+  INT8,
+  UINT8,
+  INT16,
+  UINT16,
+  INT32,
+  UINT32,
+  INT64,
+  UINT64,
+  FLOAT,
+  DOUBLE
+};
+
+template <class T>
+constexpr DataType data_type_of() {
+  using U = std::remove_cv_t<T>;
+  if constexpr (std::is_same_v<U, bool>) {
+    return DataType::BOOL;
+  } else if constexpr (std::is_same_v<U, char>) {
+    return DataType::CHAR;
+  } else if constexpr (std::is_same_v<U, float>) {
+    return DataType::FLOAT;
+  } else if constexpr (std::is_same_v<U, double>) {
+    return DataType::DOUBLE;
+  } else if constexpr (std::is_integral_v<U> && sizeof(U) == 1) {
+    return std::is_signed_v<U> ? DataType::INT8 : DataType::UINT8;
+  } else if constexpr (std::is_integral_v<U> && sizeof(U) == 2) {
+    return std::is_signed_v<U> ? DataType::INT16 : DataType::UINT16;
+  } else if constexpr (std::is_integral_v<U> && sizeof(U) == 4) {
+    return std::is_signed_v<U> ? DataType::INT32 : DataType::UINT32;
+  } else if constexpr (std::is_integral_v<U> && sizeof(U) == 8) {
+    return std::is_signed_v<U> ? DataType::INT64 : DataType::UINT64;
+  } else {
+    return DataType::UNKNOWN;
+  }
+}
+
+const char *data_type_name(DataType type);
+
+// Self-describing layout of one TaskData buffer: element type, shape,
+// strides (in elements, row-major by default) and the alignment of the
+// base pointer. All queries are O(1) in the buffer size.
+struct BufferDesc {
+  DataType dtype = DataType::UNKNOWN;
+  std::size_t elem_size = 0;
+  std::vector<std::size_t> shape;
+  std::vector<std::size_t> strides;
+  std::size_t alignment = 0;
+
+  // number of logical elements (product of shape)
+  [[nodiscard]] std::size_t size() const;
+  [[nodiscard]] std::size_t rank() const { return shape.size(); }
+  [[nodiscard]] bool is_contiguous() const;
+  [[nodiscard]] bool is_described() const { return dtype != DataType::UNKNOWN; }
+
+  template <class T>
+  [[nodiscard]] bool holds() const {
+    return dtype == data_type_of<T>() && elem_size == sizeof(T);
+  }
+};
+
+std::vector<std::size_t> contiguous_strides(const std::vector<std::size_t> &shape);
+
+// largest power of two (up to 4096) dividing the address
+std::size_t pointer_alignment(const void *ptr);
+
+template <class T>
+BufferDesc make_buffer_desc(const T *data, std::vector<std::size_t> shape) {
+  BufferDesc desc;
+  desc.dtype = data_type_of<T>();
+  desc.elem_size = sizeof(T);
+  desc.strides = contiguous_strides(shape);
+  desc.shape = std::move(shape);
+  desc.alignment = pointer_alignment(data);
+  return desc;
+}
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_BUFFER_DESC_HPP_
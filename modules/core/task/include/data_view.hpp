@@ -0,0 +1,230 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_DATA_VIEW_HPP_
+#define MODULES_CORE_INCLUDE_DATA_VIEW_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "core/task/include/buffer_desc.hpp"
+#include "core/task/include/task.hpp"
+
+namespace ppc::core {
+
+// Descriptor of inputs[index] / outputs[index], or nullptr if the buffer
+// was pushed by hand without one
+inline const BufferDesc *input_desc(const TaskData &taskData, size_t index) {
+  if (index >= taskData.inputs_desc.size() || !taskData.inputs_desc[index].is_described()) {
+    return nullptr;
+  }
+  return &taskData.inputs_desc[index];
+}
+
+inline const BufferDesc *output_desc(const TaskData &taskData, size_t index) {
+  if (index >= taskData.outputs_desc.size() || !taskData.outputs_desc[index].is_described()) {
+    return nullptr;
+  }
+  return &taskData.outputs_desc[index];
+}
+
+namespace detail {
+
+inline void append_buffer(std::vector<uint8_t *> &buffers, std::vector<std::uint64_t> &counts,
+                          std::vector<BufferDesc> &descs, uint8_t *data, BufferDesc desc) {
+  // keep descriptors index-aligned with buffers added the old way
+  descs.resize(buffers.size());
+  buffers.emplace_back(data);
+  counts.emplace_back(desc.size());
+  descs.emplace_back(std::move(desc));
+}
+
+inline size_t buffer_size(const BufferDesc *desc, std::uint64_t count) {
+  return desc != nullptr ? desc->size() : static_cast<size_t>(count);
+}
+
+template <class T>
+void check_type(const BufferDesc *desc, size_t index) {
+  if (desc != nullptr && !desc->holds<T>()) {
+    throw std::invalid_argument("Buffer " + std::to_string(index) + " holds " + data_type_name(desc->dtype) +
+                                ", requested " + data_type_name(data_type_of<T>()));
+  }
+}
+
+}  // namespace detail
+
+// Register a typed buffer together with its shape. inputs_count keeps the
+// element count for tasks that do not read descriptors.
+template <class T>
+void add_input(TaskData &taskData, T *data, std::vector<size_t> shape) {
+  auto desc = make_buffer_desc(data, std::move(shape));
+  detail::append_buffer(taskData.inputs, taskData.inputs_count, taskData.inputs_desc,
+                        reinterpret_cast<uint8_t *>(const_cast<std::remove_cv_t<T> *>(data)), std::move(desc));
+}
+
+template <class T>
+void add_output(TaskData &taskData, T *data, std::vector<size_t> shape) {
+  auto desc = make_buffer_desc(data, std::move(shape));
+  detail::append_buffer(taskData.outputs, taskData.outputs_count, taskData.outputs_desc,
+                        reinterpret_cast<uint8_t *>(data), std::move(desc));
+}
+
+// O(1) check that inputs[index] exists, is non-null and, when described,
+// holds T with the expected rank (0 skips the rank check)
+template <class T>
+bool has_input(const TaskData &taskData, size_t index, size_t rank = 0) {
+  if (index >= taskData.inputs.size() || index >= taskData.inputs_count.size() || taskData.inputs[index] == nullptr) {
+    return false;
+  }
+  const auto *desc = input_desc(taskData, index);
+  return desc == nullptr || (desc->holds<T>() && (rank == 0 || desc->rank() == rank));
+}
+
+template <class T>
+bool has_output(const TaskData &taskData, size_t index, size_t rank = 0) {
+  if (index >= taskData.outputs.size() || index >= taskData.outputs_count.size() ||
+      taskData.outputs[index] == nullptr) {
+    return false;
+  }
+  const auto *desc = output_desc(taskData, index);
+  return desc == nullptr || (desc->holds<T>() && (rank == 0 || desc->rank() == rank));
+}
+
+namespace detail {
+
+// the element count of the buffer over its first element, also for a padded
+// descriptor; the views below decide how the memory is laid out
+template <class T>
+std::span<T> input_elements(const TaskData &taskData, size_t index) {
+  if (index >= taskData.inputs.size() || index >= taskData.inputs_count.size()) {
+    throw std::out_of_range("Input buffer index is out of range: " + std::to_string(index));
+  }
+  const auto *desc = input_desc(taskData, index);
+  check_type<T>(desc, index);
+  return {reinterpret_cast<T *>(taskData.inputs[index]), buffer_size(desc, taskData.inputs_count[index])};
+}
+
+template <class T>
+std::span<T> output_elements(const TaskData &taskData, size_t index) {
+  if (index >= taskData.outputs.size() || index >= taskData.outputs_count.size()) {
+    throw std::out_of_range("Output buffer index is out of range: " + std::to_string(index));
+  }
+  const auto *desc = output_desc(taskData, index);
+  check_type<T>(desc, index);
+  return {reinterpret_cast<T *>(taskData.outputs[index]), buffer_size(desc, taskData.outputs_count[index])};
+}
+
+inline void check_contiguous(const BufferDesc *desc, size_t index) {
+  if (desc != nullptr && !desc->is_contiguous()) {
+    throw std::invalid_argument("Buffer " + std::to_string(index) +
+                                " is padded; read it through input_matrix_view() / output_matrix_view()");
+  }
+}
+
+}  // namespace detail
+
+// Non-owning typed view of inputs[index]. Tasks can read directly from the
+// caller's memory instead of copying it into private vectors in
+// pre_processing(). The element count comes from the descriptor when present
+// and from inputs_count otherwise. Throws std::invalid_argument for a padded
+// (strided) descriptor, whose elements a flat span would not line up with.
+template <class T>
+std::span<T> input_view(const TaskData &taskData, size_t index) {
+  auto elements = detail::input_elements<T>(taskData, index);
+  detail::check_contiguous(input_desc(taskData, index), index);
+  return elements;
+}
+
+// Non-owning typed view of outputs[index]
+template <class T>
+std::span<T> output_view(const TaskData &taskData, size_t index) {
+  auto elements = detail::output_elements<T>(taskData, index);
+  detail::check_contiguous(output_desc(taskData, index), index);
+  return elements;
+}
+
+// Non-owning row-major 2D view over a buffer; row_stride allows padded rows
+template <class T>
+class MatrixView {
+ public:
+  MatrixView() = default;
+  MatrixView(std::span<T> data, size_t rows, size_t cols) : MatrixView(data, rows, cols, cols) {}
+  MatrixView(std::span<T> data, size_t rows, size_t cols, size_t row_stride)
+      : data_(data), rows_(rows), cols_(cols), row_stride_(row_stride) {
+    if (row_stride < cols || (rows > 0 && (rows - 1) * row_stride + cols > data.size())) {
+      throw std::out_of_range("Matrix view " + std::to_string(rows) + "x" + std::to_string(cols) +
+                              " does not fit in buffer of " + std::to_string(data.size()) + " elements");
+    }
+  }
+
+  // unchecked access for hot loops
+  T &operator()(size_t i, size_t j) const { return data_[i * row_stride_ + j]; }
+
+  // bounds-checked access
+  T &at(size_t i, size_t j) const {
+    if (i >= rows_ || j >= cols_) {
+      throw std::out_of_range("Matrix view index (" + std::to_string(i) + ", " + std::to_string(j) +
+                              ") is out of range");
+    }
+    return data_[i * row_stride_ + j];
+  }
+
+  [[nodiscard]] std::span<T> row(size_t i) const { return data_.subspan(i * row_stride_, cols_); }
+  [[nodiscard]] T *data() const { return data_.data(); }
+  [[nodiscard]] size_t rows() const { return rows_; }
+  [[nodiscard]] size_t cols() const { return cols_; }
+  [[nodiscard]] size_t row_stride() const { return row_stride_; }
+  [[nodiscard]] size_t size() const { return rows_ * cols_; }
+  [[nodiscard]] bool is_contiguous() const { return row_stride_ == cols_; }
+
+ private:
+  std::span<T> data_;
+  size_t rows_ = 0;
+  size_t cols_ = 0;
+  size_t row_stride_ = 0;
+};
+
+template <class T>
+MatrixView<T> input_matrix_view(const TaskData &taskData, size_t index, size_t rows, size_t cols) {
+  return MatrixView<T>(input_view<T>(taskData, index), rows, cols);
+}
+
+template <class T>
+MatrixView<T> output_matrix_view(const TaskData &taskData, size_t index, size_t rows, size_t cols) {
+  return MatrixView<T>(output_view<T>(taskData, index), rows, cols);
+}
+
+namespace detail {
+
+template <class T>
+MatrixView<T> matrix_from_desc(std::span<T> data, const BufferDesc *desc, size_t index) {
+  if (desc == nullptr || desc->rank() != 2 || desc->strides[1] != 1) {
+    throw std::invalid_argument("Buffer " + std::to_string(index) + " is not described as a row-major matrix");
+  }
+  // the span covers the logical elements only; extend it to the padded extent
+  size_t extent = desc->shape[0] == 0 ? 0 : (desc->shape[0] - 1) * desc->strides[0] + desc->shape[1];
+  return MatrixView<T>(std::span<T>(data.data(), extent), desc->shape[0], desc->shape[1], desc->strides[0]);
+}
+
+}  // namespace detail
+
+// 2D views whose shape and row stride come from the buffer descriptor
+template <class T>
+MatrixView<T> input_matrix_view(const TaskData &taskData, size_t index) {
+  return detail::matrix_from_desc(detail::input_elements<T>(taskData, index), input_desc(taskData, index), index);
+}
+
+template <class T>
+MatrixView<T> output_matrix_view(const TaskData &taskData, size_t index) {
+  return detail::matrix_from_desc(detail::output_elements<T>(taskData, index), output_desc(taskData, index),
+                                  index);
+}
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_DATA_VIEW_HPP_
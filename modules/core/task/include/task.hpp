@@ -3,23 +3,73 @@
 #ifndef MODULES_CORE_INCLUDE_TASK_HPP_
 #define MODULES_CORE_INCLUDE_TASK_HPP_
 
+#include <array>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <iostream>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "core/task/include/buffer_desc.hpp"
+
 namespace ppc::core {
 
 struct TaskData {
   std::vector<uint8_t *> inputs;
-  std::vector<std::uint32_t> inputs_count;
+  // element counts are 64-bit so a single buffer may exceed 4G elements
+  std::vector<std::uint64_t> inputs_count;
   std::vector<uint8_t *> outputs;
-  std::vector<std::uint32_t> outputs_count;
+  std::vector<std::uint64_t> outputs_count;
+  // optional typed layout of each buffer, filled by add_input()/add_output();
+  // may be shorter than inputs/outputs when buffers were pushed by hand
+  std::vector<BufferDesc> inputs_desc;
+  std::vector<BufferDesc> outputs_desc;
   enum StateOfTesting { FUNC, PERF } state_of_testing;
 };
 
+enum class TaskStage : std::uint8_t { VALIDATION, PRE_PROCESSING, RUN, POST_PROCESSING };
+
+constexpr std::size_t kNumTaskStages = 4;
+
+const char *task_stage_name(TaskStage stage);
+
+// The lifecycle order check can be compiled out (-DDISABLE_ORDER_CHECK=ON)
+// for release binaries. internal_order_test() then does nothing at all unless
+// stage timings were requested with time_stages() or tracing is on; the time
+// limit of a FUNC run is not checked.
+#ifdef DISABLE_ORDER_CHECK
+constexpr bool kCheckStageOrder = false;
+#else
+constexpr bool kCheckStageOrder = true;
+#endif
+
+// Wall time spent in each stage since the last reset. A stage lasts from its
+// internal_order_test() call until the next stage starts or close_stage()
+// is called.
+struct StageTimings {
+  std::array<double, kNumTaskStages> total_sec{};
+  std::array<std::uint64_t, kNumTaskStages> calls{};
+
+  [[nodiscard]] double total(TaskStage stage) const { return total_sec[static_cast<std::size_t>(stage)]; }
+  [[nodiscard]] std::uint64_t count(TaskStage stage) const { return calls[static_cast<std::size_t>(stage)]; }
+  // average time of one call, 0 if the stage was never called
+  [[nodiscard]] double mean(TaskStage stage) const;
+};
+
+// Memory traffic and arithmetic of one run(), declared by a task so that Perf
+// can report its throughput against the machine peak (see
+// core/perf/include/roofline.hpp)
+struct TaskWork {
+  // bytes the kernel has to read and write at least, e.g.
+  // (M*K + K*N + M*N) * sizeof(T) for a matrix product
+  std::uint64_t bytes = 0;
+  // arithmetic operations (flops for floating point data), e.g. 2*M*N*K
+  std::uint64_t operations = 0;
+  [[nodiscard]] bool declared() const { return bytes > 0 || operations > 0; }
+};
+
 // Memory of inputs and outputs need to be initialized before create object of
 // Task class
 class Task {
@@ -44,17 +94,51 @@ class Task {
   // get input and output data
   [[nodiscard]] std::shared_ptr<TaskData> get_data() const;
 
+  // work of one run() on the current data, valid after pre_processing(); the
+  // default declares nothing and Perf reports no throughput for the task
+  [[nodiscard]] virtual TaskWork work() const { return {}; }
+
+  // Prepare once, execute many: start a new validation() -> post_processing()
+  // cycle while keeping everything the task has allocated. Tasks that assign()
+  // or resize() their buffers instead of constructing new ones repeat the
+  // pipeline on same-shaped data without heap allocations.
+  void reset();
+
+  // point the task at new buffers and reset(); the testing state (FUNC/PERF)
+  // of the previous data is kept
+  void rebind(std::shared_ptr<TaskData> taskData_);
+
+  // record stage timings also without the order check; Perf turns it on for
+  // the task it measures
+  void time_stages(bool enabled) { timing_requested = enabled; }
+  // per-stage wall time recorded by internal_order_test()
+  [[nodiscard]] const StageTimings &stage_timings() const { return stage_timings_; }
+  // drop accumulated timings; a stage in progress keeps being timed from now
+  // on but is not counted as a new call
+  void reset_stage_timings();
+  // finish timing of the current stage (nothing follows post_processing)
+  void close_stage();
+
   virtual ~Task();
 
  protected:
-  void internal_order_test(const std::string &str = __builtin_FUNCTION());
+  // O(1) lifecycle state machine, str is the name of the calling stage
+  void internal_order_test(const char *str = __builtin_FUNCTION());
   std::shared_ptr<TaskData> taskData;
 
  private:
-  std::vector<std::string> functions_order;
-  std::vector<std::string> right_functions_order = {"validation", "pre_processing", "run", "post_processing"};
-  const double max_test_time = 1.0;
+  // stage the next call must be, and the last stage that was called
+  std::size_t expected_stage = 0;
+  std::size_t last_stage = kNumTaskStages;
   std::chrono::high_resolution_clock::time_point tmp_time_point;
+  StageTimings stage_timings_;
+  std::size_t open_stage = kNumTaskStages;
+  std::chrono::high_resolution_clock::time_point stage_start;
+  // start of the open stage on the trace timeline, -1 while not tracing
+  std::int64_t trace_start_ns = -1;
+  bool timing_requested = false;
+  void open_stage_timer(std::size_t stage);
+  [[nodiscard]] bool bookkeeping_needed() const;
 };
 
 }  // namespace ppc::core
@@ -0,0 +1,75 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_TIME_LIMIT_HPP_
+#define MODULES_CORE_INCLUDE_TIME_LIMIT_HPP_
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace ppc::core {
+
+enum class TimeLimitKind : std::uint8_t {
+  // pre_processing() to post_processing() of a task in FUNC mode
+  TASK,
+  // a perf measurement reported by Perf::print_perf_statistic()
+  PERF
+};
+
+struct TimeLimitViolation {
+  TimeLimitKind kind;
+  double time_sec;
+  double limit_sec;
+};
+
+// a perf measurement that made more heap allocations over its measured runs
+// than PerfAttr::max_allocations
+struct AllocationLimitViolation {
+  std::uint64_t count;
+  std::uint64_t limit;
+};
+
+// a perf measurement significantly slower than its stored baseline (see
+// core/perf/include/baseline.hpp); times are medians of one iteration
+struct RegressionViolation {
+  double current_median_sec;
+  double baseline_median_sec;
+  // current over baseline median
+  double ratio;
+  double p_value;
+};
+
+// the diagnostics printed for a violation
+std::string time_limit_message(const TimeLimitViolation &violation);
+std::string time_limit_message(const AllocationLimitViolation &violation);
+std::string time_limit_message(const RegressionViolation &violation);
+
+// Time limits of tasks and perf measurements and what happens when one is
+// exceeded. Core itself never fails a test: the default policy prints the
+// violation, and the gtest adapter (core/testing) installs a policy that
+// reports it as a test failure.
+struct TimeLimitPolicy {
+  double task_limit_sec = 1.0;
+  double perf_limit_sec = 10.0;
+  // nullptr disables the checks; tasks then skip the clock reads too
+  std::function<void(const TimeLimitViolation &)> on_violation;
+  // nullptr disables the allocation limit
+  std::function<void(const AllocationLimitViolation &)> on_allocation_violation;
+  // nullptr leaves regressions to the printed baseline verdict
+  std::function<void(const RegressionViolation &)> on_regression;
+
+  // print to std::cerr (default)
+  static TimeLimitPolicy report();
+  // throw std::runtime_error
+  static TimeLimitPolicy fail();
+  // no checks, for production binaries
+  static TimeLimitPolicy ignore();
+};
+
+// process-wide policy; set it before tasks start running
+void set_time_limit_policy(TimeLimitPolicy policy);
+const TimeLimitPolicy &time_limit_policy();
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_TIME_LIMIT_HPP_
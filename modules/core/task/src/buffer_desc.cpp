@@ -0,0 +1,60 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/task/include/buffer_desc.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <numeric>
+
+const char *ppc::core::data_type_name(DataType type) {
+  switch (type) {
+    case DataType::BOOL:
+      return "bool";
+    case DataType::CHAR:
+      return "char";
+    case DataType::INT8:
+      return "int8";
+    case DataType::UINT8:
+      return "uint8";
+    case DataType::INT16:
+      return "int16";
+    case DataType::UINT16:
+      return "uint16";
+    case DataType::INT32:
+      return "int32";
+    case DataType::UINT32:
+      return "uint32";
+    case DataType::INT64:
+      return "int64";
+    case DataType::UINT64:
+      return "uint64";
+    case DataType::FLOAT:
+      return "float";
+    case DataType::DOUBLE:
+      return "double";
+    default:
+      return "unknown";
+  }
+}
+
+std::size_t ppc::core::BufferDesc::size() const {
+  return std::accumulate(shape.begin(), shape.end(), std::size_t{1}, std::multiplies<>());
+}
+
+bool ppc::core::BufferDesc::is_contiguous() const { return strides == contiguous_strides(shape); }
+
+std::vector<std::size_t> ppc::core::contiguous_strides(const std::vector<std::size_t> &shape) {
+  std::vector<std::size_t> strides(shape.size(), 1);
+  for (size_t i = shape.size(); i > 1; i--) {
+    strides[i - 2] = strides[i - 1] * shape[i - 1];
+  }
+  return strides;
+}
+
+std::size_t ppc::core::pointer_alignment(const void *ptr) {
+  const auto address = reinterpret_cast<std::uintptr_t>(ptr);
+  std::size_t alignment = 1;
+  while (alignment < 4096 && address % (alignment * 2) == 0) {
+    alignment *= 2;
+  }
+  return alignment;
+}
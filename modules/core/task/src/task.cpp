@@ -1,14 +1,18 @@
 // Copyright 2023 Nesterov Alexander
 #include "core/task/include/task.hpp"
 
-#include <gtest/gtest.h>
-
 #include <stdexcept>
+#include <string>
+#include <string_view>
 #include <utility>
 
+#include "core/task/include/time_limit.hpp"
+#include "core/trace/include/trace.hpp"
+
 void ppc::core::Task::set_data(std::shared_ptr<TaskData> taskData_) {
   taskData_->state_of_testing = TaskData::StateOfTesting::FUNC;
-  functions_order.clear();
+  expected_stage = 0;
+  last_stage = kNumTaskStages;
   taskData = std::move(taskData_);
 }
 
@@ -16,32 +20,118 @@ std::shared_ptr<ppc::core::TaskData> ppc::core::Task::get_data() const { return
 
 ppc::core::Task::Task(std::shared_ptr<TaskData> taskData_) { set_data(std::move(taskData_)); }
 
-void ppc::core::Task::internal_order_test(const std::string& str) {
-  if (!functions_order.empty() && str == functions_order.back() && str == "run") return;
+bool ppc::core::Task::bookkeeping_needed() const { return timing_requested || tracing_enabled(); }
 
-  functions_order.push_back(str);
+void ppc::core::Task::internal_order_test(const char* str) {
+  if constexpr (!kCheckStageOrder) {
+    if (!bookkeeping_needed()) {
+      return;
+    }
+  }
+  const std::string_view name(str);
+  size_t stage = 0;
+  while (stage < kNumTaskStages && name != task_stage_name(static_cast<TaskStage>(stage))) {
+    stage++;
+  }
+
+  // run() may be repeated within one cycle
+  const auto run = static_cast<size_t>(TaskStage::RUN);
+  if (stage == run && last_stage == run) {
+    open_stage_timer(run);
+    return;
+  }
 
-  for (size_t i = 0; i < functions_order.size(); i++) {
-    if (functions_order[i] != right_functions_order[i % right_functions_order.size()]) {
+  if constexpr (kCheckStageOrder) {
+    // the serial number is the position of the call in the current cycle, as
+    // in the call history this replaces (it was cleared every cycle)
+    if (stage != expected_stage) {
       throw std::invalid_argument("ORDER OF FUCTIONS IS NOT RIGHT: \n" + std::string("Serial number: ") +
-                                  std::to_string(i + 1) + "\n" + std::string("Yours function: ") + functions_order[i] +
-                                  "\n" + std::string("Expected function: ") + right_functions_order[i]);
+                                  std::to_string(expected_stage + 1) + "\n" + std::string("Yours function: ") +
+                                  std::string(name) + "\n" + std::string("Expected function: ") +
+                                  task_stage_name(static_cast<TaskStage>(expected_stage)));
     }
+  } else if (stage == kNumTaskStages) {
+    return;
   }
 
-  if (str == "pre_processing" && taskData->state_of_testing == TaskData::StateOfTesting::FUNC) {
+  last_stage = stage;
+  expected_stage = (stage + 1) % kNumTaskStages;
+  open_stage_timer(stage);
+
+  // time limit of a FUNC run, see TimeLimitPolicy
+  const auto &policy = time_limit_policy();
+  if (!policy.on_violation || taskData->state_of_testing != TaskData::StateOfTesting::FUNC) {
+    return;
+  }
+  if (stage == static_cast<size_t>(TaskStage::PRE_PROCESSING)) {
     tmp_time_point = std::chrono::high_resolution_clock::now();
   }
-
-  if (str == "post_processing" && taskData->state_of_testing == TaskData::StateOfTesting::FUNC) {
+  if (stage == static_cast<size_t>(TaskStage::POST_PROCESSING)) {
     auto end = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - tmp_time_point).count();
     auto current_time = static_cast<double>(duration) * 1e-9;
-    if (current_time > max_test_time) {
-      std::cerr << "Current test work more than " << max_test_time << " secs: " << current_time << std::endl;
-      EXPECT_TRUE(current_time < max_test_time);
+    if (current_time > policy.task_limit_sec) {
+      policy.on_violation({TimeLimitKind::TASK, current_time, policy.task_limit_sec});
     }
   }
 }
 
-ppc::core::Task::~Task() { functions_order.clear(); }
+void ppc::core::Task::reset() {
+  close_stage();
+  expected_stage = 0;
+  last_stage = kNumTaskStages;
+}
+
+void ppc::core::Task::rebind(std::shared_ptr<TaskData> taskData_) {
+  taskData_->state_of_testing = taskData->state_of_testing;
+  taskData = std::move(taskData_);
+  reset();
+}
+
+void ppc::core::Task::open_stage_timer(size_t stage) {
+  close_stage();
+  open_stage = stage;
+  stage_timings_.calls[stage]++;
+  stage_start = std::chrono::high_resolution_clock::now();
+  trace_start_ns = tracing_enabled() ? TraceRecorder::global().now_ns() : -1;
+}
+
+void ppc::core::Task::close_stage() {
+  if (open_stage >= kNumTaskStages) {
+    return;
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - stage_start).count();
+  stage_timings_.total_sec[open_stage] += static_cast<double>(duration) * 1e-9;
+  if (trace_start_ns >= 0) {
+    trace_span(task_stage_name(static_cast<TaskStage>(open_stage)), "task", trace_start_ns);
+    trace_start_ns = -1;
+  }
+  open_stage = kNumTaskStages;
+}
+
+void ppc::core::Task::reset_stage_timings() {
+  stage_timings_ = StageTimings();
+  stage_start = std::chrono::high_resolution_clock::now();
+}
+
+const char* ppc::core::task_stage_name(TaskStage stage) {
+  switch (stage) {
+    case TaskStage::VALIDATION:
+      return "validation";
+    case TaskStage::PRE_PROCESSING:
+      return "pre_processing";
+    case TaskStage::RUN:
+      return "run";
+    case TaskStage::POST_PROCESSING:
+      return "post_processing";
+    default:
+      return "unknown";
+  }
+}
+
+double ppc::core::StageTimings::mean(TaskStage stage) const {
+  return count(stage) == 0 ? 0.0 : total(stage) / static_cast<double>(count(stage));
+}
+
+ppc::core::Task::~Task() = default;
@@ -0,0 +1,76 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/task/include/time_limit.hpp"
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+ppc::core::TimeLimitPolicy &current_policy() {
+  static ppc::core::TimeLimitPolicy policy = ppc::core::TimeLimitPolicy::report();
+  return policy;
+}
+
+}  // namespace
+
+std::string ppc::core::time_limit_message(const TimeLimitViolation &violation) {
+  std::stringstream message;
+  if (violation.kind == TimeLimitKind::TASK) {
+    message << "Current test work more than " << violation.limit_sec << " secs: " << violation.time_sec;
+  } else {
+    message << "Task execute time need to be:  time < " << violation.limit_sec << " secs.\n"
+            << "Original time in secs: " << violation.time_sec;
+  }
+  return message.str();
+}
+
+std::string ppc::core::time_limit_message(const AllocationLimitViolation &violation) {
+  std::stringstream message;
+  message << "Heap allocations over the measured runs need to be: count <= " << violation.limit << "\n"
+          << "Original count: " << violation.count;
+  return message.str();
+}
+
+std::string ppc::core::time_limit_message(const RegressionViolation &violation) {
+  std::stringstream message;
+  message << "Perf regression against the baseline: median iteration " << violation.current_median_sec
+          << " secs, baseline " << violation.baseline_median_sec << " secs (x" << violation.ratio
+          << ", p = " << violation.p_value << ")";
+  return message.str();
+}
+
+ppc::core::TimeLimitPolicy ppc::core::TimeLimitPolicy::report() {
+  TimeLimitPolicy policy;
+  policy.on_violation = [](const TimeLimitViolation &violation) {
+    std::cerr << time_limit_message(violation) << std::endl;
+  };
+  policy.on_allocation_violation = [](const AllocationLimitViolation &violation) {
+    std::cerr << time_limit_message(violation) << std::endl;
+  };
+  policy.on_regression = [](const RegressionViolation &violation) {
+    std::cerr << time_limit_message(violation) << std::endl;
+  };
+  return policy;
+}
+
+ppc::core::TimeLimitPolicy ppc::core::TimeLimitPolicy::fail() {
+  TimeLimitPolicy policy;
+  policy.on_violation = [](const TimeLimitViolation &violation) {
+    throw std::runtime_error(time_limit_message(violation));
+  };
+  policy.on_allocation_violation = [](const AllocationLimitViolation &violation) {
+    throw std::runtime_error(time_limit_message(violation));
+  };
+  policy.on_regression = [](const RegressionViolation &violation) {
+    throw std::runtime_error(time_limit_message(violation));
+  };
+  return policy;
+}
+
+ppc::core::TimeLimitPolicy ppc::core::TimeLimitPolicy::ignore() { return {}; }
+
+void ppc::core::set_time_limit_policy(TimeLimitPolicy policy) { current_policy() = std::move(policy); }
+
+const ppc::core::TimeLimitPolicy &ppc::core::time_limit_policy() { return current_policy(); }
@@ -0,0 +1,17 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest-spi.h>
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "core/perf/include/perf.hpp"
+#include "core/task/include/time_limit.hpp"
+#include "core/testing/include/gtest_adapter.hpp"
+
+TEST(testing_tests, check_adapter_is_installed) {
+  EXPECT_NE(ppc::core::current_test_path().find("testing_tests.cpp"), std::string::npos);
+  EXPECT_NONFATAL_FAILURE(ppc::core::time_limit_policy().on_violation({ppc::core::TimeLimitKind::TASK, 2.0, 1.0}),
+                          "Current test work more than 1 secs: 2");
+  EXPECT_NONFATAL_FAILURE(ppc::core::time_limit_policy().on_violation({ppc::core::TimeLimitKind::PERF, 12.0, 10.0}),
+                          "Original time in secs: 12");
+}
@@ -0,0 +1,21 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_GTEST_ADAPTER_HPP_
+#define MODULES_CORE_INCLUDE_GTEST_ADAPTER_HPP_
+
+#include "core/task/include/time_limit.hpp"
+
+namespace ppc::core {
+
+// Time limit policy of the test executables: violations are printed and
+// reported as non-fatal gtest failures
+TimeLimitPolicy gtest_time_limit_policy();
+
+// Install the gtest time limit policy and take perf test paths from the
+// running gtest test. Test executables linking core_test_adapter get this at
+// start-up; nothing else in core depends on gtest.
+void install_gtest_adapter();
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_GTEST_ADAPTER_HPP_
@@ -0,0 +1,46 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/testing/include/gtest_adapter.hpp"
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+#include <string>
+
+#include "core/perf/include/perf.hpp"
+
+namespace {
+
+std::string current_test_file() {
+  const auto *info = ::testing::UnitTest::GetInstance()->current_test_info();
+  return info != nullptr ? info->file() : std::string();
+}
+
+// runs before main() of every executable the adapter is linked into
+[[maybe_unused]] const bool installed = [] {
+  ppc::core::install_gtest_adapter();
+  return true;
+}();
+
+}  // namespace
+
+ppc::core::TimeLimitPolicy ppc::core::gtest_time_limit_policy() {
+  TimeLimitPolicy policy;
+  policy.on_violation = [](const TimeLimitViolation &violation) {
+    std::cerr << time_limit_message(violation) << std::endl;
+    ADD_FAILURE() << time_limit_message(violation);
+  };
+  policy.on_allocation_violation = [](const AllocationLimitViolation &violation) {
+    std::cerr << time_limit_message(violation) << std::endl;
+    ADD_FAILURE() << time_limit_message(violation);
+  };
+  policy.on_regression = [](const RegressionViolation &violation) {
+    std::cerr << time_limit_message(violation) << std::endl;
+    ADD_FAILURE() << time_limit_message(violation);
+  };
+  return policy;
+}
+
+void ppc::core::install_gtest_adapter() {
+  set_time_limit_policy(gtest_time_limit_policy());
+  set_test_path_provider(current_test_file);
+}
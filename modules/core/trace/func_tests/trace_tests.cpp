@@ -0,0 +1,126 @@
+// Copyright 2024 Nesterov Alexander
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/task/func_tests/test_task.hpp"
+#include "core/trace/include/trace.hpp"
+
+namespace {
+
+std::vector<std::string> event_names(const std::vector<ppc::core::TraceEvent> &events) {
+  std::vector<std::string> names;
+  for (const auto &event : events) {
+    names.emplace_back(event.name);
+  }
+  return names;
+}
+
+}  // namespace
+
+TEST(trace_tests, check_disabled_records_nothing) {
+  auto &recorder = ppc::core::TraceRecorder::global();
+  recorder.enable();
+  recorder.disable();
+  EXPECT_FALSE(ppc::core::tracing_enabled());
+  { ppc::core::TraceScope scope("ignored"); }
+  EXPECT_TRUE(recorder.events().empty());
+}
+
+TEST(trace_tests, check_spans_and_task_stages) {
+  auto &recorder = ppc::core::TraceRecorder::global();
+  recorder.enable();
+
+  std::vector<int32_t> in(100, 1);
+  std::vector<int32_t> out(1, 0);
+  auto taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+  ppc::test::TestTask<int32_t> task(taskData);
+  {
+    ppc::core::TraceScope scope("pipeline", "test");
+    task.validation();
+    task.pre_processing();
+    task.run();
+    task.post_processing();
+    task.close_stage();
+  }
+  recorder.disable();
+
+  auto events = recorder.events();
+  EXPECT_EQ(event_names(events),
+            std::vector<std::string>({"pipeline", "validation", "pre_processing", "run", "post_processing"}));
+  EXPECT_STREQ(events[3].category, "task");
+  // the region encloses the stages
+  EXPECT_LE(events[0].start_ns, events[1].start_ns);
+  EXPECT_GE(events[0].start_ns + events[0].duration_ns, events[4].start_ns + events[4].duration_ns);
+
+  auto path = (std::filesystem::temp_directory_path() / "ppc_trace_tests.json").string();
+  recorder.write(path);
+  std::ifstream file(path);
+  std::string json((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  EXPECT_EQ(json.rfind(R"({"displayTimeUnit":"ms","traceEvents":[)", 0), 0U);
+  EXPECT_NE(json.find(R"("name":"run","cat":"task","ph":"X")"), std::string::npos);
+  std::filesystem::remove(path);
+}
+
+TEST(trace_tests, check_ring_per_thread) {
+  auto &recorder = ppc::core::TraceRecorder::global();
+  recorder.enable(4);
+  for (int i = 0; i < 10; i++) {
+    ppc::core::TraceScope scope(i < 6 ? "old" : "new");
+  }
+  std::thread([] {
+    for (int i = 0; i < 3; i++) {
+      ppc::core::TraceScope scope("worker");
+    }
+  }).join();
+  recorder.disable();
+
+  auto events = recorder.events();
+  EXPECT_EQ(events.size(), 7U);
+  EXPECT_EQ(recorder.dropped(), 6U);
+  std::set<std::string> names;
+  std::set<uint32_t> threads;
+  for (const auto &event : events) {
+    names.insert(event.name);
+    threads.insert(event.thread);
+  }
+  // the oldest events made room for the newest
+  EXPECT_EQ(names, std::set<std::string>({"new", "worker"}));
+  EXPECT_EQ(threads.size(), 2U);
+}
+
+TEST(trace_tests, check_messages) {
+  auto &recorder = ppc::core::TraceRecorder::global();
+  recorder.enable();
+  for (int i = 0; i < 2; i++) {
+    ppc::core::trace_message(ppc::core::TraceEvent::Kind::SEND, 1, 5, 64, recorder.now_ns());
+  }
+  ppc::core::trace_message(ppc::core::TraceEvent::Kind::RECV, 1, 5, 8, recorder.now_ns());
+  recorder.disable();
+
+  auto events = recorder.events();
+  ASSERT_EQ(events.size(), 3U);
+  EXPECT_EQ(events[1].sequence, 1U);
+  // receives are counted apart from sends
+  EXPECT_EQ(events[2].sequence, 0U);
+  EXPECT_EQ(events[2].peer, 1);
+  EXPECT_EQ(events[0].bytes, 64U);
+
+  auto json = recorder.json_events(0);
+  EXPECT_NE(json.find(R"("args":{"peer":1,"tag":5,"bytes":64})"), std::string::npos);
+  EXPECT_NE(json.find(R"("ph":"s","id":)"), std::string::npos);
+  EXPECT_NE(json.find(R"("ph":"f","bp":"e","id":)"), std::string::npos);
+}
@@ -0,0 +1,135 @@
+// Copyright 2024 Nesterov Alexander
+
+#ifndef MODULES_CORE_INCLUDE_TRACE_HPP_
+#define MODULES_CORE_INCLUDE_TRACE_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace ppc::core {
+
+struct TraceEvent {
+  enum class Kind : uint8_t { SPAN, SEND, RECV };
+
+  // names must outlive the recorder: string literals or task_stage_name()
+  const char *name = "";
+  const char *category = "";
+  // nanoseconds since the recorder was enabled
+  int64_t start_ns = 0;
+  int64_t duration_ns = 0;
+  // index of the recording thread, in order of their first event
+  uint32_t thread = 0;
+  Kind kind = Kind::SPAN;
+  // SEND and RECV: the other rank, the tag, the payload and the number of
+  // earlier messages with the same peer, tag and direction, which pairs a
+  // send with its receive (MPI keeps their order)
+  int32_t peer = -1;
+  int32_t tag = 0;
+  uint64_t bytes = 0;
+  uint64_t sequence = 0;
+};
+
+namespace detail {
+inline std::atomic<bool> trace_enabled{false};
+}  // namespace detail
+
+// The only cost of the trace points while tracing is off
+inline bool tracing_enabled() { return detail::trace_enabled.load(std::memory_order_relaxed); }
+
+// Process-wide timeline of spans (task stages, user regions) and messages.
+// Every thread records into its own ring buffer of fixed capacity without
+// locking; when a ring is full the oldest events are overwritten and counted
+// as dropped. Read the events back once the recording threads are idle.
+class TraceRecorder {
+ public:
+  // events per thread
+  static constexpr std::size_t kDefaultCapacity = std::size_t{1} << 16;
+
+  // the only recorder: a thread keeps its ring in thread-local storage, which
+  // a second recorder would share
+  static TraceRecorder &global();
+  TraceRecorder(const TraceRecorder &) = delete;
+  TraceRecorder &operator=(const TraceRecorder &) = delete;
+
+  // drop what was recorded and start again with rings of capacity events
+  void enable(std::size_t capacity = kDefaultCapacity);
+  void disable();
+  // enable() if PPC_TRACE names an output file, with PPC_TRACE_CAPACITY
+  // events per thread; returns the file name, empty if tracing stays off
+  std::string enable_from_env();
+
+  // nanoseconds since enable()
+  [[nodiscard]] int64_t now_ns() const;
+  void record(const TraceEvent &event);
+  // next sequence number of a message of kind with peer and tag
+  uint64_t next_sequence(TraceEvent::Kind kind, int peer, int tag);
+
+  // events still in the rings, by start time
+  [[nodiscard]] std::vector<TraceEvent> events() const;
+  [[nodiscard]] uint64_t dropped() const;
+
+  // Chrome trace (chrome://tracing, ui.perfetto.dev) entries of the events as
+  // process pid, start times moved by offset_ns: comma separated, without
+  // the enclosing array, so the entries of several ranks can be joined
+  [[nodiscard]] std::string json_events(int pid, int64_t offset_ns = 0) const;
+  // complete trace of this process; throws std::runtime_error if the file
+  // cannot be written
+  void write(const std::string &path) const;
+
+ private:
+  struct Ring {
+    std::vector<TraceEvent> events;
+    uint64_t written = 0;
+    uint32_t thread = 0;
+  };
+
+  TraceRecorder() = default;
+  Ring &local_ring();
+
+  mutable std::mutex mutex;
+  std::vector<std::unique_ptr<Ring>> rings;
+  std::map<std::tuple<TraceEvent::Kind, int, int>, uint64_t> sequences;
+  std::size_t capacity = kDefaultCapacity;
+  // bumped by enable() so threads drop rings of an earlier recording
+  std::atomic<uint64_t> generation{0};
+  int64_t epoch_ns = 0;
+};
+
+// wrap entries of json_events() into a trace file
+std::string chrome_trace(const std::string &events);
+
+// record a span that started at start_ns and ends now
+void trace_span(const char *name, const char *category, int64_t start_ns);
+// record a message exchanged with peer that started at start_ns and is
+// complete now; kind is SEND or RECV
+void trace_message(TraceEvent::Kind kind, int peer, int tag, uint64_t bytes, int64_t start_ns);
+
+// Records the scope as a span when tracing is on
+class TraceScope {
+ public:
+  explicit TraceScope(const char *name_, const char *category_ = "region")
+      : name(name_), category(category_), start_ns(tracing_enabled() ? TraceRecorder::global().now_ns() : -1) {}
+  TraceScope(const TraceScope &) = delete;
+  TraceScope &operator=(const TraceScope &) = delete;
+  ~TraceScope() {
+    if (start_ns >= 0) {
+      trace_span(name, category, start_ns);
+    }
+  }
+
+ private:
+  const char *name;
+  const char *category;
+  int64_t start_ns;
+};
+
+}  // namespace ppc::core
+
+#endif  // MODULES_CORE_INCLUDE_TRACE_HPP_
@@ -0,0 +1,191 @@
+// Copyright 2024 Nesterov Alexander
+#include "core/trace/include/trace.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+int64_t steady_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void write_string(std::ostream &out, const char *str) {
+  out << '"';
+  for (; *str != '\0'; str++) {
+    if (*str == '"' || *str == '\\') {
+      out << '\\';
+    }
+    out << *str;
+  }
+  out << '"';
+}
+
+// id joining the two ends of a message in the viewer; JSON numbers stay
+// exact up to 53 bits
+uint64_t flow_id(int source, int dest, int tag, uint64_t sequence) {
+  uint64_t id = 14695981039346656037ULL;
+  for (uint64_t part : {static_cast<uint64_t>(source), static_cast<uint64_t>(dest), static_cast<uint64_t>(tag),
+                        sequence}) {
+    id = (id ^ part) * 1099511628211ULL;
+  }
+  return id & ((uint64_t{1} << 53) - 1);
+}
+
+}  // namespace
+
+ppc::core::TraceRecorder &ppc::core::TraceRecorder::global() {
+  static TraceRecorder recorder;
+  return recorder;
+}
+
+void ppc::core::TraceRecorder::enable(std::size_t capacity_) {
+  std::lock_guard<std::mutex> lock(mutex);
+  capacity = std::max<std::size_t>(capacity_, 1);
+  rings.clear();
+  sequences.clear();
+  epoch_ns = steady_ns();
+  generation++;
+  detail::trace_enabled.store(true, std::memory_order_relaxed);
+}
+
+void ppc::core::TraceRecorder::disable() { detail::trace_enabled.store(false, std::memory_order_relaxed); }
+
+std::string ppc::core::TraceRecorder::enable_from_env() {
+  const char *path = std::getenv("PPC_TRACE");
+  if (path == nullptr || *path == '\0') {
+    return {};
+  }
+  const char *capacity_ = std::getenv("PPC_TRACE_CAPACITY");
+  enable(capacity_ != nullptr && *capacity_ != '\0' ? std::strtoull(capacity_, nullptr, 10) : kDefaultCapacity);
+  return path;
+}
+
+int64_t ppc::core::TraceRecorder::now_ns() const { return steady_ns() - epoch_ns; }
+
+ppc::core::TraceRecorder::Ring &ppc::core::TraceRecorder::local_ring() {
+  thread_local Ring *ring = nullptr;
+  thread_local uint64_t ring_generation = 0;
+  auto current = generation.load();
+  if (ring == nullptr || ring_generation != current) {
+    std::lock_guard<std::mutex> lock(mutex);
+    rings.push_back(std::make_unique<Ring>());
+    ring = rings.back().get();
+    ring->thread = static_cast<uint32_t>(rings.size() - 1);
+    ring->events.reserve(std::min<std::size_t>(capacity, 1024));
+    ring_generation = current;
+  }
+  return *ring;
+}
+
+void ppc::core::TraceRecorder::record(const TraceEvent &event) {
+  auto &ring = local_ring();
+  if (ring.events.size() < capacity) {
+    ring.events.push_back(event);
+  } else {
+    ring.events[ring.written % capacity] = event;
+  }
+  ring.events[ring.written % capacity].thread = ring.thread;
+  ring.written++;
+}
+
+uint64_t ppc::core::TraceRecorder::next_sequence(TraceEvent::Kind kind, int peer, int tag) {
+  std::lock_guard<std::mutex> lock(mutex);
+  return sequences[{kind, peer, tag}]++;
+}
+
+std::vector<ppc::core::TraceEvent> ppc::core::TraceRecorder::events() const {
+  std::vector<TraceEvent> all;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto &ring : rings) {
+      all.insert(all.end(), ring->events.begin(), ring->events.end());
+    }
+  }
+  std::stable_sort(all.begin(), all.end(),
+                   [](const TraceEvent &a, const TraceEvent &b) { return a.start_ns < b.start_ns; });
+  return all;
+}
+
+uint64_t ppc::core::TraceRecorder::dropped() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  uint64_t count = 0;
+  for (const auto &ring : rings) {
+    count += ring->written - ring->events.size();
+  }
+  return count;
+}
+
+std::string ppc::core::TraceRecorder::json_events(int pid, int64_t offset_ns) const {
+  std::stringstream out;
+  out << std::fixed << std::setprecision(3);
+  out << R"({"name":"process_name","ph":"M","pid":)" << pid << R"(,"args":{"name":"rank )" << pid << R"("}})";
+  auto micros = [&](int64_t ns) { return static_cast<double>(ns + offset_ns) * 1e-3; };
+  for (const auto &event : events()) {
+    const bool message = event.kind != TraceEvent::Kind::SPAN;
+    out << ",\n{\"name\":";
+    write_string(out, event.name);
+    out << ",\"cat\":";
+    write_string(out, event.category);
+    out << R"(,"ph":"X","ts":)" << micros(event.start_ns)
+        << ",\"dur\":" << static_cast<double>(event.duration_ns) * 1e-3 << ",\"pid\":" << pid
+        << ",\"tid\":" << event.thread;
+    if (!message) {
+      out << "}";
+      continue;
+    }
+    const bool send = event.kind == TraceEvent::Kind::SEND;
+    out << R"(,"args":{"peer":)" << event.peer << ",\"tag\":" << event.tag << ",\"bytes\":" << event.bytes << "}}";
+    // an arrow from the send to the matching receive
+    auto id = send ? flow_id(pid, event.peer, event.tag, event.sequence)
+                   : flow_id(event.peer, pid, event.tag, event.sequence);
+    out << R"(,
+{"name":"message","cat":"mpi","ph":")" << (send ? "s" : "f") << "\"" << (send ? "" : R"(,"bp":"e")")
+        << ",\"id\":" << id << ",\"ts\":" << micros(event.start_ns) << ",\"pid\":" << pid << ",\"tid\":" << event.thread
+        << "}";
+  }
+  return out.str();
+}
+
+void ppc::core::TraceRecorder::write(const std::string &path) const {
+  std::ofstream out(path, std::ios::trunc);
+  out << chrome_trace(json_events(0));
+  if (!out) {
+    throw std::runtime_error("Cannot write trace: " + path);
+  }
+}
+
+std::string ppc::core::chrome_trace(const std::string &events) {
+  return "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n" + events + "\n]}\n";
+}
+
+void ppc::core::trace_span(const char *name, const char *category, int64_t start_ns) {
+  auto &recorder = TraceRecorder::global();
+  TraceEvent event;
+  event.name = name;
+  event.category = category;
+  event.start_ns = start_ns;
+  event.duration_ns = recorder.now_ns() - start_ns;
+  recorder.record(event);
+}
+
+void ppc::core::trace_message(TraceEvent::Kind kind, int peer, int tag, uint64_t bytes, int64_t start_ns) {
+  auto &recorder = TraceRecorder::global();
+  TraceEvent event;
+  event.kind = kind;
+  event.name = kind == TraceEvent::Kind::SEND ? "send" : "recv";
+  event.category = "mpi";
+  event.start_ns = start_ns;
+  event.duration_ns = recorder.now_ns() - start_ns;
+  event.peer = peer;
+  event.tag = tag;
+  event.bytes = bytes;
+  event.sequence = recorder.next_sequence(kind, peer, tag);
+  recorder.record(event);
+}
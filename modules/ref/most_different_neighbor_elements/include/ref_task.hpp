@@ -9,8 +9,10 @@
 #include <functional>
 #include <memory>
 #include <numeric>
+#include <span>
 #include <vector>
 
+#include "core/task/include/data_view.hpp"
 #include "core/task/include/task.hpp"
 
 namespace ppc {
@@ -23,11 +25,7 @@ class MostDifferentNeighborElements : public ppc::core::Task {
   bool pre_processing() override {
     internal_order_test();
     // Init vectors
-    input_ = std::vector<InOutType>(taskData->inputs_count[0]);
-    auto tmp_ptr = reinterpret_cast<InOutType*>(taskData->inputs[0]);
-    for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-      input_[i] = tmp_ptr[i];
-    }
+    input_ = ppc::core::input_view<InOutType>(*taskData, 0);
     // Init value for output
     l_elem = r_elem = 0;
     l_elem_index = r_elem_index = 0;
@@ -36,21 +34,17 @@ class MostDifferentNeighborElements : public ppc::core::Task {
 
   bool validation() override {
     internal_order_test();
-    // Check count elements of output
-    return taskData->outputs_count[0] == 2 && taskData->outputs_count[1] == 2;
+    // Check count elements of output; run() compares neighbours, so at least two inputs
+    return !taskData->inputs_count.empty() && taskData->inputs_count[0] >= 2 && taskData->outputs_count[0] == 2 && taskData->outputs_count[1] == 2;
   }
 
   bool run() override {
     internal_order_test();
-    auto rotate_in = input_;
-    int rot_left = 1;
-    rotate(rotate_in.begin(), rotate_in.begin() + rot_left, rotate_in.end());
-
-    auto temp_res = std::vector<InOutType>(input_.size());
-    std::transform(input_.begin(), input_.end(), rotate_in.begin(), temp_res.begin(),
+    auto temp_res = std::vector<InOutType>(input_.size() - 1);
+    std::transform(input_.begin(), input_.end() - 1, input_.begin() + 1, temp_res.begin(),
                    [](InOutType x, InOutType y) { return std::abs(x - y); });
 
-    auto result = std::max_element(temp_res.begin(), temp_res.end() - 1);
+    auto result = std::max_element(temp_res.begin(), temp_res.end());
     l_elem_index = static_cast<IndexType>(std::distance(temp_res.begin(), result));
     l_elem = input_[l_elem_index];
 
@@ -69,7 +63,7 @@ class MostDifferentNeighborElements : public ppc::core::Task {
   }
 
  private:
-  std::vector<InOutType> input_;
+  std::span<InOutType> input_;
   InOutType l_elem, r_elem;
   IndexType l_elem_index, r_elem_index;
 };
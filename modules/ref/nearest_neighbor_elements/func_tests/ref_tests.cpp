@@ -61,6 +61,26 @@ TEST(nearest_neighbor_elements, check_validate_func) {
   EXPECT_EQ(isValid, false);
 }
 
+TEST(nearest_neighbor_elements, check_validate_single_element) {
+  // Create data
+  std::vector<int32_t> in(1, 1);
+  std::vector<int32_t> out(2, 0);
+  std::vector<uint64_t> out_index(2, 0);
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t*>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t*>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t*>(out_index.data()));
+  taskData->outputs_count.emplace_back(out_index.size());
+
+  // Create Task; a single element has no neighbour
+  ppc::reference::NearestNeighborElements<int32_t, uint64_t> testTask(taskData);
+  ASSERT_EQ(testTask.validation(), false);
+}
+
 TEST(nearest_neighbor_elements, check_double) {
   // Create data
   std::vector<double> in(25680, 1);
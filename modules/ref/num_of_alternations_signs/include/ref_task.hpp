@@ -9,8 +9,10 @@
 #include <functional>
 #include <memory>
 #include <numeric>
+#include <span>
 #include <vector>
 
+#include "core/task/include/data_view.hpp"
 #include "core/task/include/task.hpp"
 
 namespace ppc {
@@ -23,11 +25,7 @@ class NumOfAlternationsSigns : public ppc::core::Task {
   bool pre_processing() override {
     internal_order_test();
     // Init vectors
-    input_ = std::vector<InOutType>(taskData->inputs_count[0]);
-    auto tmp_ptr = reinterpret_cast<InOutType*>(taskData->inputs[0]);
-    for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-      input_[i] = tmp_ptr[i];
-    }
+    input_ = ppc::core::input_view<InOutType>(*taskData, 0);
     // Init value for output
     num = 0;
     return true;
@@ -35,20 +33,16 @@ class NumOfAlternationsSigns : public ppc::core::Task {
 
   bool validation() override {
     internal_order_test();
-    // Check count elements of output
-    return taskData->outputs_count[0] == 1;
+    // Check count elements of output; run() compares neighbours, so at least two inputs
+    return !taskData->inputs_count.empty() && taskData->inputs_count[0] >= 2 && taskData->outputs_count[0] == 1;
   }
 
   bool run() override {
     internal_order_test();
-    auto rotate_in = input_;
-    int rot_left = 1;
-    rotate(rotate_in.begin(), rotate_in.begin() + rot_left, rotate_in.end());
+    auto temp_res = std::vector<InOutType>(input_.size() - 1);
+    std::transform(input_.begin(), input_.end() - 1, input_.begin() + 1, temp_res.begin(), std::multiplies<>());
 
-    auto temp_res = input_;
-    std::transform(input_.begin(), input_.end(), rotate_in.begin(), temp_res.begin(), std::multiplies<>());
-
-    num = std::count_if(temp_res.begin(), temp_res.end() - 1, [](InOutType elem) { return elem < 0; });
+    num = std::count_if(temp_res.begin(), temp_res.end(), [](InOutType elem) { return elem < 0; });
     return true;
   }
 
@@ -59,7 +53,7 @@ class NumOfAlternationsSigns : public ppc::core::Task {
   }
 
  private:
-  std::vector<InOutType> input_;
+  std::span<InOutType> input_;
   CountType num;
 };
 
@@ -50,6 +50,23 @@ TEST(num_of_orderly_violations, check_validate_func) {
   ASSERT_EQ(isValid, false);
 }
 
+TEST(num_of_orderly_violations, check_validate_single_element) {
+  // Create data
+  std::vector<int32_t> in(1, 1);
+  std::vector<uint64_t> out(1, 0);
+
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->inputs.emplace_back(reinterpret_cast<uint8_t*>(in.data()));
+  taskData->inputs_count.emplace_back(in.size());
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t*>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // Create Task; a single element has no neighbour
+  ppc::reference::NumOfOrderlyViolations<int32_t, uint64_t> testTask(taskData);
+  ASSERT_EQ(testTask.validation(), false);
+}
+
 TEST(num_of_orderly_violations, check_double) {
   // Create data
   std::vector<double> in(25680, 1);
@@ -1,8 +1,11 @@
 // Copyright 2023 Nesterov Alexander
 #include <gtest/gtest.h>
 
+#include <memory>
+#include <numeric>
 #include <vector>
 
+#include "core/stream/include/stream.hpp"
 #include "core/task/include/task.hpp"
 #include "ref/sum_of_vector_elements/include/ref_task.hpp"
 
@@ -121,3 +124,32 @@ TEST(sum_of_vector_elements, check_float) {
   testTask.post_processing();
   EXPECT_NEAR(out[0], static_cast<float>(in.size()), 1e-3f);
 }
+
+TEST(sum_of_vector_elements, check_streamed_int64_t) {
+  // Create data
+  std::vector<int64_t> in(100003);
+  std::iota(in.begin(), in.end(), -50000);
+  std::vector<int64_t> out(1, 0);
+  // Create TaskData without inputs, they come from the source in chunks
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t*>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+  // Create Task
+  auto source = std::make_shared<ppc::core::MemorySource>(in.data(), in.size() * sizeof(int64_t));
+  ppc::reference::SumOfVectorElements<int64_t> testTask(taskData, source, 4096);
+  ASSERT_TRUE(testTask.is_streaming());
+  ASSERT_EQ(testTask.validation(), true);
+  testTask.pre_processing();
+  testTask.run();
+  testTask.post_processing();
+  ASSERT_EQ(out[0], std::accumulate(in.begin(), in.end(), int64_t{0}));
+}
+
+TEST(sum_of_vector_elements, check_reduce_stream) {
+  // Create data
+  std::vector<int32_t> in(54321, 3);
+  // Read it in chunks on four workers
+  ppc::core::ChunkReader reader(std::make_shared<ppc::core::MemorySource>(in.data(), in.size() * sizeof(int32_t)),
+                                1000, sizeof(int32_t));
+  ASSERT_EQ(ppc::reference::SumOfVectorElements<int32_t>::reduce(reader, 4), 3 * static_cast<int32_t>(in.size()));
+}
@@ -4,26 +4,28 @@
 
 #include <gtest/gtest.h>
 
+#include <cstddef>
 #include <memory>
 #include <numeric>
+#include <utility>
 #include <vector>
 
+#include "core/stream/include/stream.hpp"
 #include "core/task/include/task.hpp"
 
 namespace ppc::reference {
 
+// Sums inputs[0] or, given a source, a stream of InOutType values that is
+// never held in memory as a whole
 template <class InOutType>
-class SumOfVectorElements : public ppc::core::Task {
+class SumOfVectorElements : public ppc::core::StreamingTask {
  public:
-  explicit SumOfVectorElements(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(taskData_) {}
+  explicit SumOfVectorElements(std::shared_ptr<ppc::core::TaskData> taskData_,
+                               std::shared_ptr<ppc::core::ChunkSource> source = nullptr,
+                               std::size_t chunk_bytes = kDefaultChunkBytes)
+      : StreamingTask(std::move(taskData_), std::move(source), chunk_bytes, sizeof(InOutType)) {}
   bool pre_processing() override {
     internal_order_test();
-    // Init vectors
-    input_ = std::vector<InOutType>(taskData->inputs_count[0]);
-    auto tmp_ptr = reinterpret_cast<InOutType*>(taskData->inputs[0]);
-    for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-      input_[i] = tmp_ptr[i];
-    }
     // Init value for output
     sum = 0;
     return true;
@@ -35,20 +37,31 @@ class SumOfVectorElements : public ppc::core::Task {
     return taskData->outputs_count[0] == 1;
   }
 
-  bool run() override {
+  bool post_processing() override {
     internal_order_test();
-    sum = std::accumulate(input_.begin(), input_.end(), 0);
+    reinterpret_cast<InOutType*>(taskData->outputs[0])[0] = sum;
     return true;
   }
 
-  bool post_processing() override {
-    internal_order_test();
-    reinterpret_cast<InOutType*>(taskData->outputs[0])[0] = sum;
+  // the same sum of a stream read with num_workers threads
+  static InOutType reduce(ppc::core::ChunkReader& reader, std::size_t num_workers) {
+    return ppc::core::reduce_stream(
+        reader, num_workers, static_cast<InOutType>(0),
+        [](InOutType& partial, const ppc::core::Chunk& chunk) {
+          auto values = chunk.as<InOutType>();
+          partial = std::accumulate(values.begin(), values.end(), partial);
+        },
+        [](InOutType left, InOutType right) { return left + right; });
+  }
+
+ protected:
+  bool consume(const ppc::core::Chunk& chunk) override {
+    auto values = chunk.as<InOutType>();
+    sum = std::accumulate(values.begin(), values.end(), sum);
     return true;
   }
 
  private:
-  std::vector<InOutType> input_;
   InOutType sum;
 };
 
@@ -9,6 +9,7 @@
 #include <numeric>
 #include <vector>
 
+#include "core/task/include/data_view.hpp"
 #include "core/task/include/task.hpp"
 
 namespace ppc {
@@ -21,16 +22,12 @@ class SumValuesByRowsMatrix : public ppc::core::Task {
   bool pre_processing() override {
     internal_order_test();
     // Init vectors
-    input_ = std::vector<InOutType>(taskData->inputs_count[0]);
-    auto tmp_ptr = reinterpret_cast<InOutType*>(taskData->inputs[0]);
-    for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-      input_[i] = tmp_ptr[i];
-    }
     rows = reinterpret_cast<IndexType*>(taskData->inputs[1])[0];
     cols = reinterpret_cast<IndexType*>(taskData->inputs[1])[1];
+    input_ = ppc::core::input_matrix_view<InOutType>(*taskData, 0, rows, cols);
 
     // Init value for output
-    sum_ = std::vector<InOutType>(cols, 0.f);
+    sum_ = std::vector<InOutType>(rows, 0.f);
     return true;
   }
 
@@ -44,7 +41,8 @@ class SumValuesByRowsMatrix : public ppc::core::Task {
   bool run() override {
     internal_order_test();
     for (size_t i = 0; i < rows; i++) {
-      sum_[i] = std::accumulate(input_.begin() + cols * i, input_.begin() + cols * (i + 1), 0.f);
+      auto row = input_.row(i);
+      sum_[i] = std::accumulate(row.begin(), row.end(), 0.f);
     }
     return true;
   }
@@ -58,7 +56,7 @@ class SumValuesByRowsMatrix : public ppc::core::Task {
   }
 
  private:
-  std::vector<InOutType> input_;
+  ppc::core::MatrixView<InOutType> input_;
   IndexType rows, cols;
   std::vector<InOutType> sum_;
 };
@@ -1,11 +1,14 @@
 import argparse
+import csv
+import json
 import os
 import re
 import xlsxwriter
 import multiprocessing
 
 parser = argparse.ArgumentParser()
-parser.add_argument('-i', '--input', help='Input file path (logs of perf tests, .txt)', required=True)
+parser.add_argument('-i', '--input', help='Input file path (perf results written via PPC_PERF_RESULTS, '
+                                          '.jsonl or .csv, or logs of perf tests, .txt)', required=True)
 parser.add_argument('-o', '--output', help='Output file path (path to .xlsx table)', required=True)
 args = parser.parse_args()
 logs_path = os.path.abspath(args.input)
@@ -16,30 +19,45 @@ list_of_type_of_tasks = ["mpi", "omp", "seq", "stl", "tbb"]
 result_tables = {"pipeline": {}, "task_run": {}}
 set_of_task_name = []
 
-logs_file = open(logs_path, "r")
-logs_lines = logs_file.readlines()
-for line in logs_lines:
-    pattern = r'tasks[\/|\\](\w*)[\/|\\](\w*):(\w*):(-*\d*\.\d*)'
-    result = re.findall(pattern, line)
-    if len(result):
-        task_name = result[0][1]
-        perf_type = result[0][2]
-        set_of_task_name.append(task_name)
-        result_tables[perf_type][task_name] = {}
 
-        for ttype in list_of_type_of_tasks:
-            result_tables[perf_type][task_name][ttype] = -1.0
+def load_records(path):
+    # (backend, task name, perf type, time) from the structured results sink
+    with open(path, "r", newline="") as results_file:
+        if path.endswith(".csv"):
+            rows = list(csv.DictReader(results_file))
+        else:
+            rows = [json.loads(line) for line in results_file if line.strip()]
+    return [(row["backend"], row["task"], row["type"], float(row["time_sec"])) for row in rows]
 
-for line in logs_lines:
-    pattern = r'tasks[\/|\\](\w*)[\/|\\](\w*):(\w*):(-*\d*\.\d*)'
-    result = re.findall(pattern, line)
-    if len(result):
-        task_type = result[0][0]
-        task_name = result[0][1]
-        perf_type = result[0][2]
-        perf_time = float(result[0][3])
-        result_tables[perf_type][task_name][task_type] = perf_time
 
+def parse_logs(path):
+    # (backend, task name, perf type, time) from "tasks/<backend>/<task>:<type>:<time>" lines
+    records = []
+    with open(path, "r") as logs_file:
+        for line in logs_file.readlines():
+            pattern = r'tasks[\/|\\](\w*)[\/|\\](\w*):(\w*):(-*\d*\.\d*)'
+            result = re.findall(pattern, line)
+            if len(result):
+                records.append((result[0][0], result[0][1], result[0][2], float(result[0][3])))
+    return records
+
+
+if logs_path.endswith((".jsonl", ".json", ".csv")):
+    records = load_records(logs_path)
+else:
+    records = parse_logs(logs_path)
+
+for task_type, task_name, perf_type, perf_time in records:
+    if perf_type not in result_tables:
+        continue
+    set_of_task_name.append(task_name)
+    if task_name not in result_tables[perf_type]:
+        result_tables[perf_type][task_name] = {ttype: -1.0 for ttype in list_of_type_of_tasks}
+    result_tables[perf_type][task_name][task_type] = perf_time
+
+for perf_type in result_tables:
+    for task_name in set(set_of_task_name):
+        result_tables[perf_type].setdefault(task_name, {ttype: -1.0 for ttype in list_of_type_of_tasks})
 
 for table_name in result_tables:
     workbook = xlsxwriter.Workbook(os.path.join(xlsx_path, table_name + '_perf_table.xlsx'))
@@ -0,0 +1,97 @@
+import argparse
+import csv
+import json
+import os
+import xlsxwriter
+
+parser = argparse.ArgumentParser()
+parser.add_argument('-i', '--input', help='Input file path (perf results of a scaling sweep, .jsonl)',
+                    required=True, nargs='+')
+parser.add_argument('-o', '--output', help='Output directory (scaling_curves.csv and scaling_curves.xlsx)',
+                    required=True)
+args = parser.parse_args()
+output_path = os.path.abspath(args.output)
+
+# (task, backend, type, scaling) -> {workers: time of one iteration}
+curves = {}
+for input_path in args.input:
+    with open(os.path.abspath(input_path), "r") as results_file:
+        for line in results_file:
+            if not line.strip():
+                continue
+            record = json.loads(line)
+            if record.get("scaling", "none") == "none":
+                continue
+            key = (record["task"], record["backend"], record["type"], record["scaling"])
+            # the median is robust to outliers; fall back to the mean time per iteration
+            iteration_time = record.get("median") or record["time_sec"] / max(record["iterations"], 1)
+            curves.setdefault(key, {})[int(record["workers"])] = iteration_time
+
+
+def curve_points(scaling, times):
+    # strong: S(p) = T(1) / T(p), E(p) = S(p) / p
+    # weak:   E(p) = T(1) / T(p), scaled speedup S(p) = p * E(p)
+    points = []
+    base_time = times.get(1)
+    for workers in sorted(times):
+        time = times[workers]
+        if base_time is None or time <= 0:
+            speedup, efficiency = -1.0, -1.0
+        elif scaling == "strong":
+            speedup = base_time / time
+            efficiency = speedup / workers
+        else:
+            efficiency = base_time / time
+            speedup = workers * efficiency
+        points.append((workers, time, speedup, efficiency))
+    return points
+
+
+with open(os.path.join(output_path, 'scaling_curves.csv'), "w", newline="") as csv_file:
+    writer = csv.writer(csv_file)
+    writer.writerow(["task", "backend", "type", "scaling", "workers", "time_sec", "speedup", "efficiency"])
+    for key in sorted(curves):
+        for point in curve_points(key[3], curves[key]):
+            writer.writerow(list(key) + list(point))
+
+workbook = xlsxwriter.Workbook(os.path.join(output_path, 'scaling_curves.xlsx'))
+bold = workbook.add_format({'bold': True, 'bottom': 2})
+sheet_names = set()
+for key in sorted(curves):
+    task_name, backend, perf_type, scaling = key
+    # sheet names are limited to 31 characters and unique regardless of case;
+    # long task names may clash once cut, an index keeps them apart
+    full_name = scaling + "_" + backend + "_" + perf_type + "_" + task_name
+    sheet_name = full_name[:31]
+    index = 1
+    while sheet_name.lower() in sheet_names:
+        suffix = "_" + str(index)
+        sheet_name = full_name[:31 - len(suffix)] + suffix
+        index += 1
+    sheet_names.add(sheet_name.lower())
+    worksheet = workbook.add_worksheet(sheet_name)
+    worksheet.set_column('A:E', 15)
+    worksheet.write(0, 0, task_name + " (" + backend + ", " + perf_type + ", " + scaling + " scaling)", bold)
+    for column, title in enumerate(["workers", "time_sec", "speedup", "efficiency"]):
+        worksheet.write(1, column, title, bold)
+    points = curve_points(scaling, curves[key])
+    for row, point in enumerate(points):
+        for column, value in enumerate(point):
+            worksheet.write(row + 2, column, value)
+
+    last_row = len(points) + 1
+    for column, title in [(2, "Speedup"), (3, "Efficiency")]:
+        chart = workbook.add_chart({'type': 'line'})
+        chart.add_series({'name': title,
+                          'categories': [worksheet.name, 2, 0, last_row, 0],
+                          'values': [worksheet.name, 2, column, last_row, column],
+                          'marker': {'type': 'circle'}})
+        chart.set_title({'name': title + ", " + scaling + " scaling"})
+        chart.set_x_axis({'name': 'workers'})
+        worksheet.insert_chart(1, 5 + (column - 2) * 8, chart)
+workbook.close()
+
+for key in sorted(curves):
+    print(":".join(key))
+    for workers, time, speedup, efficiency in curve_points(key[3], curves[key]):
+        print("  workers=%d time=%.10f speedup=%.3f efficiency=%.3f" % (workers, time, speedup, efficiency))
@@ -37,6 +37,14 @@ fi
 #fi
 #echo "NUM_PROC: " $NUM_PROC
 
+if [[ -z "$ASAN_RUN" ]]; then
+  if [[ $OSTYPE == "linux-gnu" ]]; then
+    mpirun --oversubscribe -np 4 ./build/bin/core_mpi_func_tests --gtest_repeat=10
+  elif [[ $OSTYPE == "darwin"* ]]; then
+    mpirun -np 2 ./build/bin/core_mpi_func_tests --gtest_repeat=10
+  fi
+fi
+
 # separate tests for debug
 for test_item in $(./build/bin/mpi_func_tests --gtest_list_tests | awk '/\./{ SUITE=$1 }  /  / { print SUITE $1 }')
 do
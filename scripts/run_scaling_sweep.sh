@@ -0,0 +1,42 @@
+#!/bin/bash
+# Strong/weak scaling sweep: reruns perf tests of one backend with 1..N workers
+# (MPI ranks or threads) and builds speedup/efficiency curves from the results.
+#
+#   scripts/run_scaling_sweep.sh <mpi|omp|stl|tbb> <strong|weak> <max_workers> [gtest_filter]
+#
+# Weak scaling relies on perf tests sizing their input with
+# ppc::core::ScalingConfig::from_env().problem_size(...), threaded tasks on
+# ppc::core::get_num_threads() (or OMP_NUM_THREADS for OpenMP).
+
+BACKEND=$1
+MODE=$2
+MAX_WORKERS=$3
+FILTER=${4:-*}
+
+if [[ -z "$BACKEND" || -z "$MODE" || -z "$MAX_WORKERS" ]]; then
+  echo "Usage: $0 <mpi|omp|stl|tbb> <strong|weak> <max_workers> [gtest_filter]"
+  exit 1
+fi
+
+OUT_DIR=build/scaling_dir
+mkdir -p $OUT_DIR
+export PPC_PERF_RESULTS=$(pwd)/$OUT_DIR/${BACKEND}_${MODE}.jsonl
+rm -f "$PPC_PERF_RESULTS"
+export PPC_SCALING_MODE=$MODE
+
+for (( workers=1; workers<=MAX_WORKERS; workers++ ))
+do
+  export PPC_NUM_WORKERS=$workers
+  echo "--- $BACKEND $MODE scaling: $workers worker(s)"
+  if [[ $BACKEND == "mpi" ]]; then
+    if [[ $OSTYPE == "linux-gnu" ]]; then
+      mpirun --oversubscribe -np $workers ./build/bin/mpi_perf_tests --gtest_filter="$FILTER"
+    else
+      mpirun -np $workers ./build/bin/mpi_perf_tests --gtest_filter="$FILTER"
+    fi
+  else
+    OMP_NUM_THREADS=$workers PPC_NUM_THREADS=$workers ./build/bin/${BACKEND}_perf_tests --gtest_filter="$FILTER"
+  fi
+done
+
+python3 scripts/create_scaling_table.py --input "$PPC_PERF_RESULTS" --output $OUT_DIR
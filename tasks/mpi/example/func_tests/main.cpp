@@ -3,8 +3,15 @@
 
 #include <boost/mpi/communicator.hpp>
 #include <boost/mpi/environment.hpp>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
 #include <vector>
 
+#include "core/mpi/include/dispatch_mpi.hpp"
+#include "core/mpi/include/perf_reduce.hpp"
+#include "core/mpi/include/trace_mpi.hpp"
 #include "mpi/example/include/ops_mpi.hpp"
 
 TEST(Parallel_Operations_MPI, Test_Sum) {
@@ -227,13 +234,124 @@ TEST(Parallel_Operations_MPI, Test_Max_2) {
   }
 }
 
+TEST(Parallel_Operations_MPI, Test_Dispatch) {
+  boost::mpi::communicator world;
+  std::vector<int> global_vec;
+  std::vector<int32_t> global_sum(1, 0);
+  // Create TaskData
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+
+  if (world.rank() == 0) {
+    const int count_size_vector = 120;
+    global_vec = nesterov_a_test_task_mpi::getRandomVector(count_size_vector);
+    taskData->inputs.emplace_back(reinterpret_cast<uint8_t*>(global_vec.data()));
+    taskData->inputs_count.emplace_back(global_vec.size());
+    taskData->outputs.emplace_back(reinterpret_cast<uint8_t*>(global_sum.data()));
+    taskData->outputs_count.emplace_back(global_sum.size());
+  }
+
+  // every rank takes the root's size, so all of them create the same backend
+  ppc::core::BackendRegistry registry;
+  nesterov_a_test_task_mpi::register_backends(registry, "+");
+  ppc::core::Dispatcher dispatcher(registry);
+  dispatcher.set_threshold("example", ppc::core::Backend::MPI, 100);
+  dispatcher.set_size_agreement(ppc::core::root_problem_size(world));
+  ppc::core::ExecutionContext context;
+  context.num_ranks = world.size();
+  auto task = dispatcher.create("example", taskData, context);
+  ASSERT_EQ(task->validation(), true);
+  task->pre_processing();
+  task->run();
+  task->post_processing();
+
+  if (world.rank() == 0) {
+    ASSERT_EQ(global_sum[0], std::accumulate(global_vec.begin(), global_vec.end(), 0));
+  }
+}
+
+TEST(Parallel_Operations_MPI, Test_Chunked_Scatter_Gather) {
+  boost::mpi::communicator world;
+  // small chunks force every transfer to be split into several messages
+  const std::uint64_t max_chunk = 7;
+  std::vector<std::uint64_t> counts(world.size());
+  std::vector<std::uint64_t> displs(world.size());
+  std::uint64_t total = 0;
+  for (int proc = 0; proc < world.size(); proc++) {
+    counts[proc] = 10 * (proc + 1) + 3;
+    displs[proc] = total;
+    total += counts[proc];
+  }
+
+  std::vector<int> global_vec;
+  if (world.rank() == 0) {
+    global_vec = nesterov_a_test_task_mpi::getRandomVector(static_cast<int>(total));
+  }
+  ppc::core::broadcast_chunked(world, &total, 1, 0, max_chunk);
+
+  std::vector<int> local_vec(counts[world.rank()]);
+  ppc::core::scatterv_chunked(world, global_vec.data(), counts, displs, local_vec.data(), 0, max_chunk);
+  for (auto& value : local_vec) {
+    value += 1;
+  }
+
+  std::vector<int> gathered(world.rank() == 0 ? total : 0);
+  ppc::core::gatherv_chunked(world, local_vec.data(), counts, displs, gathered.data(), 0, max_chunk);
+
+  if (world.rank() == 0) {
+    for (std::uint64_t i = 0; i < total; i++) {
+      ASSERT_EQ(gathered[i], global_vec[i] + 1);
+    }
+  }
+
+  // rejected before anything is sent, so every rank throws alike
+  EXPECT_THROW(ppc::core::broadcast_chunked(world, &total, 1, 0, 0), std::invalid_argument);
+  EXPECT_THROW(ppc::core::scatterv_chunked(world, global_vec.data(), counts, displs, local_vec.data(), 0, 0),
+               std::invalid_argument);
+}
+
+TEST(Parallel_Operations_MPI, Test_Split_Counts) {
+  std::vector<std::uint64_t> counts;
+  std::vector<std::uint64_t> displs;
+  ppc::core::split_counts(11, 4, counts, displs);
+  EXPECT_EQ(counts, std::vector<std::uint64_t>({3, 3, 3, 2}));
+  EXPECT_EQ(displs, std::vector<std::uint64_t>({0, 3, 6, 9}));
+  ppc::core::split_counts(2, 3, counts, displs);
+  EXPECT_EQ(counts, std::vector<std::uint64_t>({1, 1, 0}));
+  EXPECT_EQ(displs, std::vector<std::uint64_t>({0, 1, 2}));
+}
+
+TEST(Parallel_Operations_MPI, Test_Rank_Timings) {
+  boost::mpi::communicator world;
+  // rank r pretends to have worked r + 1 seconds, 2 * (r + 1) of them in run()
+  ppc::core::PerfResults perfResults;
+  perfResults.time_sec = world.rank() + 1.0;
+  perfResults.stage_timings.total_sec[static_cast<size_t>(ppc::core::TaskStage::RUN)] = 2.0 * (world.rank() + 1);
+  perfResults.stage_timings.calls[static_cast<size_t>(ppc::core::TaskStage::RUN)] = 1;
+
+  auto timings = ppc::core::rank_reducer(world)(perfResults);
+
+  auto size = static_cast<double>(world.size());
+  ASSERT_EQ(timings.num_ranks, world.size());
+  EXPECT_DOUBLE_EQ(timings.total.min, 1.0);
+  EXPECT_DOUBLE_EQ(timings.total.max, size);
+  EXPECT_DOUBLE_EQ(timings.total.mean, (size + 1.0) / 2.0);
+  EXPECT_DOUBLE_EQ(timings.total.imbalance(), 2.0 * size / (size + 1.0));
+  const auto& run = timings.stages[static_cast<size_t>(ppc::core::TaskStage::RUN)];
+  EXPECT_DOUBLE_EQ(run.max, 2.0 * size);
+  EXPECT_DOUBLE_EQ(timings.stages[static_cast<size_t>(ppc::core::TaskStage::VALIDATION)].max, 0.0);
+}
+
 int main(int argc, char** argv) {
   boost::mpi::environment env(argc, argv);
   boost::mpi::communicator world;
+  // PPC_TRACE=<file> records a timeline of all ranks
+  auto trace = ppc::core::TraceRecorder::global().enable_from_env();
   ::testing::InitGoogleTest(&argc, argv);
   ::testing::TestEventListeners& listeners = ::testing::UnitTest::GetInstance()->listeners();
   if (world.rank() != 0) {
     delete listeners.Release(listeners.default_result_printer());
   }
-  return RUN_ALL_TESTS();
+  auto result = RUN_ALL_TESTS();
+  ppc::core::write_trace(world, trace);
+  return result;
 }
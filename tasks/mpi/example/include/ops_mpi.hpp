@@ -7,16 +7,25 @@
 #include <boost/mpi/communicator.hpp>
 #include <memory>
 #include <numeric>
+#include <span>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "core/dispatch/include/dispatcher.hpp"
+#include "core/mpi/include/chunked_transfer.hpp"
+#include "core/placement/include/placement.hpp"
+#include "core/task/include/data_view.hpp"
 #include "core/task/include/task.hpp"
 
 namespace nesterov_a_test_task_mpi {
 
 std::vector<int> getRandomVector(int sz);
 
+// Problem "example" with operation ops: TestMPITaskSequential as SEQ,
+// TestMPITaskParallel as MPI, for ppc::core::Dispatcher
+void register_backends(ppc::core::BackendRegistry& registry, const std::string& ops);
+
 class TestMPITaskSequential : public ppc::core::Task {
  public:
   explicit TestMPITaskSequential(std::shared_ptr<ppc::core::TaskData> taskData_, std::string ops_)
@@ -27,7 +36,7 @@ class TestMPITaskSequential : public ppc::core::Task {
   bool post_processing() override;
 
  private:
-  std::vector<int> input_;
+  std::span<int> input_;
   int res{};
   std::string ops;
 };
@@ -42,7 +51,10 @@ class TestMPITaskParallel : public ppc::core::Task {
   bool post_processing() override;
 
  private:
-  std::vector<int> input_, local_input_;
+  std::span<int> input_;
+  // received slice, placed on the node of this rank; root reads its slice in place
+  std::unique_ptr<int[]> local_buffer_;
+  std::span<int> local_input_;
   int res{};
   std::string ops;
   boost::mpi::communicator world;
@@ -4,7 +4,11 @@
 #include <boost/mpi/timer.hpp>
 #include <vector>
 
+#include "core/mpi/include/perf_reduce.hpp"
+#include "core/mpi/include/trace_mpi.hpp"
 #include "core/perf/include/perf.hpp"
+#include "core/perf/include/scaling.hpp"
+#include "core/placement/include/placement.hpp"
 #include "mpi/example/include/ops_mpi.hpp"
 
 TEST(mpi_example_perf_test, test_pipeline_run) {
@@ -15,7 +19,7 @@ TEST(mpi_example_perf_test, test_pipeline_run) {
   std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
   int count_size_vector;
   if (world.rank() == 0) {
-    count_size_vector = 120;
+    count_size_vector = static_cast<int>(ppc::core::ScalingConfig::from_env().problem_size(120));
     global_vec = std::vector<int>(count_size_vector, 1);
     taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(global_vec.data()));
     taskDataPar->inputs_count.emplace_back(global_vec.size());
@@ -34,6 +38,8 @@ TEST(mpi_example_perf_test, test_pipeline_run) {
   perfAttr->num_running = 10;
   const boost::mpi::timer current_timer;
   perfAttr->current_timer = [&] { return current_timer.elapsed(); };
+  perfAttr->reduce_across_ranks = ppc::core::rank_reducer(world);
+  perfAttr->max_across_ranks = ppc::core::rank_max(world);
 
   // Create and init perf results
   auto perfResults = std::make_shared<ppc::core::PerfResults>();
@@ -55,7 +61,7 @@ TEST(mpi_example_perf_test, test_task_run) {
   std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
   int count_size_vector;
   if (world.rank() == 0) {
-    count_size_vector = 120;
+    count_size_vector = static_cast<int>(ppc::core::ScalingConfig::from_env().problem_size(120));
     global_vec = std::vector<int>(count_size_vector, 1);
     taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(global_vec.data()));
     taskDataPar->inputs_count.emplace_back(global_vec.size());
@@ -74,6 +80,8 @@ TEST(mpi_example_perf_test, test_task_run) {
   perfAttr->num_running = 10;
   const boost::mpi::timer current_timer;
   perfAttr->current_timer = [&] { return current_timer.elapsed(); };
+  perfAttr->reduce_across_ranks = ppc::core::rank_reducer(world);
+  perfAttr->max_across_ranks = ppc::core::rank_max(world);
 
   // Create and init perf results
   auto perfResults = std::make_shared<ppc::core::PerfResults>();
@@ -90,10 +98,15 @@ TEST(mpi_example_perf_test, test_task_run) {
 int main(int argc, char** argv) {
   boost::mpi::environment env(argc, argv);
   boost::mpi::communicator world;
+  ppc::core::pin_rank();
+  // PPC_TRACE=<file> records a timeline of all ranks
+  auto trace = ppc::core::TraceRecorder::global().enable_from_env();
   ::testing::InitGoogleTest(&argc, argv);
   ::testing::TestEventListeners& listeners = ::testing::UnitTest::GetInstance()->listeners();
   if (world.rank() != 0) {
     delete listeners.Release(listeners.default_result_printer());
   }
-  return RUN_ALL_TESTS();
+  auto result = RUN_ALL_TESTS();
+  ppc::core::write_trace(world, trace);
+  return result;
 }
@@ -2,10 +2,13 @@
 #include "mpi/example/include/ops_mpi.hpp"
 
 #include <algorithm>
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <random>
 #include <string>
 #include <thread>
+#include <utility>
 #include <vector>
 
 using namespace std::chrono_literals;
@@ -20,14 +23,19 @@ std::vector<int> nesterov_a_test_task_mpi::getRandomVector(int sz) {
   return vec;
 }
 
+void nesterov_a_test_task_mpi::register_backends(ppc::core::BackendRegistry& registry, const std::string& ops) {
+  registry.add("example", ppc::core::Backend::SEQ, [ops](std::shared_ptr<ppc::core::TaskData> taskData) {
+    return std::make_shared<TestMPITaskSequential>(std::move(taskData), ops);
+  });
+  registry.add("example", ppc::core::Backend::MPI, [ops](std::shared_ptr<ppc::core::TaskData> taskData) {
+    return std::make_shared<TestMPITaskParallel>(std::move(taskData), ops);
+  });
+}
+
 bool nesterov_a_test_task_mpi::TestMPITaskSequential::pre_processing() {
   internal_order_test();
   // Init vectors
-  input_ = std::vector<int>(taskData->inputs_count[0]);
-  auto* tmp_ptr = reinterpret_cast<int*>(taskData->inputs[0]);
-  for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-    input_[i] = tmp_ptr[i];
-  }
+  input_ = ppc::core::input_view<int>(*taskData, 0);
   // Init value for output
   res = 0;
   return true;
@@ -59,7 +67,7 @@ bool nesterov_a_test_task_mpi::TestMPITaskSequential::post_processing() {
 
 bool nesterov_a_test_task_mpi::TestMPITaskParallel::pre_processing() {
   internal_order_test();
-  unsigned int delta = 0;
+  std::uint64_t delta = 0;
   if (world.rank() == 0) {
     delta = taskData->inputs_count[0] / world.size();
   }
@@ -67,20 +75,18 @@ bool nesterov_a_test_task_mpi::TestMPITaskParallel::pre_processing() {
 
   if (world.rank() == 0) {
     // Init vectors
-    input_ = std::vector<int>(taskData->inputs_count[0]);
-    auto* tmp_ptr = reinterpret_cast<int*>(taskData->inputs[0]);
-    for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-      input_[i] = tmp_ptr[i];
-    }
+    input_ = ppc::core::input_view<int>(*taskData, 0);
     for (int proc = 1; proc < world.size(); proc++) {
-      world.send(proc, 0, input_.data() + proc * delta, delta);
+      ppc::core::send_chunked(world, proc, 0, input_.data() + proc * delta, delta);
     }
   }
-  local_input_ = std::vector<int>(delta);
   if (world.rank() == 0) {
-    local_input_ = std::vector<int>(input_.begin(), input_.begin() + delta);
+    local_input_ = input_.first(delta);
   } else {
-    world.recv(0, 0, local_input_.data(), delta);
+    // zeroed by this rank, so once pin_rank() bound it the pages are on its node
+    local_buffer_ = ppc::core::make_first_touched<int>(delta, {});
+    local_input_ = std::span<int>(local_buffer_.get(), delta);
+    ppc::core::recv_chunked(world, 0, 0, local_input_.data(), delta);
   }
   // Init value for output
   res = 0;
@@ -21,6 +21,7 @@ class MPISumOfVectorSequential : public ppc::core::Task {
   bool validation() override;
   bool run() override;
   bool post_processing() override;
+  [[nodiscard]] ppc::core::TaskWork work() const override;
 
  private:
   std::vector<int> input_;
@@ -36,6 +37,7 @@ class MPISumOfVectorParallel : public ppc::core::Task {
   bool validation() override;
   bool run() override;
   bool post_processing() override;
+  [[nodiscard]] ppc::core::TaskWork work() const override;
 
  private:
   std::vector<int> input_, local_input_;
@@ -117,3 +117,18 @@ bool gromov_a_sum_of_vector_elements_mpi::MPISumOfVectorParallel::post_processin
   }
   return true;
 }
+
+ppc::core::TaskWork gromov_a_sum_of_vector_elements_mpi::MPISumOfVectorSequential::work() const {
+  // one pass over the vector, one operation per element
+  uint64_t count = input_.size();
+  return {count * sizeof(int), count};
+}
+
+ppc::core::TaskWork gromov_a_sum_of_vector_elements_mpi::MPISumOfVectorParallel::work() const {
+  // the whole vector over all ranks; only the root knows its size
+  if (taskData->inputs_count.empty()) {
+    return {};
+  }
+  uint64_t count = taskData->inputs_count[0];
+  return {count * sizeof(int), count};
+}
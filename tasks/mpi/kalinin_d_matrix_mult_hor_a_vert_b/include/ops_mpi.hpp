@@ -23,6 +23,7 @@ class TestMPITaskSequential : public ppc::core::Task {
   bool validation() override;
   bool run() override;
   bool post_processing() override;
+  [[nodiscard]] ppc::core::TaskWork work() const override;
 
  private:
   std::vector<int> input_;
@@ -44,6 +45,7 @@ class TestMPITaskParallel : public ppc::core::Task {
   bool validation() override;
   bool run() override;
   bool post_processing() override;
+  [[nodiscard]] ppc::core::TaskWork work() const override;
   int column_A;
   int row_A;
   int column_B;
@@ -7,6 +7,8 @@
 #include <thread>
 #include <vector>
 
+#include "core/perf/include/roofline.hpp"
+
 bool kalinin_d_matrix_mult_hor_a_vert_b_mpi::TestMPITaskSequential::pre_processing() {
   internal_order_test();
 
@@ -218,3 +220,15 @@ bool kalinin_d_matrix_mult_hor_a_vert_b_mpi::TestMPITaskParallel::post_processin
 
   return true;
 }
+
+ppc::core::TaskWork kalinin_d_matrix_mult_hor_a_vert_b_mpi::TestMPITaskSequential::work() const {
+  return ppc::core::matmul_work(rows_A, columns_A, columns_B, sizeof(int));
+}
+
+ppc::core::TaskWork kalinin_d_matrix_mult_hor_a_vert_b_mpi::TestMPITaskParallel::work() const {
+  // the whole product over all ranks; only the root knows the sizes
+  if (world.rank() != 0) {
+    return {};
+  }
+  return ppc::core::matmul_work(rows_A, columns_A, columns_B, sizeof(int));
+}
@@ -8,7 +8,10 @@
 #include <thread>
 #include <vector>
 
+#include "core/mpi/include/trace_mpi.hpp"
+
 int kalyakina_a_producers_consumers_mpi::ProducersConsumersTaskParallel::ProducersFunction() {
+  ppc::core::TraceScope scope("produce");
   std::random_device dev;
   std::mt19937 gen(dev());
   int data = (gen() % (20) + 1);
@@ -16,6 +19,7 @@ int kalyakina_a_producers_consumers_mpi::ProducersConsumersTaskParallel::Produce
   return data;
 }
 void kalyakina_a_producers_consumers_mpi::ProducersConsumersTaskParallel::ConsumersFunction(int data) {
+  ppc::core::TraceScope scope("consume");
   data = 25 - data;
   if (data > 0) {
     std::this_thread::sleep_for(std::chrono::milliseconds(data));
@@ -65,14 +69,14 @@ bool kalyakina_a_producers_consumers_mpi::ProducersConsumersTaskParallel::run()
     boost::mpi::status stat;
     // Freeing up unnecessary processes
     for (int i = std::max(sources, 1); i < producers_count; i++) {
-      world.send(i, 0, false);
+      ppc::core::traced_send(world, i, 0, false);
     }
     for (int i = producers_count + sources; i < world.size(); i++) {
-      world.send(i, 1, 0);
+      ppc::core::traced_send(world, i, 1, 0);
     }
 
     for (int i = 1; i < std::min(sources, producers_count); i++) {
-      world.send(i, 0, true);
+      ppc::core::traced_send(world, i, 0, true);
       produce_sources--;
     }
 
@@ -86,13 +90,13 @@ bool kalyakina_a_producers_consumers_mpi::ProducersConsumersTaskParallel::run()
         if (buffer.size() < buffer_size) {
           stat = world.probe(MPI_ANY_SOURCE, 0);
           int data;
-          world.recv(stat.source(), stat.tag(), data);
+          ppc::core::traced_recv(world, stat.source(), stat.tag(), data);
           buffer.push(data);
           if (produce_sources > 0) {
-            world.send(stat.source(), stat.tag(), true);
+            ppc::core::traced_send(world, stat.source(), stat.tag(), true);
             produce_sources--;
           } else {
-            world.send(stat.source(), stat.tag(), false);
+            ppc::core::traced_send(world, stat.source(), stat.tag(), false);
           }
         }
       }
@@ -104,13 +108,13 @@ bool kalyakina_a_producers_consumers_mpi::ProducersConsumersTaskParallel::run()
       if (world.iprobe(MPI_ANY_SOURCE, 1)) {
         stat = world.probe(MPI_ANY_SOURCE, 1);
         bool answer;
-        world.recv(stat.source(), stat.tag(), answer);
+        ppc::core::traced_recv(world, stat.source(), stat.tag(), answer);
         free_consumers.push(stat.source());
         sources--;
       }
       // Sending data to the consumer
       if ((!free_consumers.empty()) && (!buffer.empty())) {
-        world.send(free_consumers.front(), 2, buffer.front());
+        ppc::core::traced_send(world, free_consumers.front(), 2, buffer.front());
         free_consumers.pop();
         buffer.pop();
         consum_sources--;
@@ -118,7 +122,7 @@ bool kalyakina_a_producers_consumers_mpi::ProducersConsumersTaskParallel::run()
     }
     // Freeing up of consumers
     while (!free_consumers.empty()) {
-      world.send(free_consumers.front(), 1, 0);
+      ppc::core::traced_send(world, free_consumers.front(), 1, 0);
       free_consumers.pop();
     }
     result = sources + produce_sources + consum_sources + buffer.size();
@@ -126,12 +130,12 @@ bool kalyakina_a_producers_consumers_mpi::ProducersConsumersTaskParallel::run()
     bool answer;
     int tmp;
     while (true) {
-      world.recv(0, 0, answer);
+      ppc::core::traced_recv(world, 0, 0, answer);
       if (!answer) {
         break;
       }
       tmp = ProducersFunction();
-      world.send(0, 0, tmp);
+      ppc::core::traced_send(world, 0, 0, tmp);
     }
   } else {  // Consumers
     int data;
@@ -139,11 +143,11 @@ bool kalyakina_a_producers_consumers_mpi::ProducersConsumersTaskParallel::run()
     while (true) {
       stat = world.probe(0, MPI_ANY_TAG);
       if (stat.tag() == 2) {
-        world.recv(0, 2, data);
+        ppc::core::traced_recv(world, 0, 2, data);
         ConsumersFunction(data);
-        world.send(0, 1, true);
+        ppc::core::traced_send(world, 0, 1, true);
       } else if (stat.tag() == 1) {
-        world.recv(0, 1, data);
+        ppc::core::traced_recv(world, 0, 1, data);
         break;
       }
     }
@@ -8,6 +8,8 @@
 #include <utility>
 #include <vector>
 
+#include "core/checkpoint/include/checkpoint.hpp"
+#include "core/task/include/data_view.hpp"
 #include "core/task/include/task.hpp"
 
 namespace kavtorev_d_iterative_jacobi_mpi {
@@ -23,6 +25,10 @@ class IterativeJacobiParallelMPI : public ppc::core::Task {
   bool run() override;
   bool post_processing() override;
 
+  // snapshots of X taken on rank 0, so an interrupted run resumes where it
+  // stopped; set from PPC_CHECKPOINT_DIR by default, nullptr disables them
+  void set_checkpoint(std::shared_ptr<ppc::core::Checkpointer> checkpoint_) { checkpoint = std::move(checkpoint_); }
+
  private:
   std::vector<double> A_flat;
   std::vector<double> F;
@@ -47,6 +53,9 @@ class IterativeJacobiParallelMPI : public ppc::core::Task {
   std::vector<int> sendcounts_F;
   std::vector<int> displs_F;
 
+  std::shared_ptr<ppc::core::Checkpointer> checkpoint =
+      ppc::core::Checkpointer::from_env("kavtorev_d_iterative_jacobi");
+
   boost::mpi::communicator world;
 };
 
@@ -4,6 +4,8 @@
 #include <boost/serialization/vector.hpp>
 #include <cassert>
 #include <cmath>
+#include <exception>
+#include <iostream>
 
 void calculate_sizes_displs(int N, int num_proc, std::vector<int>& sizes, std::vector<int>& displs) {
   sizes.resize(num_proc);
@@ -31,8 +33,9 @@ bool kavtorev_d_iterative_jacobi_mpi::IterativeJacobiParallelMPI::validation() {
 
   if (taskData->inputs.size() < 5 || taskData->outputs.empty()) return false;
 
-  if ((taskData->inputs[0] == nullptr) || (taskData->inputs[1] == nullptr) || (taskData->inputs[2] == nullptr) ||
-      (taskData->inputs[3] == nullptr) || (taskData->inputs[4] == nullptr))
+  if (!ppc::core::has_input<int>(*taskData, 0) || !ppc::core::has_input<double>(*taskData, 1) ||
+      !ppc::core::has_input<int>(*taskData, 2) || !ppc::core::has_input<double>(*taskData, 3) ||
+      !ppc::core::has_input<double>(*taskData, 4))
     return false;
   if (taskData->outputs[0] == nullptr) return false;
 
@@ -62,8 +65,8 @@ bool kavtorev_d_iterative_jacobi_mpi::IterativeJacobiParallelMPI::validation() {
 
   if (val_output_size < val_n) return false;
 
-  std::vector<double> val_A_flat(val_A_data, val_A_data + val_A_size);
-  std::vector<double> val_F(val_F_data, val_F_data + val_F_size);
+  auto val_A_flat = ppc::core::input_view<double>(*taskData, 3);
+  auto val_F = ppc::core::input_view<double>(*taskData, 4);
 
   for (size_t i = 0; i < val_A_flat.size(); ++i)
     if (std::isnan(val_A_flat[i]) || std::isinf(val_A_flat[i])) return false;
@@ -153,6 +156,18 @@ bool kavtorev_d_iterative_jacobi_mpi::IterativeJacobiParallelMPI::run() {
     boost::mpi::scatterv(world, local_F.data(), sendcounts_F[rank], 0);
   }
 
+  // resume from the last snapshot of this system
+  uint64_t problem = 0;
+  int iteration = 0;
+  if (rank == 0 && checkpoint) {
+    problem = ppc::core::fingerprint(F.data(), F.size() * sizeof(double),
+                                     ppc::core::fingerprint(A_flat.data(), A_flat.size() * sizeof(double)));
+    if (auto state = checkpoint->load(problem); state && state->x.size() == X.size()) {
+      X = std::move(state->x);
+      iteration = static_cast<int>(state->iteration);
+    }
+  }
+  boost::mpi::broadcast(world, iteration, 0);
   boost::mpi::broadcast(world, X, 0);
 
   std::vector<std::vector<double>> local_A(local_size, std::vector<double>(n));
@@ -165,7 +180,6 @@ bool kavtorev_d_iterative_jacobi_mpi::IterativeJacobiParallelMPI::run() {
   std::vector<double> TempX(n);
   double norm;
 
-  int iteration = 0;
   do {
     std::vector<double> local_TempX(local_size);
     for (int i = 0; i < local_size; ++i) {
@@ -198,8 +212,14 @@ bool kavtorev_d_iterative_jacobi_mpi::IterativeJacobiParallelMPI::run() {
 
     iteration++;
 
+    if (rank == 0 && checkpoint && norm > eps) {
+      checkpoint->try_snapshot(problem, iteration, norm, X);
+    }
   } while (iteration < iterations && norm > eps);
 
+  if (rank == 0 && checkpoint) {
+    checkpoint->try_finish();
+  }
   return iteration != iterations;
 }
 
@@ -252,8 +272,9 @@ bool kavtorev_d_iterative_jacobi_mpi::IterativeJacobiSequentialMPI::validation()
     return false;
   }
 
-  if ((taskData->inputs[0] == nullptr) || (taskData->inputs[1] == nullptr) || (taskData->inputs[2] == nullptr) ||
-      (taskData->inputs[3] == nullptr) || (taskData->inputs[4] == nullptr)) {
+  if (!ppc::core::has_input<int>(*taskData, 0) || !ppc::core::has_input<double>(*taskData, 1) ||
+      !ppc::core::has_input<int>(*taskData, 2) || !ppc::core::has_input<double>(*taskData, 3) ||
+      !ppc::core::has_input<double>(*taskData, 4)) {
     return false;
   }
 
@@ -304,8 +325,8 @@ bool kavtorev_d_iterative_jacobi_mpi::IterativeJacobiSequentialMPI::validation()
     return false;
   }
 
-  std::vector<double> val_A_flat(val_A_data, val_A_data + val_A_size);
-  std::vector<double> val_F(val_F_data, val_F_data + val_F_size);
+  auto val_A_flat = ppc::core::input_view<double>(*taskData, 3);
+  auto val_F = ppc::core::input_view<double>(*taskData, 4);
 
   for (size_t i = 0; i < val_A_flat.size(); ++i) {
     if (std::isnan(val_A_flat[i]) || std::isinf(val_A_flat[i])) {
@@ -3,10 +3,12 @@
 #include <boost/mpi/communicator.hpp>
 #include <boost/mpi/environment.hpp>
 #include <cmath>
+#include <filesystem>
 #include <memory>
 #include <random>
 #include <vector>
 
+#include "core/checkpoint/include/checkpoint.hpp"
 #include "mpi/korablev_v_jacobi_method/include/ops_mpi.hpp"
 
 namespace korablev_v_jacobi_method_mpi {
@@ -269,4 +271,57 @@ TEST(korablev_v_jacobi_method_mpi, singular_matrix) {
   } else {
     ASSERT_TRUE(true) << "Process " << world.rank() << " completed successfully.";
   }
-}
\ No newline at end of file
+}
+TEST(korablev_v_jacobi_method_mpi, resume_from_checkpoint) {
+  boost::mpi::communicator world;
+  const size_t matrix_size = 16;
+  auto [A_flat, b] = korablev_v_jacobi_method_mpi::generate_diagonally_dominant_matrix(matrix_size);
+  size_t matrix_size_copy = matrix_size;
+  auto path = (std::filesystem::temp_directory_path() / "korablev_v_jacobi_method_resume.ckpt").string();
+
+  auto solve = [&](const std::shared_ptr<ppc::core::Checkpointer>& checkpoint) {
+    std::vector<double> x(matrix_size, 0.0);
+    std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+    if (world.rank() == 0) {
+      taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(&matrix_size_copy));
+      taskDataPar->inputs_count.emplace_back(1);
+      taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(A_flat.data()));
+      taskDataPar->inputs_count.emplace_back(A_flat.size());
+      taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(b.data()));
+      taskDataPar->inputs_count.emplace_back(b.size());
+      taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(x.data()));
+      taskDataPar->outputs_count.emplace_back(x.size());
+    }
+    korablev_v_jacobi_method_mpi::JacobiMethodParallel jacobi_parallel(taskDataPar);
+    jacobi_parallel.set_checkpoint(checkpoint);
+    EXPECT_TRUE(jacobi_parallel.validation());
+    jacobi_parallel.pre_processing();
+    jacobi_parallel.run();
+    jacobi_parallel.post_processing();
+    return x;
+  };
+
+  // a snapshot every iteration; a finished run removes it
+  auto checkpoint = std::make_shared<ppc::core::Checkpointer>(path, 1);
+  auto x = solve(checkpoint);
+  if (world.rank() == 0) {
+    EXPECT_GT(checkpoint->stats().taken, 0U);
+    EXPECT_FALSE(std::filesystem::exists(path));
+
+    // the solution left behind by an interrupted run
+    ppc::core::Checkpointer interrupted(path, 1);
+    interrupted.snapshot(ppc::core::fingerprint(b.data(), b.size() * sizeof(double),
+                                                ppc::core::fingerprint(A_flat.data(), A_flat.size() * sizeof(double))),
+                         1, 1.0, x);
+    interrupted.flush();
+  }
+
+  // resuming from it converges at once, with no iteration left to snapshot
+  auto resumed = std::make_shared<ppc::core::Checkpointer>(path, 1);
+  auto x_resumed = solve(resumed);
+  if (world.rank() == 0) {
+    EXPECT_EQ(resumed->stats().taken, 0U);
+    EXPECT_LT(korablev_v_jacobi_method_mpi::calculate_residual(A_flat, x_resumed, b, matrix_size), 1e-3);
+    EXPECT_FALSE(std::filesystem::exists(path));
+  }
+}
@@ -5,10 +5,13 @@
 #include <boost/mpi.hpp>
 #include <boost/mpi/collectives.hpp>
 #include <boost/mpi/communicator.hpp>
+#include <cstdint>
 #include <memory>
 #include <utility>
 #include <vector>
 
+#include "core/checkpoint/include/checkpoint.hpp"
+#include "core/mpi/include/chunked_transfer.hpp"
 #include "core/task/include/task.hpp"
 
 namespace korablev_v_jacobi_method_mpi {
@@ -40,6 +43,10 @@ class JacobiMethodParallel : public ppc::core::Task {
   bool run() override;
   bool post_processing() override;
 
+  // snapshots of x_ taken on rank 0, so an interrupted run resumes where it
+  // stopped; set from PPC_CHECKPOINT_DIR by default, nullptr disables them
+  void set_checkpoint(std::shared_ptr<ppc::core::Checkpointer> checkpoint_) { checkpoint = std::move(checkpoint_); }
+
  private:
   std::vector<double> A_;
   std::vector<double> b_;
@@ -50,17 +57,20 @@ class JacobiMethodParallel : public ppc::core::Task {
   std::vector<double> local_A;
   std::vector<double> local_b;
 
-  std::vector<int> sizes_a;
-  std::vector<int> displs_a;
+  std::vector<uint64_t> sizes_a;
+  std::vector<uint64_t> displs_a;
   std::vector<int> sizes_b;
   std::vector<int> displs_b;
 
   size_t maxIterations_ = 2000;
   double epsilon_ = 1e-5;
-  bool isNeedToComplete(const std::vector<double>& x_old, const std::vector<double>& x_new) const;
+  static double relativeChange(const std::vector<double>& x_old, const std::vector<double>& x_new);
+
+  std::shared_ptr<ppc::core::Checkpointer> checkpoint = ppc::core::Checkpointer::from_env("korablev_v_jacobi_method");
 
   boost::mpi::communicator world;
-  static void calculate_distribution_a(int rows, int num_proc, std::vector<int>& sizes, std::vector<int>& displs);
+  static void calculate_distribution_a(uint64_t rows, int num_proc, std::vector<uint64_t>& sizes,
+                                       std::vector<uint64_t>& displs);
   static void calculate_distribution_b(int len, int num_proc, std::vector<int>& sizes, std::vector<int>& displs);
   static bool isNonSingular(const std::vector<double>& A, size_t n);
 };
@@ -3,10 +3,12 @@
 #include <boost/mpi/communicator.hpp>
 #include <boost/mpi/environment.hpp>
 #include <cmath>
+#include <filesystem>
 #include <memory>
 #include <random>
 #include <vector>
 
+#include "core/checkpoint/include/checkpoint.hpp"
 #include "core/perf/include/perf.hpp"
 #include "mpi/korablev_v_jacobi_method/include/ops_mpi.hpp"
 
@@ -119,4 +121,51 @@ TEST(korablev_v_jacobi_method, test_task_run) {
     ppc::core::Perf::print_perf_statistic(perfResults);
     ASSERT_EQ(matrix_size, out.size());
   }
-}
\ No newline at end of file
+}
+
+TEST(korablev_v_jacobi_method, test_pipeline_run_checkpointed) {
+  boost::mpi::communicator world;
+
+  const size_t matrix_size = 512;
+  auto [A_flat, b] = generate_diagonally_dominant_matrix(matrix_size);
+
+  std::vector<size_t> in_size(1, matrix_size);
+  std::vector<double> out(matrix_size, 0.0);
+
+  std::shared_ptr<ppc::core::TaskData> taskDataPar = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(in_size.data()));
+    taskDataPar->inputs_count.emplace_back(in_size.size());
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(A_flat.data()));
+    taskDataPar->inputs_count.emplace_back(A_flat.size());
+    taskDataPar->inputs.emplace_back(reinterpret_cast<uint8_t*>(b.data()));
+    taskDataPar->inputs_count.emplace_back(b.size());
+    taskDataPar->outputs.emplace_back(reinterpret_cast<uint8_t*>(out.data()));
+    taskDataPar->outputs_count.emplace_back(out.size());
+  }
+
+  // a snapshot after every iteration: the worst case of the overhead
+  auto checkpoint = std::make_shared<ppc::core::Checkpointer>(
+      (std::filesystem::temp_directory_path() / "korablev_v_jacobi_method_perf.ckpt").string(), 1);
+  auto jacobiTaskParallel = std::make_shared<korablev_v_jacobi_method_mpi::JacobiMethodParallel>(taskDataPar);
+  jacobiTaskParallel->set_checkpoint(checkpoint);
+
+  auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+  perfAttr->num_running = 10;
+  const boost::mpi::timer current_timer;
+  perfAttr->current_timer = [&] { return current_timer.elapsed(); };
+
+  auto perfResults = std::make_shared<ppc::core::PerfResults>();
+
+  auto perfAnalyzer = std::make_shared<ppc::core::Perf>(jacobiTaskParallel);
+  perfAnalyzer->pipeline_run(perfAttr, perfResults);
+  if (world.rank() == 0) {
+    auto stats = checkpoint->stats();
+    perfResults->metrics = {{"checkpoints_taken", static_cast<double>(stats.taken)},
+                            {"checkpoints_written", static_cast<double>(stats.written)},
+                            {"checkpoint_copy_sec", stats.copy_sec},
+                            {"checkpoint_write_sec", stats.write_sec}};
+    ppc::core::Perf::print_perf_statistic(perfResults);
+    ASSERT_EQ(matrix_size, out.size());
+  }
+}
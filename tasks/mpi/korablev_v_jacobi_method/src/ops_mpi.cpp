@@ -6,6 +6,7 @@
 #include <boost/mpi.hpp>
 #include <boost/serialization/vector.hpp>
 #include <cmath>
+#include <iostream>
 #include <vector>
 
 #include "boost/mpi/collectives/broadcast.hpp"
@@ -139,15 +140,15 @@ bool korablev_v_jacobi_method_mpi::JacobiMethodSequential::post_processing() {
   return true;
 }
 
-bool korablev_v_jacobi_method_mpi::JacobiMethodParallel::isNeedToComplete(const std::vector<double>& x_old,
-                                                                          const std::vector<double>& x_new) const {
+double korablev_v_jacobi_method_mpi::JacobiMethodParallel::relativeChange(const std::vector<double>& x_old,
+                                                                          const std::vector<double>& x_new) {
   double sum_up = 0;
   double sum_low = 0;
   for (size_t k = 0; k < x_old.size(); k++) {
     sum_up += (x_new[k] - x_old[k]) * (x_new[k] - x_old[k]);
     sum_low += x_new[k] * x_new[k];
   }
-  return (sqrt(sum_up / sum_low) < epsilon_);
+  return sqrt(sum_up / sum_low);
 }
 
 bool korablev_v_jacobi_method_mpi::JacobiMethodParallel::pre_processing() {
@@ -229,22 +230,33 @@ bool korablev_v_jacobi_method_mpi::JacobiMethodParallel::run() {
   boost::mpi::broadcast(world, displs_b, 0);
   boost::mpi::broadcast(world, n, 0);
 
-  int loc_mat_size = sizes_a[world.rank()];
   int loc_vec_size = sizes_b[world.rank()];
 
-  local_A.resize(loc_mat_size);
+  local_A.resize(sizes_a[world.rank()]);
   local_b.resize(loc_vec_size);
   local_x.resize(sizes_b[world.rank()]);
 
+  ppc::core::scatterv_chunked(world, A_.data(), sizes_a, displs_a, local_A.data(), 0);
   if (world.rank() == 0) {
-    boost::mpi::scatterv(world, A_.data(), sizes_a, displs_a, local_A.data(), loc_mat_size, 0);
     boost::mpi::scatterv(world, b_.data(), sizes_b, displs_b, local_b.data(), loc_vec_size, 0);
   } else {
-    boost::mpi::scatterv(world, local_A.data(), loc_mat_size, 0);
     boost::mpi::scatterv(world, local_b.data(), loc_vec_size, 0);
   }
 
-  for (size_t numberOfIter = 0; numberOfIter < maxIterations_; numberOfIter++) {
+  // resume from the last snapshot of this system
+  uint64_t problem = 0;
+  size_t firstIter = 0;
+  if (world.rank() == 0 && checkpoint) {
+    problem = ppc::core::fingerprint(b_.data(), b_.size() * sizeof(double),
+                                     ppc::core::fingerprint(A_.data(), A_.size() * sizeof(double)));
+    if (auto state = checkpoint->load(problem); state && state->x.size() == n) {
+      x_ = std::move(state->x);
+      firstIter = state->iteration;
+    }
+  }
+  boost::mpi::broadcast(world, firstIter, 0);
+
+  for (size_t numberOfIter = firstIter; numberOfIter < maxIterations_; numberOfIter++) {
     if (world.rank() == 0) {
       std::copy(x_.begin(), x_.end(), x_prev.begin());
     }
@@ -267,13 +279,20 @@ bool korablev_v_jacobi_method_mpi::JacobiMethodParallel::run() {
     }
     bool need;
     if (world.rank() == 0) {
-      need = isNeedToComplete(x_prev, x_);
+      double change = relativeChange(x_prev, x_);
+      need = change < epsilon_;
+      if (checkpoint && !need) {
+        checkpoint->try_snapshot(problem, numberOfIter + 1, change, x_);
+      }
     }
     boost::mpi::broadcast(world, need, 0);
 
     if (need) break;
   }
 
+  if (world.rank() == 0 && checkpoint) {
+    checkpoint->try_finish();
+  }
   return true;
 }
 
@@ -287,28 +306,25 @@ bool korablev_v_jacobi_method_mpi::JacobiMethodParallel::post_processing() {
   return true;
 }
 
-void korablev_v_jacobi_method_mpi::JacobiMethodParallel::calculate_distribution_a(int rows, int num_proc,
-                                                                                  std::vector<int>& sizes,
-                                                                                  std::vector<int>& displs) {
-  sizes.resize(num_proc, 0);
-  displs.resize(num_proc, -1);
+void korablev_v_jacobi_method_mpi::JacobiMethodParallel::calculate_distribution_a(uint64_t rows, int num_proc,
+                                                                                  std::vector<uint64_t>& sizes,
+                                                                                  std::vector<uint64_t>& displs) {
+  // rows * rows elements outgrow an int long before the memory runs out
+  sizes.assign(num_proc, 0);
+  displs.assign(num_proc, 0);
 
-  if (num_proc > rows) {
-    for (int i = 0; i < rows; ++i) {
+  if (static_cast<uint64_t>(num_proc) > rows) {
+    for (uint64_t i = 0; i < rows; ++i) {
       sizes[i] = rows;
       displs[i] = i * rows;
     }
   } else {
-    int a = rows / num_proc;
-    int b = rows % num_proc;
+    uint64_t a = rows / num_proc;
+    uint64_t b = rows % num_proc;
 
-    int offset = 0;
+    uint64_t offset = 0;
     for (int i = 0; i < num_proc; ++i) {
-      if (b-- > 0) {
-        sizes[i] = (a + 1) * rows;
-      } else {
-        sizes[i] = a * rows;
-      }
+      sizes[i] = (static_cast<uint64_t>(i) < b ? a + 1 : a) * rows;
       displs[i] = offset;
       offset += sizes[i];
     }
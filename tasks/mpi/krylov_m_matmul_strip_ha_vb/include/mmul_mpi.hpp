@@ -16,6 +16,7 @@
 #include <utility>
 #include <vector>
 
+#include "core/perf/include/roofline.hpp"
 #include "core/task/include/task.hpp"
 
 namespace krylov_m_matmul_strip_ha_vb_mpi {
@@ -117,6 +118,11 @@ class TaskCommon : public ppc::core::Task {
     return true;
   }
 
+  [[nodiscard]] ppc::core::TaskWork work() const override {
+    const auto& [lhs, rhs] = input;
+    return ppc::core::matmul_work(lhs.rows, lhs.cols, rhs.cols, sizeof(T));
+  }
+
  protected:
   std::pair<Matrix, Matrix> input{};
   Matrix res;
@@ -3,6 +3,7 @@
 #include <boost/mpi.hpp>
 #include <vector>
 
+#include "core/mpi/include/chunked_transfer.hpp"
 #include "core/task/include/task.hpp"
 
 namespace milovankin_m_sum_of_vector_elements_parallel {
@@ -29,7 +30,7 @@ class VectorSumPar : public ppc::core::Task {
   bool post_processing() override;
 
  private:
-  std::vector<int32_t> input_, local_input_;
+  std::vector<int32_t> local_input_;
   int64_t sum_ = 0;
   boost::mpi::communicator world;
 };
@@ -59,30 +59,24 @@ bool VectorSumPar::run() {
   internal_order_test();
 
   int my_rank = world.rank();
-  int world_size = world.size();
-  int total_size = 0;
+  uint64_t total_size = 0;
+  const int32_t* input_ptr = nullptr;
 
-  // Fill input vector from taskData
+  // 64-bit counts, split into int-sized messages by the chunked scatter
   if (my_rank == 0) {
     total_size = taskData->inputs_count[0];
-    auto* input_ptr = reinterpret_cast<int32_t*>(taskData->inputs[0]);
-    input_.assign(input_ptr, input_ptr + total_size);
+    input_ptr = reinterpret_cast<int32_t*>(taskData->inputs[0]);
   }
 
   boost::mpi::broadcast(world, total_size, 0);
 
-  // Create vectors for scatterv
-  int local_size = total_size / world_size + (my_rank < (total_size % world_size) ? 1 : 0);
-  std::vector<int> send_counts(world_size, total_size / world_size);
-  std::vector<int> offsets(world_size, 0);
-
-  // Handle the case when total_size is not divisible by world_size
-  for (int i = 0; i < total_size % world_size; ++i) send_counts[i]++;
-  for (int i = 1; i < world_size; ++i) offsets[i] = offsets[i - 1] + send_counts[i - 1];
+  std::vector<uint64_t> send_counts;
+  std::vector<uint64_t> offsets;
+  ppc::core::split_counts(total_size, world.size(), send_counts, offsets);
 
-  // Scatter data to local vectors
+  // Scatter data straight from the input to local vectors
   local_input_.resize(send_counts[my_rank]);
-  boost::mpi::scatterv(world, input_.data(), send_counts, offsets, local_input_.data(), local_size, 0);
+  ppc::core::scatterv_chunked(world, input_ptr, send_counts, offsets, local_input_.data(), 0);
 
   int64_t local_sum = std::accumulate(local_input_.begin(), local_input_.end(), int64_t(0));
   boost::mpi::reduce(world, local_sum, sum_, std::plus<>(), 0);
@@ -6,6 +6,7 @@
 #include <memory>
 #include <vector>
 
+#include "core/checkpoint/include/checkpoint.hpp"
 #include "core/task/include/task.hpp"
 
 namespace nasedkin_e_seidels_iterate_methods_mpi {
@@ -24,6 +25,10 @@ class SeidelIterateMethodsMPI : public ppc::core::Task {
   const std::vector<double>& get_solution() const { return x; }
   double check_residual_norm() const;
 
+  // snapshots of x taken on rank 0, so an interrupted run resumes where it
+  // stopped; set from PPC_CHECKPOINT_DIR by default, nullptr disables them
+  void set_checkpoint(std::shared_ptr<ppc::core::Checkpointer> checkpoint_) { checkpoint = std::move(checkpoint_); }
+
  private:
   boost::mpi::communicator world;
   std::vector<std::vector<double>> A;
@@ -32,8 +37,10 @@ class SeidelIterateMethodsMPI : public ppc::core::Task {
   int n;
   double epsilon;
   int max_iterations;
+  std::shared_ptr<ppc::core::Checkpointer> checkpoint =
+      ppc::core::Checkpointer::from_env("nasedkin_e_seidels_iterate_methods");
 
-  bool converge(const std::vector<double>& x_new);
+  double residual_norm(const std::vector<double>& x_new) const;
 };
 
 }  // namespace nasedkin_e_seidels_iterate_methods_mpi
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "mpi/oturin_a_image_smoothing/include/ops_mpi.hpp"
 
+#include "core/mpi/include/trace_mpi.hpp"
+
 bool oturin_a_image_smoothing_mpi::TestMPITaskSequential::validation() {
   internal_order_test();
   // Check elements count in i/o
@@ -111,21 +113,21 @@ bool oturin_a_image_smoothing_mpi::TestMPITaskParallel::run() {
     int noescape = 1;
 
     for (int i = 1; i <= satellites; i++)  // send width
-      world.send(i, TAG_INFO, &width, 1);
+      ppc::core::traced_send(world, i, TAG_INFO, &width, 1);
 
     int row = 0;
     while (row < height - 2) {
       for (int i = 0; i < std::min(satellites, height - 2 - row); i++) {
-        world.send(i + 1, TAG_EXIT, &noescape, 1);
-        world.send(i + 1, TAG_DATA, &input[(row + i) * width * 3], width * 3 * 3);
+        ppc::core::traced_send(world, i + 1, TAG_EXIT, &noescape, 1);
+        ppc::core::traced_send(world, i + 1, TAG_DATA, &input[(row + i) * width * 3], width * 3 * 3);
       }
       for (int i = 0; i < std::min(satellites, height - 2 - row); i++) {
-        world.recv(i + 1, TAG_RESULT, &result[(row + i + 1) * width * 3], width * 3);
+        ppc::core::traced_recv(world, i + 1, TAG_RESULT, &result[(row + i + 1) * width * 3], width * 3);
       }
       row += satellites;
     }
     for (int i = 1; i <= satellites; i++)  // close all satellite processes
-      world.send(i, TAG_EXIT, &escape, 1);
+      ppc::core::traced_send(world, i, TAG_EXIT, &escape, 1);
 
     for (int x = 0; x < width; x++) {  // calculate bottom row
       SmoothPixel(&result[x * 3], x, 0);
@@ -134,21 +136,24 @@ bool oturin_a_image_smoothing_mpi::TestMPITaskParallel::run() {
       SmoothPixel(&result[(height - 1) * width * 3 + x * 3], x, height - 1);
     }
   } else {
-    world.recv(0, TAG_INFO, &width, 1);
+    ppc::core::traced_recv(world, 0, TAG_INFO, &width, 1);
     input = std::vector<uint8_t>(width * 3 * 3);  // 3 RGB rows
     result = std::vector<uint8_t>(width * 3);     // 1 RGB row
     int escape = 0;
     height = INT_MAX;
     while (true) {
-      world.recv(0, TAG_EXIT, &escape, 1);
+      ppc::core::traced_recv(world, 0, TAG_EXIT, &escape, 1);
       if (escape == 0) break;
-      world.recv(0, TAG_DATA, input.data(), width * 3 * 3);
+      ppc::core::traced_recv(world, 0, TAG_DATA, input.data(), width * 3 * 3);
 
-      for (int x = 0; x < width; x++) {
-        SmoothPixel(&result[x * 3], x, 1);
+      {
+        ppc::core::TraceScope scope("smooth_row");
+        for (int x = 0; x < width; x++) {
+          SmoothPixel(&result[x * 3], x, 1);
+        }
       }
 
-      world.send(0, TAG_RESULT, result.data(), width * 3);
+      ppc::core::traced_send(world, 0, TAG_RESULT, result.data(), width * 3);
     }
   }
 
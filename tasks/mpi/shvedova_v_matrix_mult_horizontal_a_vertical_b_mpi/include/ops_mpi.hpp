@@ -97,6 +97,7 @@ class MatrixMultiplicationTaskSequential : public ppc::core::Task {
   bool validation() override;
   bool run() override;
   bool post_processing() override;
+  [[nodiscard]] ppc::core::TaskWork work() const override;
 
  private:
   Matrix matA;
@@ -117,6 +118,7 @@ class MatrixMultiplicationTaskParallel : public ppc::core::Task {
   bool validation() override;
   bool run() override;
   bool post_processing() override;
+  [[nodiscard]] ppc::core::TaskWork work() const override;
 
  private:
   int num_rows_a_;
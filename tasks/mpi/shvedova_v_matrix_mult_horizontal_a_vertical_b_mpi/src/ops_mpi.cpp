@@ -10,6 +10,8 @@
 #include <cstddef>
 #include <vector>
 
+#include "core/perf/include/roofline.hpp"
+
 bool shvedova_v_matrix_mult_horizontal_a_vertical_b_mpi::MatrixMultiplicationTaskSequential::pre_processing() {
   internal_order_test();
 
@@ -221,3 +223,16 @@ bool shvedova_v_matrix_mult_horizontal_a_vertical_b_mpi::MatrixMultiplicationTas
 
   return true;
 }
+
+ppc::core::TaskWork
+shvedova_v_matrix_mult_horizontal_a_vertical_b_mpi::MatrixMultiplicationTaskSequential::work() const {
+  return ppc::core::matmul_work(num_rows_a_, num_cols_a_, num_cols_b_, sizeof(int));
+}
+
+ppc::core::TaskWork shvedova_v_matrix_mult_horizontal_a_vertical_b_mpi::MatrixMultiplicationTaskParallel::work() const {
+  // the whole product over all ranks; only the root knows the sizes
+  if (world.rank() != 0) {
+    return {};
+  }
+  return ppc::core::matmul_work(num_rows_a_, num_cols_a_, num_cols_b_, sizeof(int));
+}
@@ -12,6 +12,7 @@
 #include <utility>
 #include <vector>
 
+#include "core/checkpoint/include/checkpoint.hpp"
 #include "core/task/include/task.hpp"
 
 namespace titov_s_simple_iteration_mpi {
@@ -46,6 +47,11 @@ class MPISimpleIterationParallel : public ppc::core::Task {
   bool run() override;
   bool post_processing() override;
 
+  // snapshots of the current approximation taken on rank 0, so an interrupted
+  // run resumes where it stopped; set from PPC_CHECKPOINT_DIR by default,
+  // nullptr disables them
+  void set_checkpoint(std::shared_ptr<ppc::core::Checkpointer> checkpoint_) { checkpoint = std::move(checkpoint_); }
+
  private:
   std::vector<double> Matrix;
   std::vector<double> Values;
@@ -61,6 +67,7 @@ class MPISimpleIterationParallel : public ppc::core::Task {
   std::vector<int> offset_values;
   std::vector<double> Matrix_l;
   std::vector<double> Values_l;
+  std::shared_ptr<ppc::core::Checkpointer> checkpoint = ppc::core::Checkpointer::from_env("titov_s_simple_iteration");
   boost::mpi::communicator world;
   bool isDiagonallyDominant();
   bool hasUniqueSolutionPar();
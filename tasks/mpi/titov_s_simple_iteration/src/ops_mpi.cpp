@@ -241,6 +241,19 @@ bool titov_s_simple_iteration_mpi::MPISimpleIterationParallel::run() {
     boost::mpi::scatterv(world, Values_l.data(), Values_size_l, 0);
   }
 
+  // resume from the last snapshot of this system; only root holds the
+  // approximation
+  uint64_t problem = 0;
+  uint64_t iteration = 0;
+  if (world.rank() == 0 && checkpoint) {
+    problem = ppc::core::fingerprint(Values.data(), Values.size() * sizeof(double),
+                                     ppc::core::fingerprint(Matrix.data(), Matrix.size() * sizeof(double)));
+    if (auto state = checkpoint->load(problem); state && state->x.size() == current.size()) {
+      current = std::move(state->x);
+      iteration = state->iteration;
+    }
+  }
+
   end = false;
   do {
     if (world.rank() == 0) {
@@ -281,10 +294,16 @@ bool titov_s_simple_iteration_mpi::MPISimpleIterationParallel::run() {
         }
       }
       end = (max_diff < epsilon_);
+      if (checkpoint && !end) {
+        checkpoint->try_snapshot(problem, ++iteration, max_diff, current);
+      }
     }
     boost::mpi::broadcast(world, end, 0);
   } while (!end);
 
+  if (world.rank() == 0 && checkpoint) {
+    checkpoint->try_finish();
+  }
   return true;
 }
 
@@ -1,6 +1,7 @@
 // Copyright 2023 Nesterov Alexander
 #include <gtest/gtest.h>
 
+#include <numeric>
 #include <vector>
 
 #include "omp/example/include/ops_omp.hpp"
@@ -196,6 +197,37 @@ TEST(Parallel_Operations_OpenMP, Test_Mult_2) {
   ASSERT_EQ(ref_res[0], par_res[0]);
 }
 
+TEST(Parallel_Operations_OpenMP, Test_Dispatch) {
+  ppc::core::BackendRegistry registry;
+  nesterov_a_test_task_omp::register_backends(registry, "+");
+  ppc::core::Dispatcher dispatcher(registry);
+  dispatcher.set_threshold("example", ppc::core::Backend::OMP, 50);
+  ppc::core::ExecutionContext context;
+  context.num_threads = 4;
+
+  // SEQ below the threshold, OMP from it on; both sum alike, starting from 1
+  for (int count : {10, 100}) {
+    std::vector<int> vec = nesterov_a_test_task_omp::getRandomVector(count);
+    std::vector<int> res(1, 0);
+
+    // Create TaskData
+    std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+    taskData->inputs.emplace_back(reinterpret_cast<uint8_t *>(vec.data()));
+    taskData->inputs_count.emplace_back(vec.size());
+    taskData->outputs.emplace_back(reinterpret_cast<uint8_t *>(res.data()));
+    taskData->outputs_count.emplace_back(res.size());
+
+    EXPECT_EQ(dispatcher.choose("example", vec.size(), context),
+              count < 50 ? ppc::core::Backend::SEQ : ppc::core::Backend::OMP);
+    auto task = dispatcher.create("example", taskData, context);
+    ASSERT_EQ(task->validation(), true);
+    task->pre_processing();
+    task->run();
+    task->post_processing();
+    ASSERT_EQ(res[0], std::accumulate(vec.begin(), vec.end(), 1));
+  }
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -1,15 +1,22 @@
 // Copyright 2023 Nesterov Alexander
 #pragma once
 
+#include <span>
 #include <string>
 #include <vector>
 
+#include "core/dispatch/include/dispatcher.hpp"
+#include "core/task/include/data_view.hpp"
 #include "core/task/include/task.hpp"
 
 namespace nesterov_a_test_task_omp {
 
 std::vector<int> getRandomVector(int sz);
 
+// Problem "example" with operation ops: TestOMPTaskSequential as SEQ,
+// TestOMPTaskParallel as OMP, for ppc::core::Dispatcher
+void register_backends(ppc::core::BackendRegistry& registry, const std::string& ops);
+
 class TestOMPTaskSequential : public ppc::core::Task {
  public:
   explicit TestOMPTaskSequential(std::shared_ptr<ppc::core::TaskData> taskData_, std::string ops_)
@@ -20,7 +27,7 @@ class TestOMPTaskSequential : public ppc::core::Task {
   bool post_processing() override;
 
  private:
-  std::vector<int> input_;
+  std::span<int> input_;
   int res{};
   std::string ops;
 };
@@ -35,7 +42,7 @@ class TestOMPTaskParallel : public ppc::core::Task {
   bool post_processing() override;
 
  private:
-  std::vector<int> input_;
+  std::span<int> input_;
   int res{};
   std::string ops;
 };
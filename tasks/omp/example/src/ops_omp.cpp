@@ -4,10 +4,12 @@
 #include <omp.h>
 
 #include <iostream>
+#include <memory>
 #include <numeric>
 #include <random>
 #include <string>
 #include <thread>
+#include <utility>
 #include <vector>
 
 using namespace std::chrono_literals;
@@ -22,14 +24,19 @@ std::vector<int> nesterov_a_test_task_omp::getRandomVector(int sz) {
   return vec;
 }
 
+void nesterov_a_test_task_omp::register_backends(ppc::core::BackendRegistry& registry, const std::string& ops) {
+  registry.add("example", ppc::core::Backend::SEQ, [ops](std::shared_ptr<ppc::core::TaskData> taskData) {
+    return std::make_shared<TestOMPTaskSequential>(std::move(taskData), ops);
+  });
+  registry.add("example", ppc::core::Backend::OMP, [ops](std::shared_ptr<ppc::core::TaskData> taskData) {
+    return std::make_shared<TestOMPTaskParallel>(std::move(taskData), ops);
+  });
+}
+
 bool nesterov_a_test_task_omp::TestOMPTaskSequential::pre_processing() {
   internal_order_test();
   // Init vectors
-  input_ = std::vector<int>(taskData->inputs_count[0]);
-  auto* tmp_ptr = reinterpret_cast<int*>(taskData->inputs[0]);
-  for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-    input_[i] = tmp_ptr[i];
-  }
+  input_ = ppc::core::input_view<int>(*taskData, 0);
   // Init value for output
   res = 1;
   return true;
@@ -62,11 +69,7 @@ bool nesterov_a_test_task_omp::TestOMPTaskSequential::post_processing() {
 bool nesterov_a_test_task_omp::TestOMPTaskParallel::pre_processing() {
   internal_order_test();
   // Init vectors
-  input_ = std::vector<int>(taskData->inputs_count[0]);
-  auto* tmp_ptr = reinterpret_cast<int*>(taskData->inputs[0]);
-  for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-    input_[i] = tmp_ptr[i];
-  }
+  input_ = ppc::core::input_view<int>(*taskData, 0);
   // Init value for output
   res = 1;
   return true;
@@ -3,13 +3,12 @@
 
 #include <algorithm>
 #include <cstdint>
-#include <filesystem>
-#include <fstream>
-#include <iostream>
+#include <memory>
 #include <random>
 #include <string>
 #include <vector>
 
+#include "core/io/include/mapped_file.hpp"
 #include "seq/beresnev_a_increase_contrast/include/ops_seq.hpp"
 
 static std::vector<uint8_t> getRandomVector(int sz) {
@@ -360,49 +359,20 @@ TEST(beresnev_a_increase_contrast_seq, Test_Random_1) {
 TEST(beresnev_a_increase_contrast_seq, Test_File) {
   double factor = 2.5;
 
-  std::string input_file = "tasks/seq/beresnev_a_increase_contrast/input.ppm";
-  std::string ans_file = "tasks/seq/beresnev_a_increase_contrast/ans.ppm";
+  // the pixels are used in place, only the output is a new buffer
+  ppc::core::MappedFile infile(std::string(PATH_TO_PPC_PROJECT) + "/tasks/seq/beresnev_a_increase_contrast/input.ppm");
+  ppc::core::MappedFile ansfile(std::string(PATH_TO_PPC_PROJECT) + "/tasks/seq/beresnev_a_increase_contrast/ans.ppm");
+  std::vector<uint8_t> ans_buffer(ansfile.data(), ansfile.data() + ansfile.size());
 
-  if (!std::filesystem::exists(input_file)) {
-    input_file = "../../tasks/seq/beresnev_a_increase_contrast/input.ppm";
-  }
-  std::ifstream infile(input_file, std::ios::binary);
-  ASSERT_EQ(!infile, false) << "Error: file not found in!" << std::endl;
-
-  infile.seekg(0, std::ios::end);
-  size_t file_size = static_cast<size_t>(infile.tellg());
-  infile.seekg(0, std::ios::beg);
-
-  std::vector<uint8_t> input_buffer(file_size);
-  infile.read(reinterpret_cast<char *>(input_buffer.data()), file_size);
-  ASSERT_EQ(!infile, false) << "Error reading file in!" << std::endl;
-
-  infile.close();
-
-  if (!std::filesystem::exists(ans_file)) {
-    ans_file = "../../tasks/seq/beresnev_a_increase_contrast/ans.ppm";
-  }
-  std::ifstream ansfile(ans_file, std::ios::binary);
-  ASSERT_EQ(!ansfile, false) << "Error: file not found ans!" << std::endl;
-
-  ansfile.seekg(0, std::ios::end);
-  ASSERT_EQ(file_size, static_cast<size_t>(ansfile.tellg())) << "Wrong input or answer" << std::endl;
-  ansfile.seekg(0, std::ios::beg);
-
-  std::vector<uint8_t> ans_buffer(file_size);
-  ansfile.read(reinterpret_cast<char *>(ans_buffer.data()), file_size);
-  ASSERT_EQ(!ansfile, false) << "Error reading file ans!" << std::endl;
-
-  ansfile.close();
-
-  std::vector<uint8_t> out_buffer(file_size);
+  std::vector<uint8_t> out_buffer(ansfile.size());
   std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
-  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(input_buffer.data()));
-  taskDataSeq->inputs_count.emplace_back(file_size);
+  auto image = ppc::core::add_image_input(*taskDataSeq, infile);
+  ASSERT_EQ(image.channels, 3U);
+  ASSERT_EQ(image.max_value, 255U);
   taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(&factor));
   taskDataSeq->inputs_count.emplace_back(1);
   taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t *>(&out_buffer));
-  taskDataSeq->outputs_count.emplace_back(file_size);
+  taskDataSeq->outputs_count.emplace_back(ansfile.size());
 
   beresnev_a_increase_contrast_seq::TestTaskSequential testTaskSequential(taskDataSeq);
   ASSERT_EQ(testTaskSequential.validation(), true);
@@ -415,49 +385,20 @@ TEST(beresnev_a_increase_contrast_seq, Test_File) {
 TEST(beresnev_a_increase_contrast_seq, Test_File_1) {
   double factor = 1.5;
 
-  std::string input_file = "tasks/seq/beresnev_a_increase_contrast/input1.ppm";
-  std::string ans_file = "tasks/seq/beresnev_a_increase_contrast/ans1.ppm";
+  // the pixels are used in place, only the output is a new buffer
+  ppc::core::MappedFile infile(std::string(PATH_TO_PPC_PROJECT) + "/tasks/seq/beresnev_a_increase_contrast/input1.ppm");
+  ppc::core::MappedFile ansfile(std::string(PATH_TO_PPC_PROJECT) + "/tasks/seq/beresnev_a_increase_contrast/ans1.ppm");
+  std::vector<uint8_t> ans_buffer(ansfile.data(), ansfile.data() + ansfile.size());
 
-  if (!std::filesystem::exists(input_file)) {
-    input_file = "../../tasks/seq/beresnev_a_increase_contrast/input1.ppm";
-  }
-  std::ifstream infile(input_file, std::ios::binary);
-  ASSERT_EQ(!infile, false) << "Error: file not found in!" << std::endl;
-
-  infile.seekg(0, std::ios::end);
-  size_t file_size = static_cast<size_t>(infile.tellg());
-  infile.seekg(0, std::ios::beg);
-
-  std::vector<uint8_t> input_buffer(file_size);
-  infile.read(reinterpret_cast<char *>(input_buffer.data()), file_size);
-  ASSERT_EQ(!infile, false) << "Error reading file in!" << std::endl;
-
-  infile.close();
-
-  if (!std::filesystem::exists(ans_file)) {
-    ans_file = "../../tasks/seq/beresnev_a_increase_contrast/ans1.ppm";
-  }
-  std::ifstream ansfile(ans_file, std::ios::binary);
-  ASSERT_EQ(!ansfile, false) << "Error: file not found ans!" << std::endl;
-
-  ansfile.seekg(0, std::ios::end);
-  ASSERT_EQ(file_size, static_cast<size_t>(ansfile.tellg())) << "Wrong input or answer" << std::endl;
-  ansfile.seekg(0, std::ios::beg);
-
-  std::vector<uint8_t> ans_buffer(file_size);
-  ansfile.read(reinterpret_cast<char *>(ans_buffer.data()), file_size);
-  ASSERT_EQ(!ansfile, false) << "Error reading file ans!" << std::endl;
-
-  ansfile.close();
-
-  std::vector<uint8_t> out_buffer(file_size);
+  std::vector<uint8_t> out_buffer(ansfile.size());
   std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
-  taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(input_buffer.data()));
-  taskDataSeq->inputs_count.emplace_back(file_size);
+  auto image = ppc::core::add_image_input(*taskDataSeq, infile);
+  ASSERT_EQ(image.channels, 3U);
+  ASSERT_EQ(image.max_value, 255U);
   taskDataSeq->inputs.emplace_back(reinterpret_cast<uint8_t *>(&factor));
   taskDataSeq->inputs_count.emplace_back(1);
   taskDataSeq->outputs.emplace_back(reinterpret_cast<uint8_t *>(&out_buffer));
-  taskDataSeq->outputs_count.emplace_back(file_size);
+  taskDataSeq->outputs_count.emplace_back(ansfile.size());
 
   beresnev_a_increase_contrast_seq::TestTaskSequential testTaskSequential(taskDataSeq);
   ASSERT_EQ(testTaskSequential.validation(), true);
@@ -465,4 +406,4 @@ TEST(beresnev_a_increase_contrast_seq, Test_File_1) {
   testTaskSequential.run();
   testTaskSequential.post_processing();
   ASSERT_EQ(ans_buffer, out_buffer);
-}
\ No newline at end of file
+}
@@ -1,12 +1,16 @@
 // Copyright 2023 Nesterov Alexander
 #pragma once
 
+#include <string>
 #include <vector>
 
 #include "core/task/include/task.hpp"
 
 namespace beresnev_a_increase_contrast_seq {
 
+// inputs[0] is either a whole binary PPM file or its pixels as added by
+// ppc::core::add_image_input() (shape {height, width * 3}); the output is a
+// PPM file in both cases
 class TestTaskSequential : public ppc::core::Task {
  public:
   explicit TestTaskSequential(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
@@ -16,6 +20,8 @@ class TestTaskSequential : public ppc::core::Task {
   bool post_processing() override;
 
  private:
+  [[nodiscard]] std::string header() const;
+
   size_t pixel_data_size{}, pixel_data_start{};
   size_t width{}, height{}, max_color{};
   double factor{};
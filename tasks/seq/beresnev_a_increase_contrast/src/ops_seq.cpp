@@ -5,6 +5,8 @@
 #include <string>
 #include <vector>
 
+#include "core/task/include/data_view.hpp"
+
 bool beresnev_a_increase_contrast_seq::TestTaskSequential::pre_processing() {
   internal_order_test();
   inp_.assign(taskData->inputs[0] + pixel_data_start, taskData->inputs[0] + pixel_data_start + pixel_data_size);
@@ -16,6 +18,16 @@ bool beresnev_a_increase_contrast_seq::TestTaskSequential::pre_processing() {
 
 bool beresnev_a_increase_contrast_seq::TestTaskSequential::validation() {
   internal_order_test();
+  if (const auto* desc = ppc::core::input_desc(*taskData, 0); desc != nullptr && desc->rank() == 2) {
+    // pixels only, the header has been parsed by add_image_input()
+    if (!desc->holds<uint8_t>() || desc->shape[1] % 3 != 0) return false;
+    height = desc->shape[0];
+    width = desc->shape[1] / 3;
+    max_color = 255;
+    pixel_data_start = 0;
+    pixel_data_size = width * height * 3;
+    return taskData->inputs_count[1] == 1 && taskData->outputs_count[0] == header().size() + pixel_data_size;
+  }
   auto* buffer = taskData->inputs[0];
   auto buffer_size = taskData->inputs_count[0];
   if (buffer == nullptr || buffer_size == 0) return false;
@@ -79,14 +91,17 @@ bool beresnev_a_increase_contrast_seq::TestTaskSequential::run() {
 
 bool beresnev_a_increase_contrast_seq::TestTaskSequential::post_processing() {
   internal_order_test();
+  std::string head = header();
   std::vector<uint8_t> out_;
-  out_.reserve(pixel_data_size + pixel_data_start);
-  std::string head =
-      "P6\n" + std::to_string(width) + " " + std::to_string(height) + '\n' + std::to_string(max_color) + '\n';
+  out_.reserve(head.size() + pixel_data_size);
 
   out_.insert(out_.end(), head.begin(), head.end());
   out_.insert(out_.end(), res_.data(), res_.data() + pixel_data_size);
   // std::cerr << out_.size();
   reinterpret_cast<std::vector<uint8_t>*>(taskData->outputs[0])[0] = out_;
   return true;
-}
\ No newline at end of file
+}
+
+std::string beresnev_a_increase_contrast_seq::TestTaskSequential::header() const {
+  return "P6\n" + std::to_string(width) + " " + std::to_string(height) + '\n' + std::to_string(max_color) + '\n';
+}
@@ -1,5 +1,9 @@
 #include <gtest/gtest.h>
 
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "seq/burykin_m_word_count/include/ops_seq.hpp"
 
 TEST(WordCountSequential, TestIsWordCharacter) {
@@ -99,3 +103,35 @@ TEST(WordCountSequential, WordsWithApostrophes) {
 
   ASSERT_EQ(6, out[0]);
 }
+
+TEST(WordCountSequential, StreamedWordsSplitBetweenChunks) {
+  std::string input;
+  for (int i = 0; i < 500; i++) {
+    input += "It's a beautiful day, isn't it? ";
+  }
+  std::vector<int> out(1, 0);
+
+  std::shared_ptr<ppc::core::TaskData> taskData = std::make_shared<ppc::core::TaskData>();
+  taskData->outputs.emplace_back(reinterpret_cast<uint8_t*>(out.data()));
+  taskData->outputs_count.emplace_back(out.size());
+
+  // 7-byte chunks cut most words in two
+  auto source = std::make_shared<ppc::core::MemorySource>(input.data(), input.size());
+  burykin_m_word_count::TestTaskSequential task(taskData, source, 7);
+  ASSERT_TRUE(task.validation());
+  ASSERT_TRUE(task.pre_processing());
+  ASSERT_TRUE(task.run());
+  ASSERT_TRUE(task.post_processing());
+
+  ASSERT_EQ(6 * 500, out[0]);
+}
+
+TEST(WordCountSequential, ReduceStreamOnWorkers) {
+  std::string input;
+  for (int i = 0; i < 1000; i++) {
+    input += "Feels like i'm walking on sunshine. ";
+  }
+  ppc::core::ChunkReader reader(std::make_shared<ppc::core::MemorySource>(input.data(), input.size()), 5);
+
+  ASSERT_EQ(6 * 1000, burykin_m_word_count::TestTaskSequential::count_words(reader, 4));
+}
@@ -1,27 +1,49 @@
 #pragma once
 
-#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
-#include <string>
+#include <span>
 
+#include "core/stream/include/stream.hpp"
 #include "core/task/include/task.hpp"
 
 namespace burykin_m_word_count {
 
-class TestTaskSequential : public ppc::core::Task {
+// Words in a piece of text; a word cut by either end of the piece is counted
+// here and merged with its other part by merge_runs()
+struct WordRuns {
+  int count = 0;
+  bool empty = true;
+  bool starts_in_word = false;
+  bool ends_in_word = false;
+};
+
+// Counts the words of inputs[0] or, given a source, of a text streamed in
+// chunks, so a file of any size can be counted
+class TestTaskSequential : public ppc::core::StreamingTask {
  public:
-  explicit TestTaskSequential(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+  explicit TestTaskSequential(std::shared_ptr<ppc::core::TaskData> taskData_,
+                              std::shared_ptr<ppc::core::ChunkSource> source = nullptr,
+                              std::size_t chunk_bytes = kDefaultChunkBytes)
+      : StreamingTask(std::move(taskData_), std::move(source), chunk_bytes) {}
   bool pre_processing() override;
   bool validation() override;
-  bool run() override;
   bool post_processing() override;
 
   static bool is_word_character(char c);
 
+  static WordRuns count_runs(std::span<const uint8_t> text);
+  // runs of right following those of left
+  static WordRuns merge_runs(WordRuns left, const WordRuns& right);
+  // words of a stream read with num_workers threads
+  static int count_words(ppc::core::ChunkReader& reader, std::size_t num_workers);
+
+ protected:
+  bool consume(const ppc::core::Chunk& chunk) override;
+
  private:
-  std::string input_;
-  int word_count_{};
-  static int count_words(const std::string& text);
+  WordRuns runs_;
 };
 
 }  // namespace burykin_m_word_count
@@ -1,32 +1,28 @@
 #include "seq/burykin_m_word_count/include/ops_seq.hpp"
 
+#include <cctype>
+
 namespace burykin_m_word_count {
 
 bool TestTaskSequential::pre_processing() {
   internal_order_test();
-  if (taskData->inputs[0] != nullptr && taskData->inputs_count[0] > 0) {
-    input_ = std::string(reinterpret_cast<char*>(taskData->inputs[0]), taskData->inputs_count[0]);
-  } else {
-    input_ = "";
-  }
-  word_count_ = 0;
+  runs_ = WordRuns{};
   return true;
 }
 
 bool TestTaskSequential::validation() {
   internal_order_test();
-  return (taskData->inputs_count[0] == 0 || taskData->inputs_count[0] > 0) && taskData->outputs_count[0] == 1;
+  return (is_streaming() || !taskData->inputs_count.empty()) && taskData->outputs_count[0] == 1;
 }
 
-bool TestTaskSequential::run() {
-  internal_order_test();
-  word_count_ = count_words(input_);
+bool TestTaskSequential::consume(const ppc::core::Chunk& chunk) {
+  runs_ = merge_runs(runs_, count_runs(chunk.bytes));
   return true;
 }
 
 bool TestTaskSequential::post_processing() {
   internal_order_test();
-  reinterpret_cast<int*>(taskData->outputs[0])[0] = word_count_;
+  reinterpret_cast<int*>(taskData->outputs[0])[0] = runs_.count;
   return true;
 }
 
@@ -34,33 +30,43 @@ bool TestTaskSequential::is_word_character(char c) {
   return std::isalpha(static_cast<unsigned char>(c)) != 0 || c == '\'';
 }
 
-int TestTaskSequential::count_words(const std::string& text) {
-  int count = 0;
+WordRuns TestTaskSequential::count_runs(std::span<const uint8_t> text) {
+  WordRuns runs;
+  if (text.empty()) {
+    return runs;
+  }
+  runs.empty = false;
+  runs.starts_in_word = is_word_character(static_cast<char>(text.front()));
   bool in_word = false;
-
-  for (size_t i = 0; i < text.length(); ++i) {
-    char c = text[i];
-
-    if (is_word_character(c)) {
-      if (!in_word) {
-        count++;
-        in_word = true;
-      }
-    } else {
-      in_word = false;
-    }
-
-    if (c == '\'' && i > 0 && i < text.length() - 1) {
-      if ((std::isalpha(text[i - 1]) != 0) && (std::isalpha(text[i + 1]) != 0)) {
-        in_word = true;
-      }
+  for (auto byte : text) {
+    bool word = is_word_character(static_cast<char>(byte));
+    if (word && !in_word) {
+      runs.count++;
     }
+    in_word = word;
+  }
+  runs.ends_in_word = in_word;
+  return runs;
+}
 
-    // std::cout << "Символ: " << c << ", in_word: " << in_word << ", count: " << count << std::endl;
+WordRuns TestTaskSequential::merge_runs(WordRuns left, const WordRuns& right) {
+  if (right.empty) {
+    return left;
+  }
+  if (left.empty) {
+    return right;
   }
+  // a word split between the two pieces was counted on both sides
+  left.count += right.count - (left.ends_in_word && right.starts_in_word ? 1 : 0);
+  left.ends_in_word = right.ends_in_word;
+  return left;
+}
 
-  // std::cout << "Итоговый счет слов: " << count << std::endl;
-  return count;
+int TestTaskSequential::count_words(ppc::core::ChunkReader& reader, std::size_t num_workers) {
+  return ppc::core::reduce_stream(
+             reader, num_workers, WordRuns{},
+             [](WordRuns& runs, const ppc::core::Chunk& chunk) { runs = count_runs(chunk.bytes); }, merge_runs)
+      .count;
 }
 
 }  // namespace burykin_m_word_count
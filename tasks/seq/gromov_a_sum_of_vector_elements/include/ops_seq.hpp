@@ -14,6 +14,7 @@ class SumOfVector : public ppc::core::Task {
   bool validation() override;
   bool run() override;
   bool post_processing() override;
+  [[nodiscard]] ppc::core::TaskWork work() const override;
 
  private:
   int res{};
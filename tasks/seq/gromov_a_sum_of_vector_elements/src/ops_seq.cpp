@@ -28,3 +28,9 @@ bool gromov_a_sum_of_vector_elements_seq::SumOfVector::post_processing() {
   reinterpret_cast<int*>(taskData->outputs[0])[0] = res;
   return true;
 }
+
+ppc::core::TaskWork gromov_a_sum_of_vector_elements_seq::SumOfVector::work() const {
+  // one pass over the vector, one addition per element
+  uint64_t count = taskData->inputs_count[0];
+  return {count * sizeof(int), count};
+}
@@ -16,6 +16,7 @@ class MultHorAVertBTaskSequential : public ppc::core::Task {
   bool validation() override;
   bool run() override;
   bool post_processing() override;
+  [[nodiscard]] ppc::core::TaskWork work() const override;
 
  private:
   int* input_A;
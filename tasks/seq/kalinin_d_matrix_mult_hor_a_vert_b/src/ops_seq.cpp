@@ -3,6 +3,8 @@
 #include <algorithm>
 #include <thread>
 
+#include "core/perf/include/roofline.hpp"
+
 using namespace std::chrono_literals;
 
 bool kalinin_d_matrix_mult_hor_a_vert_b_seq::MultHorAVertBTaskSequential::pre_processing() {
@@ -55,3 +57,7 @@ bool kalinin_d_matrix_mult_hor_a_vert_b_seq::MultHorAVertBTaskSequential::post_p
 
   return true;
 }
+
+ppc::core::TaskWork kalinin_d_matrix_mult_hor_a_vert_b_seq::MultHorAVertBTaskSequential::work() const {
+  return ppc::core::matmul_work(rows_A, columns_A, columns_B, sizeof(int));
+}
@@ -299,3 +299,48 @@ TEST(kavtorev_d_iterative_jacobi_seq, diagonal_not_dominant) {
   std::vector<double> mpi_X;
   kavtorev_d_iterative_jacobi_seq::run_val(2, 0.01, 100, A, F, mpi_X);
 }
+
+TEST(kavtorev_d_iterative_jacobi_seq, described_inputs) {
+  int n = 2;
+  double eps = 0.001;
+  int iterations = 100;
+  std::vector<double> A = {4.0, 1.0, 1.0, 3.0};
+  std::vector<double> F = {1.0, 2.0};
+  std::vector<double> seq_X(n, 0.0);
+
+  std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
+  ppc::core::add_input(*taskDataSeq, &n, {1});
+  ppc::core::add_input(*taskDataSeq, &eps, {1});
+  ppc::core::add_input(*taskDataSeq, &iterations, {1});
+  ppc::core::add_input(*taskDataSeq, A.data(), {2, 2});
+  ppc::core::add_input(*taskDataSeq, F.data(), {2});
+  ppc::core::add_output(*taskDataSeq, seq_X.data(), {2});
+
+  auto taskSequential = std::make_shared<kavtorev_d_iterative_jacobi_seq::IterativeJacobiSequential>(taskDataSeq);
+  ASSERT_TRUE(taskSequential->validation());
+  taskSequential->pre_processing();
+  taskSequential->run();
+  taskSequential->post_processing();
+  EXPECT_NEAR(seq_X[0], 1.0 / 11.0, 0.01);
+  EXPECT_NEAR(seq_X[1], 7.0 / 11.0, 0.01);
+}
+
+TEST(kavtorev_d_iterative_jacobi_seq, wrong_described_matrix_type) {
+  int n = 2;
+  double eps = 0.001;
+  int iterations = 100;
+  std::vector<float> A = {4.0F, 1.0F, 1.0F, 3.0F};
+  std::vector<double> F = {1.0, 2.0};
+  std::vector<double> seq_X(n, 0.0);
+
+  std::shared_ptr<ppc::core::TaskData> taskDataSeq = std::make_shared<ppc::core::TaskData>();
+  ppc::core::add_input(*taskDataSeq, &n, {1});
+  ppc::core::add_input(*taskDataSeq, &eps, {1});
+  ppc::core::add_input(*taskDataSeq, &iterations, {1});
+  ppc::core::add_input(*taskDataSeq, A.data(), {2, 2});
+  ppc::core::add_input(*taskDataSeq, F.data(), {2});
+  ppc::core::add_output(*taskDataSeq, seq_X.data(), {2});
+
+  auto taskSequential = std::make_shared<kavtorev_d_iterative_jacobi_seq::IterativeJacobiSequential>(taskDataSeq);
+  EXPECT_FALSE(taskSequential->validation());
+}
@@ -7,12 +7,13 @@
 #include <utility>
 #include <vector>
 
+#include "core/task/include/data_view.hpp"
 #include "core/task/include/task.hpp"
 
 namespace kavtorev_d_iterative_jacobi_seq {
 
 bool jacobi_method(int N, const std::vector<double>& A_flat, const std::vector<double>& F, std::vector<double>& X,
-                   double eps, int iterations);
+                   std::vector<double>& TempX, double eps, int iterations);
 
 class IterativeJacobiSequential : public ppc::core::Task {
  public:
@@ -26,6 +27,7 @@ class IterativeJacobiSequential : public ppc::core::Task {
   std::vector<double> A_flat;
   std::vector<double> F;
   std::vector<double> result_vector;
+  std::vector<double> temp_x;
   int n;
   double eps;
   int iterations;
@@ -6,9 +6,9 @@
 #include <thread>
 
 bool kavtorev_d_iterative_jacobi_seq::jacobi_method(int N, const std::vector<double>& A_flat,
-                                                    const std::vector<double>& F, std::vector<double>& X, double eps,
-                                                    int iterations) {
-  std::vector<double> TempX(N);
+                                                    const std::vector<double>& F, std::vector<double>& X,
+                                                    std::vector<double>& TempX, double eps, int iterations) {
+  TempX.resize(N);
   double norm;
 
   int iteration = 0;
@@ -43,8 +43,9 @@ bool kavtorev_d_iterative_jacobi_seq::IterativeJacobiSequential::validation() {
     return false;
   }
 
-  if ((taskData->inputs[0] == nullptr) || (taskData->inputs[1] == nullptr) || (taskData->inputs[2] == nullptr) ||
-      (taskData->inputs[3] == nullptr) || (taskData->inputs[4] == nullptr)) {
+  if (!ppc::core::has_input<int>(*taskData, 0) || !ppc::core::has_input<double>(*taskData, 1) ||
+      !ppc::core::has_input<int>(*taskData, 2) || !ppc::core::has_input<double>(*taskData, 3) ||
+      !ppc::core::has_input<double>(*taskData, 4)) {
     return false;
   }
 
@@ -95,8 +96,8 @@ bool kavtorev_d_iterative_jacobi_seq::IterativeJacobiSequential::validation() {
     return false;
   }
 
-  std::vector<double> val_A_flat(val_A_data, val_A_data + val_A_size);
-  std::vector<double> val_F(val_F_data, val_F_data + val_F_size);
+  auto val_A_flat = ppc::core::input_view<double>(*taskData, 3);
+  auto val_F = ppc::core::input_view<double>(*taskData, 4);
 
   for (size_t i = 0; i < val_A_flat.size(); ++i) {
     if (std::isnan(val_A_flat[i]) || std::isinf(val_A_flat[i])) {
@@ -147,7 +148,9 @@ bool kavtorev_d_iterative_jacobi_seq::IterativeJacobiSequential::pre_processing(
   try {
     A_flat.assign(A_data, A_data + A_size);
     F.assign(F_data, F_data + F_size);
-    result_vector.resize(n);
+    // assign()/resize() reuse the capacity when the task is run again
+    result_vector.assign(n, 0.0);
+    temp_x.resize(n);
   } catch (const std::exception& e) {
     std::cerr << "Error during global data assignment: " << e.what() << std::endl;
     return false;
@@ -159,7 +162,7 @@ bool kavtorev_d_iterative_jacobi_seq::IterativeJacobiSequential::pre_processing(
 bool kavtorev_d_iterative_jacobi_seq::IterativeJacobiSequential::run() {
   internal_order_test();
 
-  return kavtorev_d_iterative_jacobi_seq::jacobi_method(n, A_flat, F, result_vector, eps, iterations);
+  return kavtorev_d_iterative_jacobi_seq::jacobi_method(n, A_flat, F, result_vector, temp_x, eps, iterations);
 }
 
 bool kavtorev_d_iterative_jacobi_seq::IterativeJacobiSequential::post_processing() {
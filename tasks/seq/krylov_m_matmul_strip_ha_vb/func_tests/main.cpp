@@ -25,20 +25,35 @@ TEST_P(krylov_m_matmul_strip_ha_vb_seq_test, yields_correct_result) {
   ASSERT_TRUE(lhs.check_integrity());
   ASSERT_TRUE(rhs.check_integrity());
 
-  //
+  // strips of every height, including ones not dividing the rows
+  for (size_t block_rows : {1, 2, 5}) {
+    krylov_m_matmul_strip_ha_vb_seq::TaskSequential<TestElementType>::Matrix out;
+
+    //
+    auto taskData = std::make_shared<ppc::core::TaskData>();
+    krylov_m_matmul_strip_ha_vb_seq::fill_task_data(*taskData, lhs, rhs, out);
+
+    //
+    krylov_m_matmul_strip_ha_vb_seq::TaskSequential<TestElementType> task(taskData, block_rows);
+    ASSERT_TRUE(task.validation());
+    task.pre_processing();
+    task.run();
+    task.post_processing();
+    EXPECT_EQ(out, ref);
+  }
+}
+
+TEST_F(krylov_m_matmul_strip_ha_vb_seq_test, empty_strip_fail_validation) {
   krylov_m_matmul_strip_ha_vb_seq::TaskSequential<TestElementType>::Matrix out;
 
-  //
+  krylov_m_matmul_strip_ha_vb_seq::TMatrix<TestElementType> lhs{2, 3};
+  krylov_m_matmul_strip_ha_vb_seq::TMatrix<TestElementType> rhs{3, 2};
+
   auto taskData = std::make_shared<ppc::core::TaskData>();
   krylov_m_matmul_strip_ha_vb_seq::fill_task_data(*taskData, lhs, rhs, out);
 
-  //
-  krylov_m_matmul_strip_ha_vb_seq::TaskSequential<TestElementType> task(taskData);
-  ASSERT_TRUE(task.validation());
-  task.pre_processing();
-  task.run();
-  task.post_processing();
-  EXPECT_EQ(out, ref);
+  krylov_m_matmul_strip_ha_vb_seq::TaskSequential<TestElementType> task(taskData, 0);
+  EXPECT_FALSE(task.validation());
 }
 
 TEST_F(krylov_m_matmul_strip_ha_vb_seq_test, bad_task_fail_validation) {
@@ -6,6 +6,7 @@
 #include <utility>
 #include <vector>
 
+#include "core/perf/include/roofline.hpp"
 #include "core/task/include/task.hpp"
 
 namespace krylov_m_matmul_strip_ha_vb_seq {
@@ -45,12 +46,15 @@ class TaskSequential : public ppc::core::Task {
  public:
   using Matrix = TMatrix<T>;
 
-  explicit TaskSequential(std::shared_ptr<ppc::core::TaskData> taskData_) : Task(std::move(taskData_)) {}
+  // block_rows: height of the strips of lhs run() walks, see run()
+  explicit TaskSequential(std::shared_ptr<ppc::core::TaskData> taskData_, size_t block_rows = 1)
+      : Task(std::move(taskData_)), block_rows_(block_rows) {}
 
   bool validation() override {
     internal_order_test();
 
-    return taskData->inputs_count.size() == 4 && taskData->outputs.size() == 3 && taskData->outputs_count.size() == 3 &&
+    return block_rows_ > 0 &&
+           taskData->inputs_count.size() == 4 && taskData->outputs.size() == 3 && taskData->outputs_count.size() == 3 &&
            // (lhs.cols == rhs.rows)
            (taskData->inputs_count[1] == taskData->inputs_count[2]) &&
            // lhs.rows > 0 && lhs.cols > 0 && rhs.rows > 0 [&& rhs.cols > 0] - true by definition
@@ -81,11 +85,21 @@ class TaskSequential : public ppc::core::Task {
 
     const auto& [lhs, rhs] = input_;
 
-    for (size_t i = 0; i < lhs.rows; i++) {
-      for (size_t j = 0; j < rhs.cols; j++) {
-        res_.at(i, j) = 0;
-        for (size_t k = 0; k < rhs.rows; k++) {
-          res_.at(i, j) += lhs.at(i, k) * rhs.at(k, j);
+    // a row of rhs is streamed once per strip of block_rows_ rows of lhs and
+    // reused by all of them while it is in cache
+    for (size_t strip = 0; strip < lhs.rows; strip += block_rows_) {
+      const size_t strip_end = std::min(strip + block_rows_, lhs.rows);
+      for (size_t i = strip; i < strip_end; i++) {
+        for (size_t j = 0; j < rhs.cols; j++) {
+          res_.at(i, j) = 0;
+        }
+      }
+      for (size_t k = 0; k < rhs.rows; k++) {
+        for (size_t i = strip; i < strip_end; i++) {
+          const T lhs_ik = lhs.at(i, k);
+          for (size_t j = 0; j < rhs.cols; j++) {
+            res_.at(i, j) += lhs_ik * rhs.at(k, j);
+          }
         }
       }
     }
@@ -103,9 +117,15 @@ class TaskSequential : public ppc::core::Task {
     return true;
   }
 
+  [[nodiscard]] ppc::core::TaskWork work() const override {
+    const auto& [lhs, rhs] = input_;
+    return ppc::core::matmul_work(lhs.rows, lhs.cols, rhs.cols, sizeof(T));
+  }
+
  private:
   std::pair<Matrix, Matrix> input_{};
   Matrix res_;
+  size_t block_rows_;
 };
 
 template <class T>
@@ -1,9 +1,13 @@
 #include <gtest/gtest.h>
 
+#include <cstdlib>
+#include <filesystem>
 #include <memory>
 #include <random>
+#include <string>
 
 #include "../include/mmul_seq.hpp"
+#include "core/perf/include/autotune.hpp"
 #include "core/perf/include/perf.hpp"
 
 class krylov_m_matmul_strip_ha_vb_seq_test : public ::testing::Test {
@@ -36,18 +40,44 @@ class krylov_m_matmul_strip_ha_vb_seq_test : public ::testing::Test {
     krylov_m_matmul_strip_ha_vb_seq::fill_task_data(*taskData, lhs, rhs, out);
 
     //
-    auto task = std::make_shared<krylov_m_matmul_strip_ha_vb_seq::TaskSequential<TestElementType>>(taskData);
-
-    //
-    auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
-    perfAttr->num_running = 10;
     const auto t0 = std::chrono::high_resolution_clock::now();
-    perfAttr->current_timer = [&] {
+    auto timer = [&] {
       auto current_time_point = std::chrono::high_resolution_clock::now();
       auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(current_time_point - t0).count();
       return static_cast<double>(duration) * 1e-9;
     };
 
+    // the strip height is tuned on every run into a temporary cache, so no
+    // file is left behind and no stale one decides; PPC_TUNING_CACHE keeps it
+    const char *cache_path = std::getenv("PPC_TUNING_CACHE");
+    const bool keep_cache = cache_path != nullptr && *cache_path != '\0';
+    auto temp_cache = std::filesystem::temp_directory_path() / "krylov_m_matmul_strip_ha_vb_seq_tuning.txt";
+    std::filesystem::remove(temp_cache);
+    auto tuneAttr = std::make_shared<ppc::core::PerfAttr>();
+    tuneAttr->num_running = 3;
+    tuneAttr->current_timer = timer;
+    ppc::core::AutoTuner tuner(
+        "krylov_m_matmul_strip_ha_vb_seq/" + std::to_string(lrows) + "x" + std::to_string(lcols) + "x" +
+            std::to_string(rcols),
+        {{"block_rows", {1, 4, 16, 64}}},
+        keep_cache ? ppc::core::TuningCache::from_env() : ppc::core::TuningCache(temp_cache.string()));
+    auto config = tuner.get(
+        [&](const ppc::core::TuneConfig &config) {
+          return std::make_shared<krylov_m_matmul_strip_ha_vb_seq::TaskSequential<TestElementType>>(
+              taskData, config.at("block_rows"));
+        },
+        tuneAttr);
+    std::filesystem::remove(temp_cache);
+
+    //
+    auto task = std::make_shared<krylov_m_matmul_strip_ha_vb_seq::TaskSequential<TestElementType>>(
+        taskData, config.at("block_rows"));
+
+    //
+    auto perfAttr = std::make_shared<ppc::core::PerfAttr>();
+    perfAttr->num_running = 10;
+    perfAttr->current_timer = timer;
+
     //
     auto perfResults = std::make_shared<ppc::core::PerfResults>();
     ppc::core::Perf perfAnalyzer(task);
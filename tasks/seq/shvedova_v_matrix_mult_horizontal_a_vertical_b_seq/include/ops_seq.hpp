@@ -15,6 +15,7 @@ class MatrixMultiplicationTaskSequential : public ppc::core::Task {
   bool validation() override;
   bool run() override;
   bool post_processing() override;
+  [[nodiscard]] ppc::core::TaskWork work() const override;
 
  private:
   std::vector<int> matrix_a;
@@ -2,6 +2,8 @@
 
 #include <vector>
 
+#include "core/perf/include/roofline.hpp"
+
 bool shvedova_v_matrix_mult_horizontal_a_vertical_b_seq::MatrixMultiplicationTaskSequential::pre_processing() {
   internal_order_test();
 
@@ -69,4 +71,9 @@ bool shvedova_v_matrix_mult_horizontal_a_vertical_b_seq::MatrixMultiplicationTas
   }
 
   return true;
-}
\ No newline at end of file
+}
+
+ppc::core::TaskWork
+shvedova_v_matrix_mult_horizontal_a_vertical_b_seq::MatrixMultiplicationTaskSequential::work() const {
+  return ppc::core::matmul_work(row_a, col_a, col_b, sizeof(int));
+}
@@ -2,9 +2,12 @@
 #ifndef TASKS_EXAMPLES_TEST_STD_OPS_STD_H_
 #define TASKS_EXAMPLES_TEST_STD_OPS_STD_H_
 
+#include <memory>
+#include <span>
 #include <string>
 #include <vector>
 
+#include "core/task/include/data_view.hpp"
 #include "core/task/include/task.hpp"
 
 namespace nesterov_a_test_task_stl {
@@ -21,7 +24,7 @@ class TestSTLTaskSequential : public ppc::core::Task {
   bool post_processing() override;
 
  private:
-  std::vector<int> input_;
+  std::span<int> input_;
   int res{};
   std::string ops;
 };
@@ -36,7 +39,9 @@ class TestSTLTaskParallel : public ppc::core::Task {
   bool post_processing() override;
 
  private:
-  std::vector<int> input_;
+  // copy of the input whose slices are first touched by the workers reading them
+  std::unique_ptr<int[]> local_buffer_;
+  std::span<int> input_;
   int res{};
   std::string ops;
 };
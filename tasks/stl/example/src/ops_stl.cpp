@@ -1,15 +1,21 @@
 // Copyright 2023 Nesterov Alexander
 #include "stl/example/include/ops_stl.hpp"
 
+#include <algorithm>
+#include <cstddef>
 #include <future>
 #include <iostream>
 #include <numeric>
 #include <random>
+#include <span>
 #include <string>
 #include <thread>
 #include <utility>
 #include <vector>
 
+#include "core/perf/include/scaling.hpp"
+#include "core/placement/include/placement.hpp"
+
 using namespace std::chrono_literals;
 
 std::vector<int> nesterov_a_test_task_stl::getRandomVector(int sz) {
@@ -25,11 +31,7 @@ std::vector<int> nesterov_a_test_task_stl::getRandomVector(int sz) {
 bool nesterov_a_test_task_stl::TestSTLTaskSequential::pre_processing() {
   internal_order_test();
   // Init vectors
-  input_ = std::vector<int>(taskData->inputs_count[0]);
-  auto *tmp_ptr = reinterpret_cast<int *>(taskData->inputs[0]);
-  for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-    input_[i] = tmp_ptr[i];
-  }
+  input_ = ppc::core::input_view<int>(*taskData, 0);
   // Init value for output
   res = 0;
   return true;
@@ -59,7 +61,7 @@ bool nesterov_a_test_task_stl::TestSTLTaskSequential::post_processing() {
 
 std::mutex my_mutex;
 
-void atomOps(std::vector<int> vec, const std::string &ops, std::promise<int> &&pr) {
+void atomOps(std::span<const int> vec, const std::string &ops, std::promise<int> &&pr) {
   auto sz = vec.size();
   int reduction_elem = 0;
   if (ops == "+") {
@@ -79,11 +81,11 @@ void atomOps(std::vector<int> vec, const std::string &ops, std::promise<int> &&p
 bool nesterov_a_test_task_stl::TestSTLTaskParallel::pre_processing() {
   internal_order_test();
   // Init vectors
-  input_ = std::vector<int>(taskData->inputs_count[0]);
-  auto *tmp_ptr = reinterpret_cast<int *>(taskData->inputs[0]);
-  for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-    input_[i] = tmp_ptr[i];
-  }
+  auto input = ppc::core::input_view<int>(*taskData, 0);
+  const auto nthreads = static_cast<std::size_t>(ppc::core::get_num_threads());
+  local_buffer_ = ppc::core::make_first_touched<int>(input.size(), ppc::core::pinned_worker_cpus(nthreads));
+  std::copy(input.begin(), input.end(), local_buffer_.get());
+  input_ = std::span<int>(local_buffer_.get(), input.size());
   // Init value for output
   res = 0;
   return true;
@@ -97,7 +99,7 @@ bool nesterov_a_test_task_stl::TestSTLTaskParallel::validation() {
 
 bool nesterov_a_test_task_stl::TestSTLTaskParallel::run() {
   internal_order_test();
-  const auto nthreads = std::thread::hardware_concurrency();
+  const auto nthreads = static_cast<unsigned>(ppc::core::get_num_threads());
   const auto delta = (input_.end() - input_.begin()) / nthreads;
 
   auto *promises = new std::promise<int>[nthreads];
@@ -106,8 +108,13 @@ bool nesterov_a_test_task_stl::TestSTLTaskParallel::run() {
 
   for (unsigned i = 0; i < nthreads; i++) {
     futures[i] = promises[i].get_future();
-    std::vector<int> tmp_vec(input_.begin() + i * delta, input_.begin() + (i + 1) * delta);
-    threads[i] = std::thread(atomOps, tmp_vec, ops, std::move(promises[i]));
+    std::span<const int> tmp_vec = input_.subspan(i * delta, delta);
+    threads[i] = std::thread(
+        [i, nthreads](std::span<const int> vec, const std::string &op, std::promise<int> &&pr) {
+          ppc::core::pin_worker(i, nthreads);
+          atomOps(vec, op, std::move(pr));
+        },
+        tmp_vec, ops, std::move(promises[i]));
     threads[i].join();
     res += futures[i].get();
   }
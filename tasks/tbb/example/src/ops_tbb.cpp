@@ -25,11 +25,7 @@ std::vector<int> nesterov_a_test_task_tbb::getRandomVector(int sz) {
 bool nesterov_a_test_task_tbb::TestTBBTaskSequential::pre_processing() {
   internal_order_test();
   // Init vectors
-  input_ = std::vector<int>(taskData->inputs_count[0]);
-  auto* tmp_ptr = reinterpret_cast<int*>(taskData->inputs[0]);
-  for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-    input_[i] = tmp_ptr[i];
-  }
+  input_ = ppc::core::input_view<int>(*taskData, 0);
   // Init value for output
   res = 1;
   return true;
@@ -62,11 +58,7 @@ bool nesterov_a_test_task_tbb::TestTBBTaskSequential::post_processing() {
 bool nesterov_a_test_task_tbb::TestTBBTaskParallel::pre_processing() {
   internal_order_test();
   // Init vectors
-  input_ = std::vector<int>(taskData->inputs_count[0]);
-  auto* tmp_ptr = reinterpret_cast<int*>(taskData->inputs[0]);
-  for (unsigned i = 0; i < taskData->inputs_count[0]; i++) {
-    input_[i] = tmp_ptr[i];
-  }
+  input_ = ppc::core::input_view<int>(*taskData, 0);
   // Init value for output
   res = 1;
   return true;
@@ -82,24 +74,24 @@ bool nesterov_a_test_task_tbb::TestTBBTaskParallel::run() {
   internal_order_test();
   if (ops == "+") {
     res += oneapi::tbb::parallel_reduce(
-        oneapi::tbb::blocked_range<std::vector<int>::iterator>(input_.begin(), input_.end()), 0,
-        [](tbb::blocked_range<std::vector<int>::iterator> r, int running_total) {
+        oneapi::tbb::blocked_range<std::span<int>::iterator>(input_.begin(), input_.end()), 0,
+        [](tbb::blocked_range<std::span<int>::iterator> r, int running_total) {
           running_total += std::accumulate(r.begin(), r.end(), 0);
           return running_total;
         },
         std::plus<>());
   } else if (ops == "-") {
     res -= oneapi::tbb::parallel_reduce(
-        oneapi::tbb::blocked_range<std::vector<int>::iterator>(input_.begin(), input_.end()), 0,
-        [](tbb::blocked_range<std::vector<int>::iterator> r, int running_total) {
+        oneapi::tbb::blocked_range<std::span<int>::iterator>(input_.begin(), input_.end()), 0,
+        [](tbb::blocked_range<std::span<int>::iterator> r, int running_total) {
           running_total += std::accumulate(r.begin(), r.end(), 0);
           return running_total;
         },
         std::plus<>());
   } else if (ops == "*") {
     res *= oneapi::tbb::parallel_reduce(
-        oneapi::tbb::blocked_range<std::vector<int>::iterator>(input_.begin(), input_.end()), 1,
-        [](tbb::blocked_range<std::vector<int>::iterator> r, int running_total) {
+        oneapi::tbb::blocked_range<std::span<int>::iterator>(input_.begin(), input_.end()), 1,
+        [](tbb::blocked_range<std::span<int>::iterator> r, int running_total) {
           running_total *= std::accumulate(r.begin(), r.end(), 1, std::multiplies<>());
           return running_total;
         },